@@ -1,141 +1,285 @@
 #include "AllocationEngine.h"
+#include "MinCostFlow.h"
 #include <iostream>
 using namespace std;
 
-AllocationEngine::AllocationEngine(int maxZones) 
-    : maxZones(maxZones), zoneCount(0) {
-    zones = new Zone*[maxZones];
-    for (int i = 0; i < maxZones; i++) {
-        zones[i] = nullptr;
+AllocationEngine::AllocationEngine(ZoneRegistry* registry)
+    : registry(registry), zoneGraph(registry), policy(AllocationPolicy::FIRST_FIT), policyFixed(false) {}
+
+AllocationEngine::~AllocationEngine() {
+    // Note: We don't delete zones here as the registry owns them
+}
+
+Zone* AllocationEngine::findZone(const string& zoneId) {
+    return registry->findZone(zoneId);
+}
+
+bool AllocationEngine::addZoneAdjacency(const string& zoneA, const string& zoneB, int distance) {
+    return zoneGraph.addEdge(zoneA, zoneB, distance);
+}
+
+void AllocationEngine::refreshZoneGraph() {
+    zoneGraph.refresh();
+}
+
+ZoneGraph* AllocationEngine::getZoneGraph() {
+    return &zoneGraph;
+}
+
+bool AllocationEngine::registerSlot(ParkingSlot* slot) {
+    if (slot == nullptr) {
+        return false;
     }
+    return slotIndex.insert(slot->getSlotId(), slot);
 }
 
-AllocationEngine::~AllocationEngine() {
-    for (int i = 0; i < zoneCount; i++) {
-        // Note: We don't delete zones here as they're managed elsewhere
-        zones[i] = nullptr;
+ParkingSlot* AllocationEngine::findSlot(const string& slotId) const {
+    ParkingSlot* const* slot = slotIndex.find(slotId);
+    return (slot != nullptr) ? *slot : nullptr;
+}
+
+ParkingSlot* AllocationEngine::claimSlot(ParkingRequest* request) {
+    switch (policy.load(memory_order_relaxed)) {
+        case AllocationPolicy::BEST_FIT_AREA:
+            return claimSlotWith<BestFitAreaPolicy>(request);
+        case AllocationPolicy::LEAST_LOADED_ZONE:
+            return claimSlotWith<LeastLoadedZonePolicy>(request);
+        case AllocationPolicy::ROUND_ROBIN_AREA:
+            return claimSlotWith<RoundRobinAreaPolicy>(request);
+        default:
+            return claimSlotWith<FirstFitPolicy>(request);
     }
-    delete[] zones;
 }
 
-bool AllocationEngine::addZone(Zone* zone) {
-    if (zoneCount >= maxZones) {
-        cout << "Error: Cannot add more zones to engine." << endl;
+bool AllocationEngine::setPolicy(AllocationPolicy newPolicy) {
+    if (policyFixed && newPolicy != policy.load(memory_order_relaxed)) {
+        cout << "Error: This engine's allocation policy is fixed." << endl;
         return false;
     }
-    
-    // Check if zone already exists
-    for (int i = 0; i < zoneCount; i++) {
-        if (zones[i]->getZoneId() == zone->getZoneId()) {
-            cout << "Error: Zone " << zone->getZoneId() << " already exists in engine." << endl;
-            return false;
-        }
-    }
-    
-    zones[zoneCount] = zone;
-    zoneCount++;
+    policy.store(newPolicy, memory_order_relaxed);
     return true;
 }
 
-Zone* AllocationEngine::findZone(const string& zoneId) {
-    for (int i = 0; i < zoneCount; i++) {
-        if (zones[i]->getZoneId() == zoneId) {
-            return zones[i];
+void AllocationEngine::fixPolicy(AllocationPolicy fixed) {
+    policy.store(fixed, memory_order_relaxed);
+    policyFixed = true;
+}
+
+AllocationPolicy AllocationEngine::getPolicy() const {
+    return policy.load(memory_order_relaxed);
+}
+
+int AllocationEngine::groupByZone(ParkingRequest** requests, int count, ZoneGroup* groups, int* nextInGroup) {
+    // One zone lookup per distinct zone and class; requests keep arrival
+    // order in a group
+    HashIndex<int> groupOf(count * 2);
+    int groupCount = 0;
+    
+    for (int i = 0; i < count; i++) {
+        nextInGroup[i] = -1;
+        
+        string zoneId = requests[i]->getRequestedZoneId();
+        SlotClass slotClass = requests[i]->getSlotClass();
+        string key = zoneId;
+        key += char('0' + (int)slotClass);
+        int* group = groupOf.find(key);
+        if (group != nullptr) {
+            nextInGroup[groups[*group].tail] = i;
+            groups[*group].tail = i;
+            groups[*group].size++;
+            continue;
+        }
+        
+        int zoneIndex = registry->indexOf(zoneId);
+        if (zoneIndex == -1) {
+            continue; // claimSlot reports the unknown zone
         }
+        groupOf.insert(key, groupCount);
+        groups[groupCount].zoneIndex = zoneIndex;
+        groups[groupCount].slotClass = slotClass;
+        groups[groupCount].head = i;
+        groups[groupCount].tail = i;
+        groups[groupCount].size = 1;
+        groupCount++;
     }
-    return nullptr;
+    return groupCount;
 }
 
-ParkingSlot* AllocationEngine::allocateSlot(ParkingRequest* request) {
-    if (request == nullptr) {
-        cout << "Error: Cannot allocate slot for null request." << endl;
-        return nullptr;
+int AllocationEngine::claimSlotsByZone(ParkingRequest** requests, int count, ParkingSlot** slots) {
+    ZoneGroup* groups = new ZoneGroup[count];
+    int* nextInGroup = new int[count];
+    int groupCount = groupByZone(requests, count, groups, nextInGroup);
+    for (int i = 0; i < count; i++) {
+        slots[i] = nullptr;
     }
     
-    string requestedZoneId = request->getRequestedZoneId();
-    Zone* requestedZone = findZone(requestedZoneId);
-    
-    if (requestedZone == nullptr) {
-        cout << "Error: Requested zone " << requestedZoneId << " not found." << endl;
-        return nullptr;
-    }
-    
-    // Try to allocate in requested zone first
-    ParkingSlot* slot = requestedZone->findAvailableSlotInZone();
-    
-    if (slot != nullptr) {
-        // Allocation successful in requested zone
-        return slot;
+    // One scan of each zone's free bits serves its whole group
+    ParkingSlot** taken = new ParkingSlot*[count];
+    int claimed = 0;
+    for (int g = 0; g < groupCount; g++) {
+        Zone* zone = registry->getZoneAt(groups[g].zoneIndex);
+        int got = zone->claimAvailableSlotsInZone(taken, groups[g].size, groups[g].slotClass);
+        
+        int request = groups[g].head;
+        for (int k = 0; k < got; k++) {
+            slots[request] = taken[k];
+            request = nextInGroup[request];
+        }
+        claimed += got;
     }
     
-    // If requested zone is full, try cross-zone allocation
-    cout << "Zone " << requestedZoneId << " is full. Attempting cross-zone allocation..." << endl;
-    return allocateCrossZone(request);
+    delete[] taken;
+    delete[] nextInGroup;
+    delete[] groups;
+    return claimed;
 }
 
-ParkingSlot* AllocationEngine::allocateCrossZone(ParkingRequest* request) {
-    Zone* currentZone = findZone(request->getRequestedZoneId());
-    if (currentZone == nullptr) {
-        return nullptr;
-    }
+int AllocationEngine::claimSlotsMinCost(ParkingRequest** requests, int count, ParkingSlot** slots,
+                                        long long budgetNanos, bool& budgetExceeded) {
+    budgetExceeded = false;
     
-    // Find next available zone
-    Zone* nextZone = getNextAvailableZone(request->getRequestedZoneId());
+    // A zone's free slots can only go in-zone to its own group, so the
+    // grouped pass already places as many requests in-zone as possible.
+    // What is left to optimize is where the overflow goes.
+    int claimed = claimSlotsByZone(requests, count, slots);
     
-    if (nextZone != nullptr) {
-        ParkingSlot* slot = nextZone->findAvailableSlotInZone();
-        if (slot != nullptr) {
-            cout << "Cross-zone allocation successful! Allocated in zone " 
-                 << nextZone->getZoneId() << endl;
-            return slot;
+    int* overflowIndex = new int[count];
+    ParkingRequest** overflow = new ParkingRequest*[count];
+    int overflowCount = 0;
+    for (int i = 0; i < count; i++) {
+        if (slots[i] == nullptr) {
+            overflowIndex[overflowCount] = i;
+            overflow[overflowCount++] = requests[i];
         }
     }
+    if (overflowCount == 0 || registry->getAvailableSlots() == 0) {
+        delete[] overflow;
+        delete[] overflowIndex;
+        return claimed;
+    }
     
-    cout << "Error: No available slots in any zone." << endl;
-    return nullptr;
-}
-
-Zone* AllocationEngine::getNextAvailableZone(const string& currentZoneId) {
-    // Simple round-robin search for next available zone
-    int currentIndex = -1;
+    ZoneGroup* groups = new ZoneGroup[overflowCount];
+    int* nextInGroup = new int[overflowCount];
+    int groupCount = groupByZone(overflow, overflowCount, groups, nextInGroup);
+    
+    // Transportation network: source -> group (its size) -> candidate
+    // (zone, slot class) (fallback distance) -> sink (free slots of that
+    // class in that zone). A group links to every class it fits in each of
+    // its candidate zones, and zone-class nodes are shared between the
+    // groups that list them, so no two groups are promised the same slot.
+    // Within a distance, a tighter class costs less, as with single claims.
+    const int edgesPerGroup = MAX_FALLBACK_CANDIDATES * SLOT_CLASS_COUNT;
+    int maxNodes = 2 + groupCount * (1 + edgesPerGroup);
+    MinCostFlow flow(maxNodes, groupCount * (1 + 2 * edgesPerGroup));
+    const int source = 0;
+    const int sink = 1;
+    int nodeCount = 2 + groupCount;
+    HashIndex<int> zoneNode(groupCount * 4); // First of the zone's SLOT_CLASS_COUNT nodes
     
-    // Find current zone index
-    for (int i = 0; i < zoneCount; i++) {
-        if (zones[i]->getZoneId() == currentZoneId) {
-            currentIndex = i;
-            break;
+    int* candidateZone = new int[groupCount * edgesPerGroup];
+    SlotClass* candidateClass = new SlotClass[groupCount * edgesPerGroup];
+    int* candidateEdge = new int[groupCount * edgesPerGroup];
+    int* candidateCount = new int[groupCount];
+    
+    for (int g = 0; g < groupCount; g++) {
+        flow.addEdge(source, 2 + g, groups[g].size, 0);
+        candidateCount[g] = 0;
+        
+        // Enough zones to hold the group, and a few more to trade with others
+        int zonesListed = 0;
+        int reachable = 0;
+        FallbackCursor cursor(&zoneGraph, groups[g].zoneIndex, registry->getZoneCount(), registry);
+        for (int index = cursor.next(); index != -1; index = cursor.next()) {
+            if (zonesListed == MAX_FALLBACK_CANDIDATES ||
+                (zonesListed >= MIN_FALLBACK_CANDIDATES && reachable >= 2 * groups[g].size)) {
+                break;
+            }
+            Zone* zone = registry->getZoneAt(index);
+            int freeSlots = zone->getAvailableSlotsFor(groups[g].slotClass);
+            if (freeSlots == 0) {
+                continue;
+            }
+            
+            int* node = zoneNode.find(zone->getZoneId());
+            if (node == nullptr) {
+                zoneNode.insert(zone->getZoneId(), nodeCount);
+                for (int c = 0; c < SLOT_CLASS_COUNT; c++) {
+                    int classFree = zone->getAvailableSlots((SlotClass)c);
+                    if (classFree > 0) {
+                        flow.addEdge(nodeCount + c, sink, classFree, 0);
+                    }
+                }
+                node = zoneNode.find(zone->getZoneId());
+                nodeCount += SLOT_CLASS_COUNT;
+            }
+            long long distance = (cursor.getDistance() >= 0) ? cursor.getDistance() : OUTSIDE_COMPONENT_COST;
+            for (int c = (int)groups[g].slotClass; c < SLOT_CLASS_COUNT; c++) {
+                int classFree = zone->getAvailableSlots((SlotClass)c);
+                if (classFree == 0) {
+                    continue;
+                }
+                int k = g * edgesPerGroup + candidateCount[g];
+                candidateZone[k] = index;
+                candidateClass[k] = (SlotClass)c;
+                int capacity = (classFree < groups[g].size) ? classFree : groups[g].size;
+                long long cost = distance * SLOT_CLASS_COUNT + (c - (int)groups[g].slotClass);
+                candidateEdge[k] = flow.addEdge(2 + g, *node + c, capacity, cost);
+                candidateCount[g]++;
+            }
+            zonesListed++;
+            reachable += freeSlots;
         }
     }
     
-    if (currentIndex == -1) {
-        return nullptr;
-    }
+    long long totalCost = 0;
+    flow.solve(source, sink, budgetNanos, totalCost, budgetExceeded);
     
-    // Search for next zone with available slots
-    for (int offset = 1; offset < zoneCount; offset++) {
-        int nextIndex = (currentIndex + offset) % zoneCount;
-        if (zones[nextIndex]->getAvailableSlots() > 0) {
-            return zones[nextIndex];
+    // Each matched (group, zone, class) takes its slots in one pass over
+    // that class's free bits, for the group's requests in arrival order
+    ParkingSlot** taken = new ParkingSlot*[overflowCount];
+    for (int g = 0; g < groupCount; g++) {
+        int request = groups[g].head;
+        for (int k = g * edgesPerGroup; k < g * edgesPerGroup + candidateCount[g] && request != -1; k++) {
+            int wanted = flow.getFlow(candidateEdge[k]);
+            if (wanted == 0) {
+                continue;
+            }
+            Zone* zone = registry->getZoneAt(candidateZone[k]);
+            int got = zone->claimSlotsOfClassInZone(taken, wanted, candidateClass[k]);
+            for (int t = 0; t < got; t++) {
+                slots[overflowIndex[request]] = taken[t];
+                request = nextInGroup[request];
+            }
+            claimed += got;
         }
     }
     
-    return nullptr;
+    delete[] taken;
+    delete[] candidateCount;
+    delete[] candidateEdge;
+    delete[] candidateClass;
+    delete[] candidateZone;
+    delete[] nextInGroup;
+    delete[] groups;
+    delete[] overflow;
+    delete[] overflowIndex;
+    return claimed;
 }
 
 void AllocationEngine::displayAllZones() const {
     cout << "\n=== All Zones in Allocation Engine ===" << endl;
-    cout << "Total Zones: " << zoneCount << endl;
+    cout << "Total Zones: " << registry->getZoneCount() << endl;
     
-    for (int i = 0; i < zoneCount; i++) {
-        zones[i]->displayZoneInfo();
+    for (int i = 0; i < registry->getZoneCount(); i++) {
+        registry->getZoneAt(i)->displayZoneInfo();
         cout << endl;
     }
 }
 
 int AllocationEngine::getTotalAvailableSlots() const {
-    int total = 0;
-    for (int i = 0; i < zoneCount; i++) {
-        total += zones[i]->getAvailableSlots();
-    }
-    return total;
+    return registry->getAvailableSlots();
+}
+
+int AllocationEngine::getTotalSlots() const {
+    return registry->getTotalSlots();
 }
\ No newline at end of file
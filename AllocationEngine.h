@@ -2,35 +2,206 @@
 #define ALLOCATIONENGINE_H
 
 #include "Zone.h"
+#include "ZoneRegistry.h"
 #include "ParkingRequest.h"
+#include "HashIndex.h"
+#include "ZoneGraph.h"
+#include "AllocationPolicy.h"
+#include <iostream>
+#include <atomic>
 
 // Forward declaration
 class ParkingRequest;
 
+// How a batch of pending requests is matched to free slots
+enum class BatchAssignment {
+    GREEDY,  // Overflow takes the nearest free zone, one request at a time
+    MIN_COST // Overflow solved together for the least total fallback distance
+};
+
 class AllocationEngine {
 private:
-    Zone** zones; // Array of zones
-    int zoneCount;
-    int maxZones;
+    ZoneRegistry* registry; // Shared with ParkingSystem, not owned
+    HashIndex<ParkingSlot*> slotIndex; // slotId -> slot, across every zone and area
+    ZoneGraph zoneGraph; // Adjacency and cached cross-zone fallback orders
+    atomic<AllocationPolicy> policy; // Used by claimSlot
+    bool policyFixed; // Set once by PolicyAllocationEngine
     
 public:
-    AllocationEngine(int maxZones);
+    AllocationEngine(ZoneRegistry* registry);
     ~AllocationEngine();
     
-    // Zone management
-    bool addZone(Zone* zone);
+    // Zone lookup
     Zone* findZone(const string& zoneId);
     
-    // Allocation logic
-    ParkingSlot* allocateSlot(ParkingRequest* request);
-    ParkingSlot* allocateCrossZone(ParkingRequest* request);
+    // Zone adjacency; cross-zone allocation prefers the nearest zone.
+    // Both must run with no allocation in flight.
+    bool addZoneAdjacency(const string& zoneA, const string& zoneB, int distance = 1);
+    void refreshZoneGraph(); // After zones are added
+    ZoneGraph* getZoneGraph();
+    
+    // Slot index
+    bool registerSlot(ParkingSlot* slot);
+    ParkingSlot* findSlot(const string& slotId) const;
+    
+    // Finds and assigns a slot in one step, safe with concurrent callers.
+    // Slots are claimed by CAS on the zone's free bits and no lock is
+    // taken, so cross-zone searches from different threads never wait.
+    // claimSlot is the runtime-selectable form: one switch on the current
+    // policy picks the claimSlotWith instantiation to run.
+    ParkingSlot* claimSlot(ParkingRequest* request);
+    template <class Policy>
+    ParkingSlot* claimSlotWith(ParkingRequest* request);
+    
+    // Policy used by claimSlot; change it with no claim in flight. Returns
+    // false, leaving it unchanged, on an engine fixed to one policy.
+    bool setPolicy(AllocationPolicy newPolicy);
+    AllocationPolicy getPolicy() const;
+    
+    // Batch path: requests are grouped by requested zone and slot class, and
+    // each group's slots are claimed in one pass over that zone's free bits
+    // of the classes it fits. slots[i] gets
+    // the slot taken for requests[i], or nullptr if its zone is unknown or
+    // ran out; the caller binds the slots and sends the rest to claimSlot.
+    int claimSlotsByZone(ParkingRequest** requests, int count, ParkingSlot** slots);
+    
+    // claimSlotsByZone, then the requests it leaves over are matched to the
+    // zones still free as a min-cost flow over fallback distance, instead of
+    // each grabbing its nearest zone in turn and crowding out later ones.
+    // Each overflow group may use its first few zones in fallback order.
+    // Solving stops after budgetNanos; unmatched requests keep nullptr for
+    // the caller's claimSlot. Claimed slots may be in other zones. The
+    // caller keeps every other allocation out while this runs.
+    int claimSlotsMinCost(ParkingRequest** requests, int count, ParkingSlot** slots,
+                          long long budgetNanos, bool& budgetExceeded);
     
     // Utility
     void displayAllZones() const;
     int getTotalAvailableSlots() const;
+    int getTotalSlots() const;
+    
+protected:
+    void fixPolicy(AllocationPolicy fixed); // For PolicyAllocationEngine's constructor
     
 private:
-    Zone* getNextAvailableZone(const string& currentZoneId);
+    struct ZoneGroup {
+        int zoneIndex;
+        SlotClass slotClass; // Every request of a group needs the same class
+        int head; // First request of the group, later ones chained by nextInGroup
+        int tail;
+        int size;
+    };
+    
+    static const int MIN_FALLBACK_CANDIDATES = 4;
+    static const int MAX_FALLBACK_CANDIDATES = 16;
+    static const long long OUTSIDE_COMPONENT_COST = 1LL << 32; // Beyond any graph distance
+    
+    // Groups by (zone, slot class); requests with an unknown zone are left
+    // out of every group
+    int groupByZone(ParkingRequest** requests, int count, ZoneGroup* groups, int* nextInGroup);
+    template <class Policy>
+    ParkingSlot* tryClaimInZone(Zone* zone, ParkingRequest* request, SlotClass fits, bool crossZone);
 };
 
+// Engine fixed to one policy at compile time: claimSlot runs the policy's
+// instantiation directly. claimSlot is not virtual, so a call through an
+// AllocationEngine pointer takes the runtime switch instead; the policy is
+// fixed to Policy::KIND and setPolicy refuses to change it, so that switch
+// always lands on the same instantiation.
+template <class Policy>
+class PolicyAllocationEngine : public AllocationEngine {
+public:
+    PolicyAllocationEngine(ZoneRegistry* registry) : AllocationEngine(registry) {
+        fixPolicy(Policy::KIND);
+    }
+    
+    ParkingSlot* claimSlot(ParkingRequest* request) {
+        return claimSlotWith<Policy>(request);
+    }
+    
+private:
+    using AllocationEngine::setPolicy; // Fixed by the type
+};
+
+// ==================== Policy Templates ====================
+template <class Policy>
+ParkingSlot* AllocationEngine::claimSlotWith(ParkingRequest* request) {
+    if (request == nullptr) {
+        cout << "Error: Cannot allocate slot for null request." << endl;
+        return nullptr;
+    }
+    
+    string requestedZoneId = request->getRequestedZoneId();
+    int requestedIndex = registry->indexOf(requestedZoneId);
+    if (requestedIndex == -1) {
+        cout << "Error: Requested zone " << requestedZoneId << " not found." << endl;
+        return nullptr;
+    }
+    
+    // Only slots of the vehicle's class or larger are candidates
+    SlotClass fits = request->getSlotClass();
+    ParkingSlot* slot = tryClaimInZone<Policy>(registry->getZoneAt(requestedIndex), request, fits, false);
+    if (slot != nullptr) {
+        return slot;
+    }
+    
+    cout << "Zone " << requestedZoneId << " is full. Attempting cross-zone allocation..." << endl;
+    
+    // Fallback order (ZoneGraph, then round-robin), taken a few free zones
+    // at a time: the policy's pick is tried first, then the rest in order. A
+    // zone that fills up between the hint and the claim just moves the
+    // search on.
+    FallbackCursor cursor(&zoneGraph, requestedIndex, registry->getZoneCount(), registry);
+    bool exhausted = false;
+    while (!exhausted) {
+        Zone* candidates[Policy::OVERFLOW_CANDIDATES];
+        int found = 0;
+        while (found < Policy::OVERFLOW_CANDIDATES) {
+            int index = cursor.next();
+            if (index == -1) {
+                exhausted = true;
+                break;
+            }
+            Zone* zone = registry->getZoneAt(index);
+            if (zone->getAvailableSlotsFor(fits) > 0) {
+                candidates[found++] = zone;
+            }
+        }
+        
+        int best = 0;
+        for (int c = 1; c < found; c++) {
+            if (Policy::preferOverflow(candidates[c], candidates[best])) {
+                best = c;
+            }
+        }
+        for (int c = 0; c < found; c++) {
+            // The pick first, then the others in fallback order
+            Zone* zone = candidates[(c == 0) ? best : (c - 1 < best ? c - 1 : c)];
+            slot = tryClaimInZone<Policy>(zone, request, fits, true);
+            if (slot != nullptr) {
+                cout << "Cross-zone allocation successful! Allocated in zone "
+                     << zone->getZoneId() << endl;
+                return slot;
+            }
+        }
+    }
+    
+    cout << "Error: No available slots in any zone." << endl;
+    return nullptr;
+}
+
+template <class Policy>
+ParkingSlot* AllocationEngine::tryClaimInZone(Zone* zone, ParkingRequest* request, SlotClass fits, bool crossZone) {
+    // The slot is taken by CAS before the request sees it; no zone lock
+    ParkingSlot* slot = Policy::claimInZone(zone, fits);
+    if (slot == nullptr) {
+        return nullptr;
+    }
+    if (!request->bindClaimedSlot(slot, crossZone)) {
+        slot->setAvailability(true);
+        return nullptr;
+    }
+    return slot;
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,87 @@
+#ifndef ALLOCATIONPOLICY_H
+#define ALLOCATIONPOLICY_H
+
+#include "Zone.h"
+using namespace std;
+
+// How AllocationEngine picks a slot for a single request
+enum class AllocationPolicy {
+    FIRST_FIT,         // Lowest free slot of the zone; first free zone in fallback order
+    BEST_FIT_AREA,     // Area with the fewest free slots, packing areas before opening others
+    LEAST_LOADED_ZONE, // First fit in the zone; overflow to the emptiest nearby zone
+    ROUND_ROBIN_AREA   // Rotates through an area's slots to spread wear
+};
+
+inline const char* allocationPolicyName(AllocationPolicy policy) {
+    switch (policy) {
+        case AllocationPolicy::BEST_FIT_AREA:
+            return "best-fit by area";
+        case AllocationPolicy::LEAST_LOADED_ZONE:
+            return "least-loaded zone";
+        case AllocationPolicy::ROUND_ROBIN_AREA:
+            return "round-robin within area";
+        default:
+            return "first-fit";
+    }
+}
+
+// Policy types for AllocationEngine::claimSlotWith<Policy>. Every hook is
+// static and inline, so the engine code instantiated for a policy calls it
+// directly, with no virtual dispatch.
+//   KIND                - the matching AllocationPolicy value
+//   claimInZone(zone, fits) - claims a slot of zone that a vehicle of
+//                         class fits can use, or returns nullptr
+//   OVERFLOW_CANDIDATES - free zones, in fallback order, compared before
+//                         a cross-zone claim
+//   preferOverflow(a, b) - true if candidate a beats the current choice b
+struct FirstFitPolicy {
+    static const AllocationPolicy KIND = AllocationPolicy::FIRST_FIT;
+    static const int OVERFLOW_CANDIDATES = 1;
+    
+    static ParkingSlot* claimInZone(Zone* zone, SlotClass fits) {
+        return zone->claimAvailableSlotInZone(fits);
+    }
+    static bool preferOverflow(const Zone*, const Zone*) {
+        return false;
+    }
+};
+
+struct BestFitAreaPolicy {
+    static const AllocationPolicy KIND = AllocationPolicy::BEST_FIT_AREA;
+    static const int OVERFLOW_CANDIDATES = 1;
+    
+    static ParkingSlot* claimInZone(Zone* zone, SlotClass fits) {
+        return zone->claimBestFitSlot(fits);
+    }
+    static bool preferOverflow(const Zone*, const Zone*) {
+        return false;
+    }
+};
+
+struct LeastLoadedZonePolicy {
+    static const AllocationPolicy KIND = AllocationPolicy::LEAST_LOADED_ZONE;
+    static const int OVERFLOW_CANDIDATES = 4;
+    
+    static ParkingSlot* claimInZone(Zone* zone, SlotClass fits) {
+        return zone->claimAvailableSlotInZone(fits);
+    }
+    static bool preferOverflow(const Zone* candidate, const Zone* current) {
+        // Higher free share; compared by cross-multiplying to stay in integers
+        return (long long)candidate->getAvailableSlots() * current->getTotalSlots() >
+               (long long)current->getAvailableSlots() * candidate->getTotalSlots();
+    }
+};
+
+struct RoundRobinAreaPolicy {
+    static const AllocationPolicy KIND = AllocationPolicy::ROUND_ROBIN_AREA;
+    static const int OVERFLOW_CANDIDATES = 1;
+    
+    static ParkingSlot* claimInZone(Zone* zone, SlotClass fits) {
+        return zone->claimRoundRobinSlot(fits);
+    }
+    static bool preferOverflow(const Zone*, const Zone*) {
+        return false;
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include "AllocationWorkerPool.h"
+#include <chrono>
+using namespace std;
+
+AllocationWorkerPool::AllocationWorkerPool(RequestDispatcher* dispatcher, RequestProcessor* processor)
+    : dispatcher(dispatcher), processor(processor), workers(nullptr), workerCount(0),
+      running(false), processedCount(0), stolenCount(0) {}
+
+AllocationWorkerPool::~AllocationWorkerPool() {
+    stop();
+}
+
+bool AllocationWorkerPool::start(int count) {
+    if (running.load() || count <= 0) {
+        return false;
+    }
+    
+    workerCount = count;
+    running.store(true);
+    workers = new thread[workerCount];
+    for (int i = 0; i < workerCount; i++) {
+        workers[i] = thread(&AllocationWorkerPool::workerLoop, this, i);
+    }
+    return true;
+}
+
+void AllocationWorkerPool::stop() {
+    if (workers == nullptr) {
+        return;
+    }
+    
+    running.store(false);
+    for (int i = 0; i < workerCount; i++) {
+        workers[i].join();
+    }
+    delete[] workers;
+    workers = nullptr;
+    workerCount = 0;
+}
+
+bool AllocationWorkerPool::isRunning() const {
+    return running.load();
+}
+
+int AllocationWorkerPool::getWorkerCount() const {
+    return workerCount;
+}
+
+long long AllocationWorkerPool::getProcessedCount() const {
+    return processedCount.load();
+}
+
+long long AllocationWorkerPool::getStolenCount() const {
+    return stolenCount.load();
+}
+
+int AllocationWorkerPool::drainLane(RequestDispatcher::ZoneLane* lane) {
+    // Another worker is on this lane; taking it too would reorder the zone
+    if (lane->busy.exchange(true, memory_order_acquire)) {
+        return 0;
+    }
+    
+    int drained = 0;
+    while (drained < DRAIN_BATCH) {
+        ParkingRequest* request = dispatcher->dequeueFrom(lane);
+        if (request == nullptr) {
+            break;
+        }
+        processor->processDequeuedRequest(request);
+        drained++;
+    }
+    
+    lane->busy.store(false, memory_order_release);
+    processedCount.fetch_add(drained, memory_order_relaxed);
+    return drained;
+}
+
+void AllocationWorkerPool::workerLoop(int workerIndex) {
+    int idleRounds = 0;
+    
+    while (running.load(memory_order_acquire)) {
+        int laneCount = dispatcher->getLaneCount();
+        int done = 0;
+        
+        // Own lanes first
+        for (int i = workerIndex; i < laneCount; i += workerCount) {
+            done += drainLane(dispatcher->getLaneAt(i));
+        }
+        
+        // Nothing of our own: steal from the busiest lane nobody is draining
+        if (done == 0) {
+            RequestDispatcher::ZoneLane* busiest = nullptr;
+            int mostPending = 0;
+            for (int i = 0; i < laneCount; i++) {
+                RequestDispatcher::ZoneLane* lane = dispatcher->getLaneAt(i);
+                int pending = lane->getSize();
+                if (pending > mostPending && !lane->busy.load(memory_order_relaxed)) {
+                    busiest = lane;
+                    mostPending = pending;
+                }
+            }
+            if (busiest != nullptr) {
+                int stolen = drainLane(busiest);
+                stolenCount.fetch_add(stolen, memory_order_relaxed);
+                done += stolen;
+            }
+        }
+        
+        // Back off gradually when there is no work
+        if (done > 0) {
+            idleRounds = 0;
+        } else if (++idleRounds < 64) {
+            this_thread::yield();
+        } else {
+            this_thread::sleep_for(chrono::microseconds(200));
+        }
+    }
+}
\ No newline at end of file
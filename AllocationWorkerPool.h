@@ -0,0 +1,53 @@
+#ifndef ALLOCATIONWORKERPOOL_H
+#define ALLOCATIONWORKERPOOL_H
+
+#include "RequestDispatcher.h"
+#include <thread>
+#include <atomic>
+using namespace std;
+
+// Callback run by a worker for every request it takes off a zone lane
+class RequestProcessor {
+public:
+    virtual ~RequestProcessor() {}
+    virtual void processDequeuedRequest(ParkingRequest* request) = 0;
+};
+
+// Pool of allocation threads draining the dispatcher's zone lanes.
+// Lanes are dealt out round-robin, so worker w owns lanes w, w + n, ...;
+// a worker with nothing to do steals from the busiest lane. A lane is only
+// drained by the worker holding its busy flag, which preserves zone order.
+class AllocationWorkerPool {
+private:
+    static const int DRAIN_BATCH = 32; // Requests taken per lane visit
+    
+    RequestDispatcher* dispatcher;
+    RequestProcessor* processor;
+    thread* workers;
+    int workerCount;
+    atomic<bool> running;
+    atomic<long long> processedCount;
+    atomic<long long> stolenCount;
+    
+public:
+    AllocationWorkerPool(RequestDispatcher* dispatcher, RequestProcessor* processor);
+    ~AllocationWorkerPool();
+    
+    bool start(int workerCount);
+    void stop(); // Joins all workers; requests still queued stay pending
+    
+    bool isRunning() const;
+    int getWorkerCount() const;
+    long long getProcessedCount() const;
+    long long getStolenCount() const;
+    
+private:
+    void workerLoop(int workerIndex);
+    int drainLane(RequestDispatcher::ZoneLane* lane);
+    
+    // Non-copyable: owns its threads
+    AllocationWorkerPool(const AllocationWorkerPool&);
+    AllocationWorkerPool& operator=(const AllocationWorkerPool&);
+};
+
+#endif
\ No newline at end of file
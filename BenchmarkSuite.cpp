@@ -0,0 +1,1341 @@
+#include "BenchmarkSuite.h"
+#include "ParkingArea.h"
+#include "ZoneRegistry.h"
+#include "AllocationEngine.h"
+#include "ParkingRequest.h"
+#include "Vehicle.h"
+#include "VehicleBST.h"
+#include "RollbackManager.h"
+#include "RequestQueue.h"
+#include "ConcurrentRequestQueue.h"
+#include "RequestScheduler.h"
+#include "TimerWheel.h"
+#include "ParkingSystem.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <thread>
+#include <atomic>
+using namespace std;
+
+BenchmarkSuite::BenchmarkSuite() : benchmarksRun(0) {}
+
+long long BenchmarkSuite::nowNanos() const {
+    return chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double BenchmarkSuite::elapsedSeconds(long long startNanos) const {
+    return (nowNanos() - startNanos) / 1e9;
+}
+
+void BenchmarkSuite::rearmRequests(ParkingRequest** requests, int count) const {
+    // A claim binds its request, so a reused request starts over fresh
+    for (int i = 0; i < count; i++) {
+        *requests[i] = ParkingRequest(requests[i]->getRequestId(), requests[i]->getVehicle(),
+                                      requests[i]->getRequestedZoneId());
+    }
+}
+
+void BenchmarkSuite::printBenchmarkResult(const string& name, long long operations, double seconds) {
+    double nsPerOp = (operations > 0) ? (seconds * 1e9 / operations) : 0.0;
+    double opsPerSec = (seconds > 0) ? (operations / seconds) : 0.0;
+    cout << "  " << left << setw(36) << name << right
+         << fixed << setprecision(1) << setw(12) << nsPerOp << " ns/op"
+         << setprecision(0) << setw(14) << opsPerSec << " ops/sec" << endl;
+}
+
+void BenchmarkSuite::runAllBenchmarks() {
+    cout << "\n=== RUNNING BENCHMARKS ===\n" << endl;
+    
+    benchmarksRun = 0;
+    
+    benchmark1_AreaFirstFreeLookup();
+    benchmark2_AllocateByZoneScaling();
+    benchmark3_VehicleIndexSequentialIds();
+    benchmark4_RollbackStackAtDepth();
+    benchmark5_RequestQueueThroughput();
+    benchmark6_ConcurrentQueueStress();
+    benchmark7_ZoneWorkerThroughput();
+    benchmark8_ConcurrentAllocationScaling();
+    benchmark9_PrioritySchedulerAtScale();
+    benchmark10_NearestZoneFallback();
+    benchmark11_NextFreeZoneSearch();
+    benchmark12_BatchAllocation();
+    benchmark13_MinCostBatchAssignment();
+    benchmark14_AllocationPolicies();
+    benchmark15_SlotClassPools();
+    benchmark16_AllocationExpiry();
+    
+    cout << "\n=== BENCHMARKS COMPLETE ===" << endl;
+    cout << "Benchmarks Run: " << benchmarksRun << endl;
+}
+
+void BenchmarkSuite::benchmark1_AreaFirstFreeLookup() {
+    cout << "Benchmark 1: Area First-Free Lookup (bitmap vs linear scan)" << endl;
+    
+    const int slotCount = 4096;
+    const int lookups = 20000;
+    
+    ParkingArea area("BENCH", "ZB", slotCount);
+    for (int i = 0; i < slotCount; i++) {
+        stringstream ss;
+        ss << "ZB-BENCH-S" << i;
+        area.addSlot(ss.str());
+    }
+    
+    // Occupy the first 3/4 of the area so the first free slot sits deep inside it
+    for (int i = 0; i < slotCount * 3 / 4; i++) {
+        area.getSlotAt(i)->setAvailability(false);
+    }
+    
+    long long checksum = 0;
+    
+    // Previous implementation: walk every slot and ask it
+    long long start = nowNanos();
+    for (int n = 0; n < lookups; n++) {
+        for (int i = 0; i < area.getCurrentSlots(); i++) {
+            if (area.getSlotAt(i)->getAvailability()) {
+                checksum += i;
+                break;
+            }
+        }
+    }
+    double scanFirstFree = elapsedSeconds(start);
+    
+    start = nowNanos();
+    for (int n = 0; n < lookups; n++) {
+        checksum += (area.getFirstAvailableSlot() != nullptr);
+    }
+    double bitmapFirstFree = elapsedSeconds(start);
+    
+    start = nowNanos();
+    for (int n = 0; n < lookups; n++) {
+        int count = 0;
+        for (int i = 0; i < area.getCurrentSlots(); i++) {
+            if (area.getSlotAt(i)->getAvailability()) {
+                count++;
+            }
+        }
+        checksum += count;
+    }
+    double scanCount = elapsedSeconds(start);
+    
+    start = nowNanos();
+    for (int n = 0; n < lookups; n++) {
+        checksum += area.countAvailableSlots();
+    }
+    double bitmapCount = elapsedSeconds(start);
+    
+    cout << "  Slots per area: " << slotCount << " (" << slotCount / 4 << " free)" << endl;
+    printBenchmarkResult("first-free, linear scan", lookups, scanFirstFree);
+    printBenchmarkResult("first-free, bitmap ffs", lookups, bitmapFirstFree);
+    printBenchmarkResult("count-free, linear scan", lookups, scanCount);
+    printBenchmarkResult("count-free, bitmap popcount", lookups, bitmapCount);
+    cout << "  Speedup (first-free): " << setprecision(1)
+         << (bitmapFirstFree > 0 ? scanFirstFree / bitmapFirstFree : 0.0) << "x" << endl;
+    cout << "  Speedup (count-free): "
+         << (bitmapCount > 0 ? scanCount / bitmapCount : 0.0) << "x" << endl;
+    cout << "  (checksum " << checksum << ")" << endl;
+    
+    benchmarksRun++;
+}
+
+
+void BenchmarkSuite::benchmark2_AllocateByZoneScaling() {
+    cout << "\nBenchmark 2: Allocate-by-Zone at 10 / 1k / 100k Zones" << endl;
+    
+    const int zoneCounts[] = {10, 1000, 100000};
+    const int requestPool = 1024;
+    const long long hashedOps = 1000000;
+    
+    for (int zoneCount : zoneCounts) {
+        ZoneRegistry registry(zoneCount);
+        AllocationEngine engine(&registry);
+        
+        for (int z = 0; z < zoneCount; z++) {
+            stringstream zoneId;
+            zoneId << "BZ" << z;
+            Zone* zone = new Zone(zoneId.str(), "Bench", 1);
+            zone->addArea("A", 4);
+            for (int i = 0; i < 4; i++) {
+                stringstream slotId;
+                slotId << zoneId.str() << "-A-S" << i;
+                zone->findArea("A")->addSlot(slotId.str());
+            }
+            registry.addZone(zone);
+        }
+        
+        // Requests spread pseudo-randomly over every zone
+        Vehicle vehicle("BV1", "Sedan", "BZ0");
+        ParkingRequest** requests = new ParkingRequest*[requestPool];
+        unsigned int seed = 12345;
+        for (int i = 0; i < requestPool; i++) {
+            seed = seed * 1103515245u + 12345u;
+            stringstream zoneId;
+            zoneId << "BZ" << (seed >> 8) % zoneCount;
+            requests[i] = new ParkingRequest("BR", &vehicle, zoneId.str());
+        }
+        
+        // Each claim is handed straight back, so zones never fill
+        long long checksum = 0;
+        double hashedSeconds = 0;
+        for (long long done = 0; done < hashedOps; done += requestPool) {
+            long long start = nowNanos();
+            for (int i = 0; i < requestPool; i++) {
+                ParkingSlot* slot = engine.claimSlot(requests[i]);
+                if (slot != nullptr) {
+                    slot->setAvailability(true);
+                    checksum++;
+                }
+            }
+            hashedSeconds += elapsedSeconds(start);
+            rearmRequests(requests, requestPool);
+        }
+        
+        // Previous implementation: linear string compare over the zone array
+        long long linearOps = 20000000LL / zoneCount;
+        if (linearOps > hashedOps) linearOps = hashedOps;
+        long long start = nowNanos();
+        for (long long n = 0; n < linearOps; n++) {
+            string wanted = requests[n % requestPool]->getRequestedZoneId();
+            for (int z = 0; z < registry.getZoneCount(); z++) {
+                if (registry.getZoneAt(z)->getZoneId() == wanted) {
+                    checksum += (registry.getZoneAt(z)->findAvailableSlotInZone() != nullptr);
+                    break;
+                }
+            }
+        }
+        double linearSeconds = elapsedSeconds(start);
+        
+        stringstream label;
+        label << zoneCount << " zones, hash registry";
+        printBenchmarkResult(label.str(), hashedOps, hashedSeconds);
+        label.str("");
+        label << zoneCount << " zones, linear lookup";
+        printBenchmarkResult(label.str(), linearOps, linearSeconds);
+        
+        for (int i = 0; i < requestPool; i++) {
+            delete requests[i];
+        }
+        delete[] requests;
+        
+        if (checksum == 0) {
+            cout << "  (no allocations succeeded)" << endl;
+        }
+    }
+    
+    benchmarksRun++;
+}
+
+void BenchmarkSuite::benchmark3_VehicleIndexSequentialIds() {
+    cout << "\nBenchmark 3: Vehicle Index with 10M Sequential IDs" << endl;
+    
+    const int vehicleCount = 10000000;
+    
+    // Same ID scheme as ParkingSystem::generateVehicleId, stored contiguously
+    Vehicle* vehicles = new Vehicle[vehicleCount];
+    for (int i = 0; i < vehicleCount; i++) {
+        vehicles[i] = Vehicle("V" + to_string(1000 + i), "Sedan", "Z1");
+    }
+    
+    VehicleBST index;
+    
+    long long start = nowNanos();
+    for (int i = 0; i < vehicleCount; i++) {
+        index.insert(&vehicles[i]);
+    }
+    double insertSeconds = elapsedSeconds(start);
+    
+    long long found = 0;
+    start = nowNanos();
+    for (int i = 0; i < vehicleCount; i++) {
+        found += (index.search(vehicles[i].getVehicleId()) != nullptr);
+    }
+    double searchSeconds = elapsedSeconds(start);
+    
+    const int missCount = 1000000;
+    long long misses = 0;
+    start = nowNanos();
+    for (int i = 0; i < missCount; i++) {
+        misses += (index.search("X" + to_string(i)) == nullptr);
+    }
+    double missSeconds = elapsedSeconds(start);
+    
+    printBenchmarkResult("insert sequential IDs", vehicleCount, insertSeconds);
+    printBenchmarkResult("search present IDs", vehicleCount, searchSeconds);
+    printBenchmarkResult("search absent IDs", missCount, missSeconds);
+    cout << "  Vehicles indexed: " << index.getCount()
+         << ", found: " << found << ", tree height: " << index.getHeight() << endl;
+    
+    if (found != vehicleCount || misses != missCount) {
+        cout << "  Error: vehicle index lookups returned wrong results" << endl;
+    }
+    
+    index.clear();
+    delete[] vehicles;
+    
+    benchmarksRun++;
+}
+
+void BenchmarkSuite::benchmark4_RollbackStackAtDepth() {
+    cout << "\nBenchmark 4: Rollback Record and Undo at Full Depth" << endl;
+    
+    const int depths[] = {10, 1024, 65536};
+    const int depthCount = 3;
+    const long long operations = 5000000;
+    
+    for (int d = 0; d < depthCount; d++) {
+        RollbackStack stack(depths[d]);
+        
+        RollbackOperation op(RollbackType::ALLOCATION, "REQ1000");
+        op.slotId = "Z1-A1-S1";
+        op.zoneId = "Z1";
+        
+        // Fill first so every timed push also evicts the oldest record
+        for (int i = 0; i < depths[d]; i++) {
+            stack.push(op);
+        }
+        
+        long long start = nowNanos();
+        for (long long n = 0; n < operations; n++) {
+            stack.push(op);
+        }
+        double pushSeconds = elapsedSeconds(start);
+        
+        RollbackOperation popped;
+        long long popCount = 0;
+        start = nowNanos();
+        while (stack.pop(popped)) {
+            popCount++;
+        }
+        double popSeconds = elapsedSeconds(start);
+        
+        stringstream label;
+        label << "depth " << depths[d] << ", push with evict";
+        printBenchmarkResult(label.str(), operations, pushSeconds);
+        label.str("");
+        label << "depth " << depths[d] << ", pop";
+        printBenchmarkResult(label.str(), popCount, popSeconds);
+    }
+    
+    benchmarksRun++;
+}
+
+void BenchmarkSuite::benchmark5_RequestQueueThroughput() {
+    cout << "\nBenchmark 5: Request Queue Enqueue/Dequeue Throughput" << endl;
+    
+    const int requestPool = 1024;
+    const long long steadyOps = 20000000;
+    const int burstSize = 5000000;
+    
+    Vehicle vehicle("BENCH-CAR", "Sedan", "Z1");
+    ParkingRequest** requests = new ParkingRequest*[requestPool];
+    for (int i = 0; i < requestPool; i++) {
+        requests[i] = new ParkingRequest("BQ" + to_string(i), &vehicle, "Z1");
+    }
+    
+    long long checksum = 0;
+    
+    // Steady state: a short backlog that keeps wrapping around the ring
+    RequestQueue steady;
+    for (int i = 0; i < 32; i++) {
+        steady.enqueue(requests[i]);
+    }
+    long long start = nowNanos();
+    for (long long n = 0; n < steadyOps; n++) {
+        steady.enqueue(requests[n & (requestPool - 1)]);
+        checksum += (steady.dequeue() != nullptr);
+    }
+    double steadySeconds = elapsedSeconds(start);
+    
+    // Burst: millions pending at once, growing from the default capacity
+    RequestQueue burst;
+    start = nowNanos();
+    for (int n = 0; n < burstSize; n++) {
+        burst.enqueue(requests[n & (requestPool - 1)]);
+    }
+    double enqueueSeconds = elapsedSeconds(start);
+    
+    start = nowNanos();
+    while (!burst.isEmpty()) {
+        checksum += (burst.dequeue() != nullptr);
+    }
+    double dequeueSeconds = elapsedSeconds(start);
+    
+    printBenchmarkResult("steady enqueue+dequeue pair", steadyOps, steadySeconds);
+    printBenchmarkResult("burst enqueue (growing)", burstSize, enqueueSeconds);
+    printBenchmarkResult("burst dequeue", burstSize, dequeueSeconds);
+    
+    if (checksum != steadyOps + burstSize) {
+        cout << "  Error: queue lost requests" << endl;
+    }
+    
+    for (int i = 0; i < requestPool; i++) {
+        delete requests[i];
+    }
+    delete[] requests;
+    
+    benchmarksRun++;
+}
+
+void BenchmarkSuite::benchmark6_ConcurrentQueueStress() {
+    cout << "\nBenchmark 6: Concurrent Queue Stress (producers x consumers)" << endl;
+    
+    // Scale up to the core count, but always exercise some contention
+    int maxThreads = (int)thread::hardware_concurrency();
+    if (maxThreads < 4) maxThreads = 4;
+    if (maxThreads > 16) maxThreads = 16;
+    
+    const int requestPool = 1024;
+    const long long itemsPerRun = 2000000;
+    ParkingRequest* requests = new ParkingRequest[requestPool];
+    
+    cout << "  Hardware threads: " << thread::hardware_concurrency() << endl;
+    
+    for (int producerCount = 1; producerCount <= maxThreads; producerCount *= 2) {
+        for (int consumerCount = 1; consumerCount <= maxThreads; consumerCount *= 2) {
+            ConcurrentRequestQueue queue(4096);
+            atomic<long long> consumed(0);
+            atomic<long long> checksum(0);
+            long long perProducer = itemsPerRun / producerCount;
+            long long total = perProducer * producerCount;
+            
+            thread* producers = new thread[producerCount];
+            thread* consumers = new thread[consumerCount];
+            
+            long long start = nowNanos();
+            for (int c = 0; c < consumerCount; c++) {
+                consumers[c] = thread([&]() {
+                    long long localSum = 0;
+                    while (consumed.load(memory_order_relaxed) < total) {
+                        ParkingRequest* request = queue.dequeue();
+                        if (request == nullptr) {
+                            this_thread::yield();
+                            continue;
+                        }
+                        localSum += (request - requests);
+                        consumed.fetch_add(1, memory_order_relaxed);
+                    }
+                    checksum.fetch_add(localSum);
+                });
+            }
+            for (int p = 0; p < producerCount; p++) {
+                producers[p] = thread([&]() {
+                    for (long long n = 0; n < perProducer; n++) {
+                        while (!queue.enqueue(&requests[n & (requestPool - 1)])) {
+                            this_thread::yield();
+                        }
+                    }
+                });
+            }
+            for (int p = 0; p < producerCount; p++) {
+                producers[p].join();
+            }
+            for (int c = 0; c < consumerCount; c++) {
+                consumers[c].join();
+            }
+            double seconds = elapsedSeconds(start);
+            
+            delete[] producers;
+            delete[] consumers;
+            
+            // Every producer pushes the same index sequence
+            long long expected = 0;
+            for (long long n = 0; n < perProducer; n++) {
+                expected += (n & (requestPool - 1));
+            }
+            expected *= producerCount;
+            
+            stringstream label;
+            label << producerCount << " producers x " << consumerCount << " consumers";
+            printBenchmarkResult(label.str(), total, seconds);
+            if (checksum.load() != expected) {
+                cout << "  Error: concurrent queue lost or duplicated requests" << endl;
+            }
+        }
+    }
+    
+    delete[] requests;
+    
+    benchmarksRun++;
+}
+
+void BenchmarkSuite::benchmark7_ZoneWorkerThroughput() {
+    cout << "\nBenchmark 7: Zone Queues Drained by Allocation Workers" << endl;
+    
+    const int zoneCount = 16;
+    const int slotsPerZone = 256;
+    const int requestCount = zoneCount * slotsPerZone;
+    const int workerCounts[] = {0, 1, 2, 4}; // 0 = processNextRequest on this thread
+    
+    for (int workers : workerCounts) {
+        // The system logs every step; keep the benchmark output readable
+        cout.setstate(ios::badbit);
+        
+        ParkingSystem* system = new ParkingSystem(zoneCount + 3);
+        for (int z = 0; z < zoneCount; z++) {
+            string zoneId = "W" + to_string(z);
+            system->addZone(zoneId, "Bench", 1);
+            system->addAreaToZone(zoneId, "A", slotsPerZone);
+            for (int i = 0; i < slotsPerZone; i++) {
+                system->addSlotToArea(zoneId, "A", zoneId + "-A-S" + to_string(i));
+            }
+        }
+        
+        long long start = nowNanos();
+        if (workers > 0) {
+            system->startAllocationWorkers(workers);
+        }
+        for (int n = 0; n < requestCount; n++) {
+            system->createParkingRequest("WB" + to_string(n), "W" + to_string(n % zoneCount));
+        }
+        if (workers > 0) {
+            while (system->getTotalRequests() < requestCount) {
+                this_thread::yield();
+            }
+            system->stopAllocationWorkers();
+        } else {
+            while (system->getPendingRequestCount() > 0) {
+                system->processNextRequest();
+            }
+        }
+        double seconds = elapsedSeconds(start);
+        int allocated = system->getTotalSlots() - system->getAvailableSlots();
+        
+        delete system;
+        cout.clear();
+        
+        stringstream label;
+        if (workers == 0) {
+            label << "caller thread, oldest first";
+        } else {
+            label << workers << " workers, " << zoneCount << " zone queues";
+        }
+        printBenchmarkResult(label.str(), requestCount, seconds);
+        if (allocated != requestCount) {
+            cout << "  Error: only " << allocated << " of " << requestCount << " requests allocated" << endl;
+        }
+    }
+    
+    benchmarksRun++;
+}
+
+void BenchmarkSuite::benchmark8_ConcurrentAllocationScaling() {
+    cout << "\nBenchmark 8: Concurrent Create+Allocate Through ParkingSystem" << endl;
+    
+    const int zoneCount = 64;
+    const int slotsPerZone = 128;
+    const int requestCount = zoneCount * slotsPerZone;
+    const int threadCounts[] = {1, 2, 4, 8};
+    
+    for (int threads : threadCounts) {
+        cout.setstate(ios::badbit);
+        
+        ParkingSystem* system = new ParkingSystem(zoneCount + 3);
+        for (int z = 0; z < zoneCount; z++) {
+            string zoneId = "C" + to_string(z);
+            system->addZone(zoneId, "Bench", 1);
+            system->addAreaToZone(zoneId, "A", slotsPerZone);
+            for (int i = 0; i < slotsPerZone; i++) {
+                system->addSlotToArea(zoneId, "A", zoneId + "-A-S" + to_string(i));
+            }
+        }
+        
+        // Every thread is both a front end and an allocator, on its own zones
+        int perThread = requestCount / threads;
+        thread* callers = new thread[threads];
+        long long start = nowNanos();
+        for (int t = 0; t < threads; t++) {
+            callers[t] = thread([system, t, threads, perThread, zoneCount]() {
+                for (int i = 0; i < perThread; i++) {
+                    int zone = (t + i * threads) % zoneCount;
+                    system->createParkingRequest("CT" + to_string(t) + "-" + to_string(i), "C" + to_string(zone));
+                    system->processNextRequest();
+                }
+            });
+        }
+        for (int t = 0; t < threads; t++) {
+            callers[t].join();
+        }
+        double seconds = elapsedSeconds(start);
+        delete[] callers;
+        
+        int allocated = system->getTotalSlots() - system->getAvailableSlots();
+        bool consistent = system->verifyCapacityCounters();
+        delete system;
+        cout.clear();
+        
+        stringstream label;
+        label << threads << " caller threads";
+        printBenchmarkResult(label.str(), perThread * threads, seconds);
+        if (allocated != perThread * threads || !consistent) {
+            cout << "  Error: " << allocated << " of " << (perThread * threads)
+                 << " requests allocated, counters " << (consistent ? "consistent" : "inconsistent") << endl;
+        }
+    }
+    
+    benchmarksRun++;
+}
+
+void BenchmarkSuite::benchmark9_PrioritySchedulerAtScale() {
+    cout << "\nBenchmark 9: Priority Scheduler with 1K / 1M Pending Requests" << endl;
+    
+    const int sizes[] = {1000, 1000000};
+    Vehicle vehicle("BENCH-CAR", "Sedan", "Z1");
+    
+    for (int size : sizes) {
+        // Mixed classes: mostly walk-ins, some permits, a few accessible
+        ParkingRequest** requests = new ParkingRequest*[size];
+        unsigned int seed = 12345;
+        for (int i = 0; i < size; i++) {
+            requests[i] = new ParkingRequest("PS" + to_string(i), &vehicle, "Z1");
+            seed = seed * 1103515245 + 12345;
+            int roll = (seed >> 16) % 10;
+            requests[i]->setPriorityClass(roll < 7 ? PriorityClass::STANDARD :
+                                          roll < 9 ? PriorityClass::PERMIT : PriorityClass::ACCESSIBLE);
+        }
+        
+        // One arrival per 10 ms, so aging and class head starts interleave
+        RequestScheduler scheduler;
+        long long start = nowNanos();
+        for (int i = 0; i < size; i++) {
+            scheduler.enqueue(requests[i], i * 10LL);
+        }
+        double enqueueSeconds = elapsedSeconds(start);
+        
+        // Every tenth request changes class while queued
+        int updates = size / 10;
+        start = nowNanos();
+        for (int i = 0; i < updates; i++) {
+            ParkingRequest* request = requests[(i * 7919LL) % size];
+            PriorityClass next = (PriorityClass)(((int)request->getPriorityClass() + 1) % PRIORITY_CLASS_COUNT);
+            scheduler.updatePriority(request->getRequestId(), next);
+        }
+        double updateSeconds = elapsedSeconds(start);
+        
+        // Drain, checking that effective keys come out in order
+        long long headStart[PRIORITY_CLASS_COUNT];
+        for (int c = 0; c < PRIORITY_CLASS_COUNT; c++) {
+            headStart[c] = scheduler.getClassHeadStart((PriorityClass)c);
+        }
+        long long lastKey = 0;
+        bool ordered = true;
+        int drained = 0;
+        start = nowNanos();
+        ParkingRequest* request;
+        while ((request = scheduler.dequeue()) != nullptr) {
+            long long key = (long long)request->getIntakeSequence() * 10 -
+                            headStart[(int)request->getPriorityClass()];
+            if (drained > 0 && key < lastKey) {
+                ordered = false;
+            }
+            lastKey = key;
+            drained++;
+        }
+        double dequeueSeconds = elapsedSeconds(start);
+        
+        stringstream label;
+        label << size << " pending, ";
+        printBenchmarkResult(label.str() + "enqueue", size, enqueueSeconds);
+        printBenchmarkResult(label.str() + "priority update", updates, updateSeconds);
+        printBenchmarkResult(label.str() + "dequeue", size, dequeueSeconds);
+        if (!ordered || drained != size) {
+            cout << "  Error: scheduler returned " << drained << " of " << size
+                 << " requests" << (ordered ? "" : " out of priority order") << endl;
+        }
+        
+        for (int i = 0; i < size; i++) {
+            delete requests[i];
+        }
+        delete[] requests;
+    }
+    
+    benchmarksRun++;
+}
+
+void BenchmarkSuite::benchmark10_NearestZoneFallback() {
+    cout << "\nBenchmark 10: Cross-Zone Fallback on a 32x32 Zone Grid" << endl;
+    
+    // Zones are registered in scrambled order, so registry neighbours are
+    // rarely street neighbours. One zone in sixteen has a free slot.
+    const int side = 32;
+    const int zoneCount = side * side;
+    const int requestPool = 1024;
+    const long long ops = 1000000;
+    
+    ZoneRegistry registry(zoneCount);
+    int* cellOf = new int[zoneCount]; // Registry index -> grid cell
+    for (int i = 0; i < zoneCount; i++) {
+        int cell = (i * 389) % zoneCount;
+        cellOf[i] = cell;
+        Zone* zone = new Zone("GZ" + to_string(cell), "Grid", 1);
+        zone->addArea("A", 1);
+        zone->findArea("A")->addSlot("GZ" + to_string(cell) + "-A-S1");
+        if ((cell % side) % 4 != 1 || (cell / side) % 4 != 1) {
+            zone->claimAvailableSlotInZone();
+        }
+        registry.addZone(zone);
+    }
+    
+    // Same registry, with and without street adjacency
+    AllocationEngine graphEngine(&registry);
+    AllocationEngine plainEngine(&registry);
+    for (int cell = 0; cell < zoneCount; cell++) {
+        string zoneId = "GZ" + to_string(cell);
+        if (cell % side + 1 < side) {
+            graphEngine.addZoneAdjacency(zoneId, "GZ" + to_string(cell + 1));
+        }
+        if (cell + side < zoneCount) {
+            graphEngine.addZoneAdjacency(zoneId, "GZ" + to_string(cell + side));
+        }
+    }
+    
+    // Requests for full zones only, so every one falls back
+    Vehicle vehicle("BV1", "Sedan", "GZ0");
+    ParkingRequest** requests = new ParkingRequest*[requestPool];
+    unsigned int seed = 12345;
+    for (int i = 0; i < requestPool; ) {
+        seed = seed * 1103515245u + 12345u;
+        int index = (seed >> 8) % zoneCount;
+        if (registry.getZoneAt(index)->getAvailableSlots() == 0) {
+            requests[i++] = new ParkingRequest("BR", &vehicle, registry.getZoneAt(index)->getZoneId());
+        }
+    }
+    
+    AllocationEngine* engines[] = {&graphEngine, &plainEngine};
+    const char* names[] = {"adjacency order", "round-robin order"};
+    long long checksum = 0;
+    cout.setstate(ios::badbit); // Fallback messages
+    
+    // First pass over every zone builds the cached orders. Every claimed
+    // slot is handed straight back, so the free zones stay the same.
+    long long start = nowNanos();
+    for (int z = 0; z < zoneCount; z++) {
+        ParkingRequest request("BR", &vehicle, registry.getZoneAt(z)->getZoneId());
+        ParkingSlot* slot = graphEngine.claimSlot(&request);
+        if (slot != nullptr) {
+            slot->setAvailability(true);
+            checksum++;
+        }
+    }
+    double buildSeconds = elapsedSeconds(start);
+    
+    double seconds[2];
+    double meanDistance[2];
+    for (int e = 0; e < 2; e++) {
+        seconds[e] = 0;
+        for (long long done = 0; done < ops; done += requestPool) {
+            start = nowNanos();
+            for (int i = 0; i < requestPool; i++) {
+                ParkingSlot* slot = engines[e]->claimSlot(requests[i]);
+                if (slot != nullptr) {
+                    slot->setAvailability(true);
+                    checksum++;
+                }
+            }
+            seconds[e] += elapsedSeconds(start);
+            rearmRequests(requests, requestPool);
+        }
+        
+        // Grid distance from the requested zone to the one offered
+        long long totalDistance = 0;
+        for (int i = 0; i < requestPool; i++) {
+            ParkingSlot* slot = engines[e]->claimSlot(requests[i]);
+            slot->setAvailability(true);
+            int from = cellOf[registry.indexOf(requests[i]->getRequestedZoneId())];
+            int to = cellOf[registry.indexOf(slot->getZoneId())];
+            int dx = from % side - to % side;
+            int dy = from / side - to / side;
+            totalDistance += (dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy);
+        }
+        meanDistance[e] = (double)totalDistance / requestPool;
+        rearmRequests(requests, requestPool);
+    }
+    cout.clear();
+    
+    printBenchmarkResult("first fallback per zone (builds)", zoneCount, buildSeconds);
+    for (int e = 0; e < 2; e++) {
+        printBenchmarkResult(names[e], ops, seconds[e]);
+    }
+    cout << "  Mean grid distance to offered zone: " << fixed << setprecision(2)
+         << meanDistance[0] << " (" << names[0] << ") vs "
+         << meanDistance[1] << " (" << names[1] << ")" << endl;
+    
+    for (int i = 0; i < requestPool; i++) {
+        delete requests[i];
+    }
+    delete[] requests;
+    delete[] cellOf;
+    
+    if (checksum == 0) {
+        cout << "  (no allocations succeeded)" << endl;
+    }
+    
+    benchmarksRun++;
+}
+
+void BenchmarkSuite::benchmark11_NextFreeZoneSearch() {
+    cout << "\nBenchmark 11: Next Free Zone at 1k / 100k Zones (0.1% free)" << endl;
+    
+    const int zoneCounts[] = {1000, 100000};
+    const long long ops = 1000000;
+    
+    for (int zoneCount : zoneCounts) {
+        ZoneRegistry registry(zoneCount);
+        for (int z = 0; z < zoneCount; z++) {
+            string zoneId = "NZ" + to_string(z);
+            Zone* zone = new Zone(zoneId, "Bench", 1);
+            zone->addArea("A", 1);
+            zone->findArea("A")->addSlot(zoneId + "-A-S1");
+            registry.addZone(zone);
+        }
+        
+        // One zone in a thousand keeps its slot, at pseudo-random positions
+        unsigned int seed = 12345;
+        for (int z = 0; z < zoneCount; z++) {
+            seed = seed * 1103515245u + 12345u;
+            if ((seed >> 8) % 1000 != 0) {
+                registry.getZoneAt(z)->claimAvailableSlotInZone();
+            }
+        }
+        
+        long long checksum = 0;
+        long long start = nowNanos();
+        for (long long n = 0; n < ops; n++) {
+            seed = seed * 1103515245u + 12345u;
+            checksum += registry.findZoneWithCapacity((seed >> 8) % zoneCount);
+        }
+        double treeSeconds = elapsedSeconds(start);
+        
+        // Previous implementation: step over full zones one at a time
+        long long linearOps = ops / 10;
+        start = nowNanos();
+        for (long long n = 0; n < linearOps; n++) {
+            seed = seed * 1103515245u + 12345u;
+            int origin = (seed >> 8) % zoneCount;
+            for (int offset = 0; offset < zoneCount; offset++) {
+                int z = (origin + offset) % zoneCount;
+                if (registry.getZoneAt(z)->getAvailableSlots() > 0) {
+                    checksum += z;
+                    break;
+                }
+            }
+        }
+        double linearSeconds = elapsedSeconds(start);
+        
+        // A claim and a release, each adjusting O(log n) tree nodes
+        start = nowNanos();
+        for (long long n = 0; n < ops; n++) {
+            seed = seed * 1103515245u + 12345u;
+            ParkingSlot* slot = registry.getZoneAt((seed >> 8) % zoneCount)->findArea("A")->getSlotAt(0);
+            bool wasFree = slot->getAvailability();
+            slot->setAvailability(!wasFree);
+            slot->setAvailability(wasFree);
+        }
+        double updateSeconds = elapsedSeconds(start);
+        
+        stringstream label;
+        label << zoneCount << " zones, ";
+        printBenchmarkResult(label.str() + "capacity tree", ops, treeSeconds);
+        printBenchmarkResult(label.str() + "linear scan", linearOps, linearSeconds);
+        printBenchmarkResult(label.str() + "slot flip pair", ops, updateSeconds);
+        
+        if (checksum == 0) {
+            cout << "  (no free zone found)" << endl;
+        }
+    }
+    
+    benchmarksRun++;
+}
+
+void BenchmarkSuite::benchmark12_BatchAllocation() {
+    cout << "\nBenchmark 12: Burst of 8192 Requests, Single vs Batch Processing" << endl;
+    
+    const int zoneCount = 64;
+    const int slotsPerZone = 128;
+    const int requestCount = zoneCount * slotsPerZone;
+    const int batchSizes[] = {1, 64, 1024, 8192}; // 1 = processNextRequest
+    
+    for (int batchSize : batchSizes) {
+        cout.setstate(ios::badbit);
+        
+        ParkingSystem* system = new ParkingSystem(zoneCount + 3);
+        for (int z = 0; z < zoneCount; z++) {
+            string zoneId = "BB" + to_string(z);
+            system->addZone(zoneId, "Bench", 1);
+            system->addAreaToZone(zoneId, "A", slotsPerZone);
+            for (int i = 0; i < slotsPerZone; i++) {
+                system->addSlotToArea(zoneId, "A", zoneId + "-A-S" + to_string(i));
+            }
+        }
+        
+        // The whole burst is pending before processing starts
+        unsigned int seed = 12345;
+        for (int n = 0; n < requestCount; n++) {
+            seed = seed * 1103515245u + 12345u;
+            system->createParkingRequest("BB" + to_string(n), "BB" + to_string((seed >> 8) % zoneCount));
+        }
+        
+        long long start = nowNanos();
+        if (batchSize == 1) {
+            while (system->processNextRequest()) {
+            }
+        } else {
+            while (system->processPendingBatch(batchSize) > 0) {
+            }
+        }
+        double seconds = elapsedSeconds(start);
+        int allocated = system->getTotalSlots() - system->getAvailableSlots();
+        
+        delete system;
+        cout.clear();
+        
+        stringstream label;
+        if (batchSize == 1) {
+            label << "processNextRequest";
+        } else {
+            label << "processPendingBatch(" << batchSize << ")";
+        }
+        printBenchmarkResult(label.str(), requestCount, seconds);
+        if (allocated != requestCount) {
+            cout << "  Error: only " << allocated << " of " << requestCount << " requests allocated" << endl;
+        }
+    }
+    
+    benchmarksRun++;
+}
+
+void BenchmarkSuite::benchmark13_MinCostBatchAssignment() {
+    cout << "\nBenchmark 13: Skewed Burst on a Ring of 64 Zones, Greedy vs Min-Cost" << endl;
+    
+    // Every other zone draws three times the share of its neighbours, so
+    // hot zones overflow into the same cold zones from both sides
+    const int zoneCount = 64;
+    const int slotsPerZone = 32;
+    const int requestCount = zoneCount * slotsPerZone * 9 / 10;
+    const int windows[] = {1, 256, 2048}; // 1 = processNextRequest
+    
+    int* requestedZone = new int[requestCount];
+    unsigned int seed = 12345;
+    for (int n = 0; n < requestCount; n++) {
+        seed = seed * 1103515245u + 12345u;
+        int draw = (seed >> 8) % (2 * zoneCount);
+        requestedZone[n] = (draw < zoneCount) ? draw : (draw - zoneCount) / 2 * 2;
+    }
+    
+    for (int window : windows) {
+        for (int mode = 0; mode < 2; mode++) {
+            if (window == 1 && mode == 1) {
+                continue;
+            }
+            BatchAssignment assignment = (mode == 0) ? BatchAssignment::GREEDY : BatchAssignment::MIN_COST;
+            cout.setstate(ios::badbit);
+            
+            ParkingSystem* system = new ParkingSystem(zoneCount + 3);
+            for (int z = 0; z < zoneCount; z++) {
+                string zoneId = "MC" + to_string(z);
+                system->addZone(zoneId, "Bench", 1);
+                system->addAreaToZone(zoneId, "A", slotsPerZone);
+                for (int i = 0; i < slotsPerZone; i++) {
+                    system->addSlotToArea(zoneId, "A", zoneId + "-A-S" + to_string(i));
+                }
+            }
+            for (int z = 0; z < zoneCount; z++) {
+                system->addZoneAdjacency("MC" + to_string(z), "MC" + to_string((z + 1) % zoneCount), 1);
+            }
+            for (int n = 0; n < requestCount; n++) {
+                system->createParkingRequest(to_string(n), "MC" + to_string(requestedZone[n]));
+            }
+            
+            long long start = nowNanos();
+            if (window == 1) {
+                while (system->processNextRequest()) {
+                }
+            } else {
+                while (system->processPendingBatch(window, assignment) > 0) {
+                }
+            }
+            double seconds = elapsedSeconds(start);
+            
+            // Vehicle IDs are request numbers; distance is around the ring
+            int allocated = 0;
+            int crossZone = 0;
+            long long totalDistance = 0;
+            for (int z = 0; z < zoneCount; z++) {
+                for (int i = 0; i < slotsPerZone; i++) {
+                    ParkingSlot* slot = system->findSlot("MC" + to_string(z) + "-A-S" + to_string(i));
+                    if (slot->getAvailability()) {
+                        continue;
+                    }
+                    int from = requestedZone[stoi(slot->getVehicleId())];
+                    int distance = (z - from + zoneCount) % zoneCount;
+                    if (zoneCount - distance < distance) {
+                        distance = zoneCount - distance;
+                    }
+                    allocated++;
+                    crossZone += (distance > 0) ? 1 : 0;
+                    totalDistance += distance;
+                }
+            }
+            
+            delete system;
+            cout.clear();
+            
+            stringstream label;
+            if (window == 1) {
+                label << "processNextRequest";
+            } else {
+                label << "batch(" << window << "), " << (mode == 0 ? "greedy" : "min-cost");
+            }
+            printBenchmarkResult(label.str(), requestCount, seconds);
+            cout << "    " << allocated << " allocated, " << crossZone << " cross-zone, total ring distance "
+                 << totalDistance << endl;
+        }
+    }
+    
+    delete[] requestedZone;
+    benchmarksRun++;
+}
+
+// One run of the benchmark 14 trace on a fresh 64-zone ring. Engine is a
+// PolicyAllocationEngine, or AllocationEngine for its runtime switch.
+// Returns the seconds spent on the steady-state part of the trace.
+template <class Engine>
+static double runPolicyTrace(const int* claimZone, const unsigned int* releasePick, int warmup, int steady,
+                             int zoneCount, int areasPerZone, int slotsPerArea,
+                             int& crossZone, long long& overflowDistance) {
+    ZoneRegistry registry(zoneCount);
+    for (int z = 0; z < zoneCount; z++) {
+        string zoneId = "PZ" + to_string(z);
+        Zone* zone = new Zone(zoneId, "Bench", areasPerZone);
+        for (int a = 0; a < areasPerZone; a++) {
+            string areaId = "A" + to_string(a);
+            zone->addArea(areaId, slotsPerArea);
+            for (int i = 0; i < slotsPerArea; i++) {
+                zone->findArea(areaId)->addSlot(zoneId + "-" + areaId + "-S" + to_string(i));
+            }
+        }
+        registry.addZone(zone);
+    }
+    Engine engine(&registry);
+    for (int z = 0; z < zoneCount; z++) {
+        engine.addZoneAdjacency("PZ" + to_string(z), "PZ" + to_string((z + 1) % zoneCount));
+    }
+    
+    int claims = warmup + steady;
+    Vehicle vehicle("PV1", "Sedan", "PZ0");
+    ParkingRequest** requests = new ParkingRequest*[claims];
+    for (int k = 0; k < claims; k++) {
+        requests[k] = new ParkingRequest("PR", &vehicle, "PZ" + to_string(claimZone[k]));
+    }
+    ParkingSlot** held = new ParkingSlot*[claims];
+    int heldCount = 0;
+    
+    for (int k = 0; k < warmup; k++) {
+        held[heldCount++] = engine.claimSlot(requests[k]);
+    }
+    
+    // Each step frees a random held slot and claims one for the next request
+    long long start = chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+    for (int k = warmup; k < claims; k++) {
+        int victim = releasePick[k - warmup] % heldCount;
+        held[victim]->setAvailability(true);
+        held[victim] = engine.claimSlot(requests[k]);
+    }
+    long long elapsed = chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count() - start;
+    
+    // Ring distance of every cross-zone claim; zone IDs are PZ<index>
+    crossZone = 0;
+    overflowDistance = 0;
+    for (int k = warmup; k < claims; k++) {
+        if (!requests[k]->isCrossZoneAllocation()) {
+            continue;
+        }
+        int to = stoi(requests[k]->getAllocatedSlot()->getZoneId().substr(2));
+        int distance = (to - claimZone[k] + zoneCount) % zoneCount;
+        if (zoneCount - distance < distance) {
+            distance = zoneCount - distance;
+        }
+        crossZone++;
+        overflowDistance += distance;
+    }
+    
+    for (int k = 0; k < claims; k++) {
+        delete requests[k];
+    }
+    delete[] requests;
+    delete[] held;
+    return elapsed / 1e9;
+}
+
+void BenchmarkSuite::benchmark14_AllocationPolicies() {
+    cout << "\nBenchmark 14: Allocation Policies on One Claim/Release Trace" << endl;
+    
+    // 64 zones of 4 x 64 slots on a ring, filled to 75% and then churned:
+    // every step releases a random held slot and claims one. A block of 16
+    // neighbouring zones draws three times the share of the others.
+    const int zoneCount = 64;
+    const int areasPerZone = 4;
+    const int slotsPerArea = 64;
+    const int warmup = zoneCount * areasPerZone * slotsPerArea * 3 / 4;
+    const int steady = 200000;
+    
+    int* claimZone = new int[warmup + steady];
+    unsigned int* releasePick = new unsigned int[steady];
+    unsigned int seed = 12345;
+    for (int k = 0; k < warmup + steady; k++) {
+        seed = seed * 1103515245u + 12345u;
+        int draw = (seed >> 8) % (zoneCount + 32);
+        claimZone[k] = (draw < zoneCount) ? draw : (draw - zoneCount) / 2;
+    }
+    for (int k = 0; k < steady; k++) {
+        seed = seed * 1103515245u + 12345u;
+        releasePick[k] = seed >> 8;
+    }
+    
+    const char* names[] = {"first-fit", "best-fit by area", "least-loaded zone",
+                           "round-robin within area", "first-fit, runtime switch"};
+    double seconds[5];
+    int crossZone[5];
+    long long overflowDistance[5];
+    
+    cout.setstate(ios::badbit); // Fallback messages
+    seconds[0] = runPolicyTrace<PolicyAllocationEngine<FirstFitPolicy> >(
+        claimZone, releasePick, warmup, steady, zoneCount, areasPerZone, slotsPerArea, crossZone[0], overflowDistance[0]);
+    seconds[1] = runPolicyTrace<PolicyAllocationEngine<BestFitAreaPolicy> >(
+        claimZone, releasePick, warmup, steady, zoneCount, areasPerZone, slotsPerArea, crossZone[1], overflowDistance[1]);
+    seconds[2] = runPolicyTrace<PolicyAllocationEngine<LeastLoadedZonePolicy> >(
+        claimZone, releasePick, warmup, steady, zoneCount, areasPerZone, slotsPerArea, crossZone[2], overflowDistance[2]);
+    seconds[3] = runPolicyTrace<PolicyAllocationEngine<RoundRobinAreaPolicy> >(
+        claimZone, releasePick, warmup, steady, zoneCount, areasPerZone, slotsPerArea, crossZone[3], overflowDistance[3]);
+    seconds[4] = runPolicyTrace<AllocationEngine>(
+        claimZone, releasePick, warmup, steady, zoneCount, areasPerZone, slotsPerArea, crossZone[4], overflowDistance[4]);
+    cout.clear();
+    
+    for (int p = 0; p < 5; p++) {
+        printBenchmarkResult(names[p], steady, seconds[p]);
+        cout << "    cross-zone " << fixed << setprecision(2) << 100.0 * crossZone[p] / steady
+             << "%, mean overflow distance "
+             << (crossZone[p] > 0 ? (double)overflowDistance[p] / crossZone[p] : 0.0) << endl;
+    }
+    
+    delete[] releasePick;
+    delete[] claimZone;
+    benchmarksRun++;
+}
+
+// Class the areas of benchmark 15 are built for, smallest first
+static SlotClass benchAreaClass(int area, int areaCount) {
+    if (area < areaCount / 8) {
+        return SlotClass::MOTORCYCLE;
+    }
+    if (area < areaCount / 4) {
+        return SlotClass::COMPACT;
+    }
+    return (area < areaCount * 3 / 4) ? SlotClass::STANDARD : SlotClass::LARGE;
+}
+
+// One mixed-fleet claim/release trace on a single zone. With classed false
+// every slot is registered as large, as before slot classes, so claims
+// ignore what the area was built for; misfits counts vehicles that then
+// land in a slot too small for them.
+static double runClassTrace(bool classed, const int* vehicleKind, const unsigned int* releasePick,
+                            int warmup, int steady, int areaCount, int slotsPerArea,
+                            int& misfits, int& upsized, int& rejected) {
+    ZoneRegistry registry(1);
+    Zone* zone = new Zone("CZ", "Bench", areaCount);
+    for (int a = 0; a < areaCount; a++) {
+        string areaId = "A" + to_string(a);
+        zone->addArea(areaId, slotsPerArea);
+        SlotClass slotClass = classed ? benchAreaClass(a, areaCount) : SlotClass::LARGE;
+        for (int i = 0; i < slotsPerArea; i++) {
+            zone->findArea(areaId)->addSlot("CZ-" + areaId + "-S" + to_string(i), slotClass);
+        }
+    }
+    registry.addZone(zone);
+    AllocationEngine engine(&registry);
+    
+    Vehicle fleet[] = {Vehicle("CV0", "Motorcycle", "CZ"), Vehicle("CV1", "Compact", "CZ"),
+                       Vehicle("CV2", "Sedan", "CZ"), Vehicle("CV3", "Truck", "CZ")};
+    int claims = warmup + steady;
+    ParkingRequest** requests = new ParkingRequest*[claims];
+    for (int k = 0; k < claims; k++) {
+        requests[k] = new ParkingRequest("CR", &fleet[vehicleKind[k]], "CZ");
+    }
+    ParkingSlot** held = new ParkingSlot*[warmup];
+    for (int k = 0; k < warmup; k++) {
+        held[k] = engine.claimSlot(requests[k]);
+    }
+    
+    long long start = chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+    for (int k = warmup; k < claims; k++) {
+        int victim = releasePick[k - warmup] % warmup;
+        if (held[victim] != nullptr) {
+            held[victim]->setAvailability(true);
+        }
+        held[victim] = engine.claimSlot(requests[k]);
+    }
+    long long elapsed = chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count() - start;
+    
+    // Judge each steady-state claim against the class its area was built for
+    misfits = 0;
+    upsized = 0;
+    rejected = 0;
+    for (int k = warmup; k < claims; k++) {
+        ParkingSlot* slot = requests[k]->getAllocatedSlot();
+        if (slot == nullptr) {
+            rejected++;
+            continue;
+        }
+        int area = 0;
+        while (zone->getAreaAt(area) != slot->getParentArea()) {
+            area++;
+        }
+        SlotClass built = benchAreaClass(area, areaCount);
+        if (!slotClassFits(fleet[vehicleKind[k]].getSlotClass(), built)) {
+            misfits++;
+        } else if (built != fleet[vehicleKind[k]].getSlotClass()) {
+            upsized++;
+        }
+    }
+    
+    for (int k = 0; k < claims; k++) {
+        delete requests[k];
+    }
+    delete[] requests;
+    delete[] held;
+    return elapsed / 1e9;
+}
+
+void BenchmarkSuite::benchmark15_SlotClassPools() {
+    cout << "\nBenchmark 15: Mixed Fleet on Class-Aware Slot Pools" << endl;
+    
+    // One zone of 16 x 256 slots built as 1/8 motorcycle, 1/8 compact, 1/2
+    // standard and 1/4 large, held at 85% by a fleet of 10% motorcycles,
+    // 20% compacts, 50% sedans and 20% trucks while slots are churned
+    const int areaCount = 16;
+    const int slotsPerArea = 256;
+    const int warmup = areaCount * slotsPerArea * 85 / 100;
+    const int steady = 200000;
+    
+    int* vehicleKind = new int[warmup + steady];
+    unsigned int* releasePick = new unsigned int[steady];
+    unsigned int seed = 4242;
+    for (int k = 0; k < warmup + steady; k++) {
+        seed = seed * 1103515245u + 12345u;
+        int draw = (seed >> 8) % 10;
+        vehicleKind[k] = (draw < 1) ? 0 : (draw < 3) ? 1 : (draw < 8) ? 2 : 3;
+    }
+    for (int k = 0; k < steady; k++) {
+        seed = seed * 1103515245u + 12345u;
+        releasePick[k] = seed >> 8;
+    }
+    
+    const char* names[] = {"untyped slots (all large)", "class-aware pools"};
+    double seconds[2];
+    int misfits[2];
+    int upsized[2];
+    int rejected[2];
+    
+    cout.setstate(ios::badbit); // Rejection messages
+    for (int run = 0; run < 2; run++) {
+        seconds[run] = runClassTrace(run == 1, vehicleKind, releasePick, warmup, steady, areaCount, slotsPerArea,
+                                     misfits[run], upsized[run], rejected[run]);
+    }
+    cout.clear();
+    
+    for (int run = 0; run < 2; run++) {
+        printBenchmarkResult(names[run], steady, seconds[run]);
+        cout << "    too small " << fixed << setprecision(2) << 100.0 * misfits[run] / steady
+             << "%, larger class " << 100.0 * upsized[run] / steady
+             << "%, no fitting slot " << 100.0 * rejected[run] / steady << "%" << endl;
+    }
+    
+    delete[] releasePick;
+    delete[] vehicleKind;
+    benchmarksRun++;
+}
+
+void BenchmarkSuite::benchmark16_AllocationExpiry() {
+    cout << "\nBenchmark 16: Allocation Expiry with 10K / 1M Outstanding Timers" << endl;
+    
+    const int sizes[] = {10000, 1000000};
+    const time_t base = 1700000000;
+    const time_t hold = 15 * 60;
+    const time_t window = 3600;
+    
+    for (int size : sizes) {
+        // Allocations spread over an hour, each held for 15 minutes; seven
+        // in ten drivers arrive and cancel their timer
+        ParkingRequest* requests = new ParkingRequest[size];
+        time_t* deadlines = new time_t[size];
+        for (int i = 0; i < size; i++) {
+            deadlines[i] = base + (time_t)((long long)i * window / size) + hold;
+        }
+        
+        TimerWheel wheel(base);
+        long long start = nowNanos();
+        for (int i = 0; i < size; i++) {
+            wheel.schedule(&requests[i], deadlines[i]);
+        }
+        double scheduleSeconds = elapsedSeconds(start);
+        
+        int cancelled = 0;
+        start = nowNanos();
+        for (int i = 0; i < size; i++) {
+            if (i % 10 < 7) {
+                wheel.cancel(&requests[i]);
+                cancelled++;
+            }
+        }
+        double cancelSeconds = elapsedSeconds(start);
+        
+        // Once a second, as the system clock drives it
+        int ticks = (int)(window + hold);
+        int expired = 0;
+        start = nowNanos();
+        for (time_t t = base + 1; t <= base + ticks; t++) {
+            while (wheel.takeExpired(t) != nullptr) {
+                expired++;
+            }
+        }
+        double expireSeconds = elapsedSeconds(start);
+        
+        // What the wheel replaces: one pass over every allocation per second
+        const int passes = 20;
+        int due = 0;
+        start = nowNanos();
+        for (int pass = 0; pass < passes; pass++) {
+            time_t now = base + hold + pass;
+            for (int i = 0; i < size; i++) {
+                if (requests[i].getCurrentState() == RequestState::REQUESTED && deadlines[i] <= now) {
+                    due++;
+                }
+            }
+        }
+        double scanSeconds = elapsedSeconds(start);
+        
+        stringstream label;
+        label << size << " timers, ";
+        printBenchmarkResult(label.str() + "schedule", size, scheduleSeconds);
+        printBenchmarkResult(label.str() + "cancel", cancelled, cancelSeconds);
+        printBenchmarkResult(label.str() + "wheel, per second", ticks, expireSeconds);
+        printBenchmarkResult(label.str() + "full scan, per second", passes, scanSeconds);
+        cout << "    expired " << expired << " of " << size << " allocations; a scan sees "
+             << due / passes << " due per pass" << endl;
+        if (expired != size - cancelled) {
+            cout << "  Error: expected " << (size - cancelled) << " to expire" << endl;
+        }
+        
+        delete[] deadlines;
+        delete[] requests;
+    }
+    
+    benchmarksRun++;
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef BENCHMARKSUITE_H
+#define BENCHMARKSUITE_H
+
+#include <string>
+#include "ParkingRequest.h"
+using namespace std;
+
+class BenchmarkSuite {
+private:
+    int benchmarksRun;
+    
+public:
+    BenchmarkSuite();
+    
+    void runAllBenchmarks();
+    
+private:
+    // Individual benchmarks
+    void benchmark1_AreaFirstFreeLookup();
+    void benchmark2_AllocateByZoneScaling();
+    void benchmark3_VehicleIndexSequentialIds();
+    void benchmark4_RollbackStackAtDepth();
+    void benchmark5_RequestQueueThroughput();
+    void benchmark6_ConcurrentQueueStress();
+    void benchmark7_ZoneWorkerThroughput();
+    void benchmark8_ConcurrentAllocationScaling();
+    void benchmark9_PrioritySchedulerAtScale();
+    void benchmark10_NearestZoneFallback();
+    void benchmark11_NextFreeZoneSearch();
+    void benchmark12_BatchAllocation();
+    void benchmark13_MinCostBatchAssignment();
+    void benchmark14_AllocationPolicies();
+    void benchmark15_SlotClassPools();
+    void benchmark16_AllocationExpiry();
+    
+    // Helpers
+    double elapsedSeconds(long long startNanos) const;
+    long long nowNanos() const;
+    void rearmRequests(ParkingRequest** requests, int count) const; // Back to REQUESTED, untimed
+    void printBenchmarkResult(const string& name, long long operations, double seconds);
+};
+
+#endif
@@ -0,0 +1,107 @@
+#include "CapacityTree.h"
+using namespace std;
+
+CapacityTree::CapacityTree(int initialCapacity) : size(0) {
+    capacity = 16;
+    while (capacity < initialCapacity) {
+        capacity *= 2;
+    }
+    tree = new atomic<int>[capacity + 1];
+    for (int i = 0; i <= capacity; i++) {
+        tree[i].store(0, memory_order_relaxed);
+    }
+}
+
+CapacityTree::~CapacityTree() {
+    delete[] tree;
+}
+
+void CapacityTree::grow() {
+    // Nodes 1..capacity keep their ranges when the tree doubles. Of the new
+    // nodes only the top one reaches back into the old half, and it covers
+    // all of it.
+    int newCapacity = capacity * 2;
+    atomic<int>* newTree = new atomic<int>[newCapacity + 1];
+    for (int i = 0; i <= newCapacity; i++) {
+        int value = (i <= capacity) ? tree[i].load(memory_order_relaxed) : 0;
+        newTree[i].store(value, memory_order_relaxed);
+    }
+    newTree[newCapacity].store(prefixSum(capacity), memory_order_relaxed);
+    
+    delete[] tree;
+    tree = newTree;
+    capacity = newCapacity;
+}
+
+void CapacityTree::append(int freeSlots) {
+    if (size == capacity) {
+        grow();
+    }
+    size++;
+    add(size - 1, freeSlots);
+}
+
+void CapacityTree::add(int index, int delta) {
+    if (index < 0 || index >= size || delta == 0) {
+        return;
+    }
+    for (int i = index + 1; i <= capacity; i += i & -i) {
+        tree[i].fetch_add(delta, memory_order_relaxed);
+    }
+}
+
+int CapacityTree::prefixSum(int count) const {
+    int sum = 0;
+    for (int i = count; i > 0; i -= i & -i) {
+        sum += tree[i].load(memory_order_relaxed);
+    }
+    return sum;
+}
+
+int CapacityTree::rangeSum(int first, int last) const {
+    if (first < 0) first = 0;
+    if (last > size) last = size;
+    if (first >= last) {
+        return 0;
+    }
+    return prefixSum(last) - prefixSum(first);
+}
+
+int CapacityTree::lowerBound(int target) const {
+    // Descend from the top node, skipping every block whose running total
+    // stays at or below the target
+    int position = 0;
+    for (int step = capacity; step > 0; step /= 2) {
+        int next = position + step;
+        if (next <= capacity) {
+            int value = tree[next].load(memory_order_relaxed);
+            if (value <= target) {
+                position = next;
+                target -= value;
+            }
+        }
+    }
+    return position; // Zero-based index of the zone that crosses the target
+}
+
+int CapacityTree::findFirstWithCapacity(int fromIndex) const {
+    if (size == 0) {
+        return -1;
+    }
+    if (fromIndex < 0 || fromIndex >= size) {
+        fromIndex = 0;
+    }
+    
+    int index = lowerBound(prefixSum(fromIndex));
+    if (index < size) {
+        return index;
+    }
+    
+    // Nothing at or after fromIndex; wrap to the front
+    index = lowerBound(0);
+    return (index < fromIndex) ? index : -1;
+}
+
+int CapacityTree::getSize() const {
+    return size;
+}
\ No newline at end of file
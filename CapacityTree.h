@@ -0,0 +1,42 @@
+#ifndef CAPACITYTREE_H
+#define CAPACITYTREE_H
+
+#include <atomic>
+using namespace std;
+
+// Fenwick (binary indexed) tree of free-slot counts by zone index.
+// Updates touch O(log n) nodes with atomic adds, so allocators in different
+// zones never wait for each other. Queries read the nodes without locking:
+// while transitions are in flight they are a hint, exact once they settle,
+// like the other capacity counters. Appending a zone is amortized O(log n)
+// and must not race with updates or queries.
+class CapacityTree {
+private:
+    atomic<int>* tree; // 1-based Fenwick nodes over [1, capacity]
+    int size;          // Zones covered
+    int capacity;      // Always a power of two
+    
+public:
+    CapacityTree(int initialCapacity = 16);
+    ~CapacityTree();
+    
+    // Maintenance, O(log n)
+    void append(int freeSlots); // Covers one more zone, at index size
+    void add(int index, int delta);
+    
+    // Queries, O(log n)
+    int rangeSum(int first, int last) const; // Free slots in zones [first, last)
+    int findFirstWithCapacity(int fromIndex) const; // At or after fromIndex, wrapping; -1 if none
+    int getSize() const;
+    
+private:
+    int prefixSum(int count) const; // Free slots in zones [0, count)
+    int lowerBound(int target) const; // First index whose prefix sum exceeds target
+    void grow();
+    
+    // Non-copyable: owns its node array
+    CapacityTree(const CapacityTree&);
+    CapacityTree& operator=(const CapacityTree&);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "ConcurrentRequestQueue.h"
+using namespace std;
+
+ConcurrentRequestQueue::ConcurrentRequestQueue(int requestedCapacity)
+    : enqueuePos(0), dequeuePos(0) {
+    capacity = 2;
+    while (capacity < (size_t)requestedCapacity) {
+        capacity *= 2;
+    }
+    mask = capacity - 1;
+    
+    buffer = new Cell[capacity];
+    for (size_t i = 0; i < capacity; i++) {
+        buffer[i].sequence.store(i, memory_order_relaxed);
+        buffer[i].request = nullptr;
+    }
+}
+
+ConcurrentRequestQueue::~ConcurrentRequestQueue() {
+    // Note: We don't delete request objects as they're managed elsewhere
+    delete[] buffer;
+}
+
+bool ConcurrentRequestQueue::enqueue(ParkingRequest* request) {
+    size_t pos = enqueuePos.load(memory_order_relaxed);
+    
+    while (true) {
+        Cell& cell = buffer[pos & mask];
+        size_t seq = cell.sequence.load(memory_order_acquire);
+        long long diff = (long long)seq - (long long)pos;
+        
+        if (diff == 0) {
+            // Cell is free for this position; claim the position
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                cell.request = request;
+                cell.sequence.store(pos + 1, memory_order_release);
+                return true;
+            }
+            // CAS failure reloaded pos; retry
+        } else if (diff < 0) {
+            // Cell still holds an entry from one lap ago: queue is full
+            return false;
+        } else {
+            // Another producer took this position; catch up
+            pos = enqueuePos.load(memory_order_relaxed);
+        }
+    }
+}
+
+ParkingRequest* ConcurrentRequestQueue::dequeue() {
+    size_t pos = dequeuePos.load(memory_order_relaxed);
+    
+    while (true) {
+        Cell& cell = buffer[pos & mask];
+        size_t seq = cell.sequence.load(memory_order_acquire);
+        long long diff = (long long)seq - (long long)(pos + 1);
+        
+        if (diff == 0) {
+            // Cell has been published for this position; claim it
+            if (dequeuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                ParkingRequest* request = cell.request;
+                // Hand the cell back to producers for the next lap
+                cell.sequence.store(pos + capacity, memory_order_release);
+                return request;
+            }
+        } else if (diff < 0) {
+            // Nothing published here yet: queue is empty
+            return nullptr;
+        } else {
+            // Another consumer took this position; catch up
+            pos = dequeuePos.load(memory_order_relaxed);
+        }
+    }
+}
+
+bool ConcurrentRequestQueue::isEmpty() const {
+    return getSize() == 0;
+}
+
+ParkingRequest* ConcurrentRequestQueue::peekAt(int offset) const {
+    while (true) {
+        size_t head = dequeuePos.load(memory_order_acquire);
+        size_t pos = head + offset;
+        const Cell& cell = buffer[pos & mask];
+        
+        // Published for this position and not yet consumed
+        if (cell.sequence.load(memory_order_acquire) == pos + 1) {
+            return cell.request;
+        }
+        // Only report empty if no consumer moved the head under us
+        if (dequeuePos.load(memory_order_acquire) == head) {
+            return nullptr;
+        }
+    }
+}
+
+int ConcurrentRequestQueue::getSize() const {
+    size_t tail = enqueuePos.load(memory_order_acquire);
+    size_t head = dequeuePos.load(memory_order_acquire);
+    return (tail > head) ? (int)(tail - head) : 0;
+}
+
+int ConcurrentRequestQueue::getCapacity() const {
+    return (int)capacity;
+}
\ No newline at end of file
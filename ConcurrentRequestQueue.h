@@ -0,0 +1,51 @@
+#ifndef CONCURRENTREQUESTQUEUE_H
+#define CONCURRENTREQUESTQUEUE_H
+
+#include "ParkingRequest.h"
+#include <atomic>
+#include <cstddef>
+using namespace std;
+
+// Lock-free bounded multi-producer/multi-consumer variant of RequestQueue.
+// Each cell carries a sequence number telling producers and consumers whose
+// turn it is, so threads only contend on a single CAS of the enqueue or
+// dequeue position (Vyukov's bounded MPMC design). Capacity is fixed and
+// rounded up to a power of two; enqueue fails instead of blocking when full.
+class ConcurrentRequestQueue {
+private:
+    struct Cell {
+        atomic<size_t> sequence;
+        ParkingRequest* request;
+    };
+    
+    static const size_t CACHE_LINE = 64;
+    
+    Cell* buffer;
+    size_t capacity;
+    size_t mask;
+    
+    // Kept on separate cache lines so producers and consumers don't share one
+    alignas(CACHE_LINE) atomic<size_t> enqueuePos;
+    alignas(CACHE_LINE) atomic<size_t> dequeuePos;
+    
+public:
+    ConcurrentRequestQueue(int capacity = 1024);
+    ~ConcurrentRequestQueue();
+    
+    // Safe to call from any number of threads
+    bool enqueue(ParkingRequest* request); // Returns false when full
+    ParkingRequest* dequeue();             // Returns nullptr when empty
+    
+    // Snapshots; may be stale by the time the caller looks at them
+    bool isEmpty() const;
+    ParkingRequest* peekAt(int offset) const; // Only exact while no other thread uses the queue
+    int getSize() const;
+    int getCapacity() const;
+    
+private:
+    // Non-copyable: owns its buffer
+    ConcurrentRequestQueue(const ConcurrentRequestQueue&);
+    ConcurrentRequestQueue& operator=(const ConcurrentRequestQueue&);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include "DurationStats.h"
+#include <cmath>
+using namespace std;
+
+DurationStats::DurationStats() {
+    reset();
+}
+
+void DurationStats::reset() {
+    count = 0;
+    mean = 0.0;
+    m2 = 0.0;
+    minValue = 0.0;
+    maxValue = 0.0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        buckets[i] = 0;
+    }
+}
+
+int DurationStats::bucketFor(double seconds) {
+    // Bucket 0 holds everything under one second
+    if (seconds < 1.0) {
+        return 0;
+    }
+    int bucket = 1 + (int)(log2(seconds) * SUB_BUCKETS);
+    return (bucket < BUCKET_COUNT) ? bucket : BUCKET_COUNT - 1;
+}
+
+double DurationStats::bucketLowerBound(int bucket) {
+    if (bucket == 0) {
+        return 0.0;
+    }
+    return exp2((double)(bucket - 1) / SUB_BUCKETS);
+}
+
+void DurationStats::add(double minutes) {
+    if (minutes < 0.0) {
+        minutes = 0.0;
+    }
+    
+    count++;
+    double delta = minutes - mean;
+    mean += delta / count;
+    m2 += delta * (minutes - mean);
+    
+    if (count == 1 || minutes < minValue) minValue = minutes;
+    if (count == 1 || minutes > maxValue) maxValue = minutes;
+    
+    buckets[bucketFor(minutes * 60.0)]++;
+}
+
+long long DurationStats::getCount() const {
+    return count;
+}
+
+double DurationStats::getMean() const {
+    return mean;
+}
+
+double DurationStats::getVariance() const {
+    return (count > 1) ? m2 / (count - 1) : 0.0;
+}
+
+double DurationStats::getStdDev() const {
+    return sqrt(getVariance());
+}
+
+double DurationStats::getMin() const {
+    return minValue;
+}
+
+double DurationStats::getMax() const {
+    return maxValue;
+}
+
+double DurationStats::getPercentile(double p) const {
+    if (count == 0) {
+        return 0.0;
+    }
+    
+    // Rank of the requested sample, 1-based
+    long long rank = (long long)ceil(p / 100.0 * count);
+    if (rank < 1) rank = 1;
+    if (rank > count) rank = count;
+    
+    long long seen = 0;
+    for (int b = 0; b < BUCKET_COUNT; b++) {
+        seen += buckets[b];
+        if (seen >= rank) {
+            // Geometric midpoint of the bucket, clamped to observed range
+            double lower = bucketLowerBound(b);
+            double upper = bucketLowerBound(b + 1);
+            double estimate = (b == 0) ? 0.0 : sqrt(lower * upper) / 60.0;
+            if (estimate < minValue) estimate = minValue;
+            if (estimate > maxValue) estimate = maxValue;
+            return estimate;
+        }
+    }
+    return maxValue;
+}
\ No newline at end of file
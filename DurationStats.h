@@ -0,0 +1,41 @@
+#ifndef DURATIONSTATS_H
+#define DURATIONSTATS_H
+
+// Online statistics over parking durations (in minutes).
+// Mean and variance use Welford's running update; percentiles come from a
+// fixed-size log-scale histogram (8 buckets per doubling, ~9% relative
+// error), so memory and query cost never grow with the number of samples.
+class DurationStats {
+private:
+    static const int SUB_BUCKETS = 8;   // Buckets per power of two
+    static const int OCTAVES = 24;      // Covers 1 second .. ~194 days
+    static const int BUCKET_COUNT = 1 + SUB_BUCKETS * OCTAVES + 1;
+    
+    long long count;
+    double mean;
+    double m2;        // Sum of squared deviations from the mean
+    double minValue;
+    double maxValue;
+    long long buckets[BUCKET_COUNT];
+    
+public:
+    DurationStats();
+    
+    void add(double minutes);
+    void reset();
+    
+    // Getters
+    long long getCount() const;
+    double getMean() const;
+    double getVariance() const; // Sample variance
+    double getStdDev() const;
+    double getMin() const;
+    double getMax() const;
+    double getPercentile(double p) const; // p in [0, 100]
+    
+private:
+    static int bucketFor(double seconds);
+    static double bucketLowerBound(int bucket); // In seconds
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,173 @@
+#ifndef HASHINDEX_H
+#define HASHINDEX_H
+
+#include <string>
+#include <cstdint>
+using namespace std;
+
+// Open-addressing hash index from string keys to values.
+// Linear probing over a power-of-two table; removals leave tombstones that
+// are reclaimed on the next rehash. Header-only because it is a template.
+template <typename V>
+class HashIndex {
+private:
+    enum class SlotState : unsigned char {
+        EMPTY,
+        FULL,
+        DELETED
+    };
+    
+    struct Entry {
+        string key;
+        V value;
+        uint64_t hash;
+        SlotState state;
+        
+        Entry() : value(), hash(0), state(SlotState::EMPTY) {}
+    };
+    
+    Entry* table;
+    int capacity;  // Always a power of two
+    int entryCount;
+    int usedCount; // FULL + DELETED, drives rehashing
+    
+public:
+    HashIndex(int initialCapacity = 16) : entryCount(0), usedCount(0) {
+        capacity = 16;
+        while (capacity < initialCapacity) {
+            capacity *= 2;
+        }
+        table = new Entry[capacity];
+    }
+    
+    ~HashIndex() {
+        delete[] table;
+    }
+    
+    // Returns false if the key is already present
+    bool insert(const string& key, const V& value) {
+        if ((usedCount + 1) * 10 > capacity * 7) {
+            rehash(entryCount * 2 >= capacity / 2 ? capacity * 2 : capacity);
+        }
+        
+        uint64_t h = hashKey(key);
+        int mask = capacity - 1;
+        int firstDeleted = -1;
+        
+        for (int i = (int)(h & mask); ; i = (i + 1) & mask) {
+            Entry& e = table[i];
+            if (e.state == SlotState::EMPTY) {
+                Entry& target = (firstDeleted >= 0) ? table[firstDeleted] : e;
+                if (firstDeleted < 0) {
+                    usedCount++;
+                }
+                target.key = key;
+                target.value = value;
+                target.hash = h;
+                target.state = SlotState::FULL;
+                entryCount++;
+                return true;
+            }
+            if (e.state == SlotState::DELETED) {
+                if (firstDeleted < 0) {
+                    firstDeleted = i;
+                }
+            } else if (e.hash == h && e.key == key) {
+                return false;
+            }
+        }
+    }
+    
+    // Returns a pointer to the stored value, or nullptr if absent
+    V* find(const string& key) {
+        int index = locate(key);
+        return (index >= 0) ? &table[index].value : nullptr;
+    }
+    
+    const V* find(const string& key) const {
+        int index = locate(key);
+        return (index >= 0) ? &table[index].value : nullptr;
+    }
+    
+    bool remove(const string& key) {
+        int index = locate(key);
+        if (index < 0) {
+            return false;
+        }
+        table[index].state = SlotState::DELETED;
+        table[index].key.clear();
+        table[index].value = V();
+        entryCount--;
+        return true;
+    }
+    
+    void clear() {
+        delete[] table;
+        capacity = 16;
+        table = new Entry[capacity];
+        entryCount = 0;
+        usedCount = 0;
+    }
+    
+    int size() const {
+        return entryCount;
+    }
+    
+private:
+    // Non-copyable: owns its table
+    HashIndex(const HashIndex&);
+    HashIndex& operator=(const HashIndex&);
+    
+    static uint64_t hashKey(const string& key) {
+        // FNV-1a, 64-bit
+        uint64_t h = 1469598103934665603ULL;
+        for (size_t i = 0; i < key.size(); i++) {
+            h ^= (unsigned char)key[i];
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+    
+    int locate(const string& key) const {
+        uint64_t h = hashKey(key);
+        int mask = capacity - 1;
+        
+        for (int i = (int)(h & mask); ; i = (i + 1) & mask) {
+            const Entry& e = table[i];
+            if (e.state == SlotState::EMPTY) {
+                return -1;
+            }
+            if (e.state == SlotState::FULL && e.hash == h && e.key == key) {
+                return i;
+            }
+        }
+    }
+    
+    void rehash(int newCapacity) {
+        Entry* oldTable = table;
+        int oldCapacity = capacity;
+        
+        capacity = newCapacity;
+        table = new Entry[capacity];
+        usedCount = entryCount;
+        int mask = capacity - 1;
+        
+        for (int i = 0; i < oldCapacity; i++) {
+            if (oldTable[i].state != SlotState::FULL) {
+                continue;
+            }
+            int j = (int)(oldTable[i].hash & mask);
+            while (table[j].state != SlotState::EMPTY) {
+                j = (j + 1) & mask;
+            }
+            table[j].key.swap(oldTable[i].key);
+            table[j].value = oldTable[i].value;
+            table[j].hash = oldTable[i].hash;
+            table[j].state = SlotState::FULL;
+        }
+        
+        delete[] oldTable;
+    }
+};
+
+#endif
\ No newline at end of file
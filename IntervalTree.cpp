@@ -0,0 +1,276 @@
+#include "IntervalTree.h"
+using namespace std;
+
+IntervalTree::IntervalTree() : root(nullptr), nodeCount(0) {}
+
+IntervalTree::~IntervalTree() {
+    clear();
+}
+
+int IntervalTree::heightOf(IntervalNode* node) {
+    return (node != nullptr) ? node->height : 0;
+}
+
+void IntervalTree::update(IntervalNode* node) {
+    int leftHeight = heightOf(node->left);
+    int rightHeight = heightOf(node->right);
+    node->height = 1 + (leftHeight > rightHeight ? leftHeight : rightHeight);
+    
+    node->maxEnd = node->end;
+    if (node->left != nullptr && node->left->maxEnd > node->maxEnd) {
+        node->maxEnd = node->left->maxEnd;
+    }
+    if (node->right != nullptr && node->right->maxEnd > node->maxEnd) {
+        node->maxEnd = node->right->maxEnd;
+    }
+}
+
+IntervalTree::IntervalNode* IntervalTree::rotateLeft(IntervalNode* node) {
+    IntervalNode* pivot = node->right;
+    node->right = pivot->left;
+    pivot->left = node;
+    update(node);
+    update(pivot);
+    return pivot;
+}
+
+IntervalTree::IntervalNode* IntervalTree::rotateRight(IntervalNode* node) {
+    IntervalNode* pivot = node->left;
+    node->left = pivot->right;
+    pivot->right = node;
+    update(node);
+    update(pivot);
+    return pivot;
+}
+
+IntervalTree::IntervalNode* IntervalTree::rebalance(IntervalNode* node) {
+    update(node);
+    int balance = heightOf(node->left) - heightOf(node->right);
+    
+    if (balance > 1) {
+        // Left-heavy; left-right case needs a first rotation
+        if (heightOf(node->left->left) < heightOf(node->left->right)) {
+            node->left = rotateLeft(node->left);
+        }
+        return rotateRight(node);
+    }
+    
+    if (balance < -1) {
+        // Right-heavy; right-left case needs a first rotation
+        if (heightOf(node->right->right) < heightOf(node->right->left)) {
+            node->right = rotateRight(node->right);
+        }
+        return rotateLeft(node);
+    }
+    
+    return node;
+}
+
+bool IntervalTree::less(time_t startA, int idA, time_t startB, int idB) {
+    return (startA < startB) || (startA == startB && idA < idB);
+}
+
+bool IntervalTree::insert(time_t start, time_t end, int id) {
+    if (end <= start) {
+        return false;
+    }
+    
+    // Walk down, remembering the path for the rebalancing pass
+    IntervalNode* path[MAX_DEPTH];
+    int depth = 0;
+    IntervalNode* current = root;
+    
+    while (current != nullptr) {
+        path[depth++] = current;
+        if (less(start, id, current->start, current->id)) {
+            current = current->left;
+        } else if (less(current->start, current->id, start, id)) {
+            current = current->right;
+        } else {
+            return false;
+        }
+    }
+    
+    IntervalNode* child = new IntervalNode(start, end, id);
+    nodeCount++;
+    if (depth == 0) {
+        root = child;
+        return true;
+    }
+    if (less(start, id, path[depth - 1]->start, path[depth - 1]->id)) {
+        path[depth - 1]->left = child;
+    } else {
+        path[depth - 1]->right = child;
+    }
+    
+    // Every ancestor's maxEnd may have grown, so the pass always reaches
+    // the root rather than stopping once the heights settle
+    for (int i = depth - 1; i >= 0; i--) {
+        IntervalNode* node = path[i];
+        IntervalNode* subtree = rebalance(node);
+        if (i == 0) {
+            root = subtree;
+        } else if (path[i - 1]->left == node) {
+            path[i - 1]->left = subtree;
+        } else {
+            path[i - 1]->right = subtree;
+        }
+    }
+    return true;
+}
+
+bool IntervalTree::remove(time_t start, int id) {
+    IntervalNode* path[MAX_DEPTH];
+    int depth = 0;
+    IntervalNode* current = root;
+    
+    while (current != nullptr) {
+        path[depth++] = current;
+        if (less(start, id, current->start, current->id)) {
+            current = current->left;
+        } else if (less(current->start, current->id, start, id)) {
+            current = current->right;
+        } else {
+            break;
+        }
+    }
+    if (current == nullptr) {
+        return false;
+    }
+    
+    // With two children, take over the successor's window and unlink the
+    // successor instead; it has no left child
+    IntervalNode* target = current;
+    if (current->left != nullptr && current->right != nullptr) {
+        target = current->right;
+        path[depth++] = target;
+        while (target->left != nullptr) {
+            target = target->left;
+            path[depth++] = target;
+        }
+        current->start = target->start;
+        current->end = target->end;
+        current->id = target->id;
+    }
+    
+    IntervalNode* child = (target->left != nullptr) ? target->left : target->right;
+    depth--; // Drop target from the path
+    if (depth == 0) {
+        root = child;
+    } else if (path[depth - 1]->left == target) {
+        path[depth - 1]->left = child;
+    } else {
+        path[depth - 1]->right = child;
+    }
+    delete target;
+    nodeCount--;
+    
+    for (int i = depth - 1; i >= 0; i--) {
+        IntervalNode* node = path[i];
+        IntervalNode* subtree = rebalance(node);
+        if (i == 0) {
+            root = subtree;
+        } else if (path[i - 1]->left == node) {
+            path[i - 1]->left = subtree;
+        } else {
+            path[i - 1]->right = subtree;
+        }
+    }
+    return true;
+}
+
+int IntervalTree::findOverlap(time_t start, time_t end) const {
+    IntervalNode* current = root;
+    
+    while (current != nullptr) {
+        if (current->start < end && start < current->end) {
+            return current->id;
+        }
+        // A left window that reaches past start is the only left candidate:
+        // if it starts too late, so does everything to the right
+        if (current->left != nullptr && current->left->maxEnd > start) {
+            current = current->left;
+        } else {
+            current = current->right;
+        }
+    }
+    return -1;
+}
+
+bool IntervalTree::isFree(time_t start, time_t end) const {
+    return findOverlap(start, end) == -1;
+}
+
+int IntervalTree::findCovering(time_t start, time_t end) const {
+    IntervalNode* current = root;
+    
+    while (current != nullptr) {
+        if (current->start > start) {
+            current = current->left;
+        } else if (current->left != nullptr && current->left->maxEnd >= end) {
+            // Everything on the left starts in time too, so maxEnd alone
+            // says the earliest answer is there
+            current = current->left;
+        } else if (current->end >= end) {
+            return current->id;
+        } else {
+            current = current->right;
+        }
+    }
+    return -1;
+}
+
+int IntervalTree::findLastBefore(time_t time) const {
+    int found = -1;
+    IntervalNode* current = root;
+    
+    while (current != nullptr) {
+        if (current->start < time) {
+            found = current->id;
+            current = current->right;
+        } else {
+            current = current->left;
+        }
+    }
+    return found;
+}
+
+int IntervalTree::findFirstFrom(time_t time) const {
+    int found = -1;
+    IntervalNode* current = root;
+    
+    while (current != nullptr) {
+        if (current->start >= time) {
+            found = current->id;
+            current = current->left;
+        } else {
+            current = current->right;
+        }
+    }
+    return found;
+}
+
+void IntervalTree::clear() {
+    // Rotate left children up until the root has none, then delete it
+    while (root != nullptr) {
+        if (root->left != nullptr) {
+            IntervalNode* pivot = root->left;
+            root->left = pivot->right;
+            pivot->right = root;
+            root = pivot;
+        } else {
+            IntervalNode* next = root->right;
+            delete root;
+            root = next;
+        }
+    }
+    nodeCount = 0;
+}
+
+int IntervalTree::getCount() const {
+    return nodeCount;
+}
+
+int IntervalTree::getHeight() const {
+    return heightOf(root);
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#ifndef INTERVALTREE_H
+#define INTERVALTREE_H
+
+#include <ctime>
+using namespace std;
+
+// Half-open time windows [start, end), each tagged with an integer id.
+// An AVL tree ordered by (start, id) where every node also records the
+// latest end in its subtree, so an overlap query only descends into a
+// subtree that can still reach the window: O(log n) for insert, remove
+// and overlap checks. Operations are iterative, like VehicleBST.
+class IntervalTree {
+private:
+    struct IntervalNode {
+        time_t start;
+        time_t end;
+        time_t maxEnd; // Latest end in this subtree
+        int id;
+        IntervalNode* left;
+        IntervalNode* right;
+        int height;
+        
+        IntervalNode(time_t start, time_t end, int id)
+            : start(start), end(end), maxEnd(end), id(id), left(nullptr), right(nullptr), height(1) {}
+    };
+    
+    // AVL height is below 1.45 * log2(n + 2), so 96 levels covers any count
+    static const int MAX_DEPTH = 96;
+    
+    IntervalNode* root;
+    int nodeCount;
+    
+    // Helper methods
+    static int heightOf(IntervalNode* node);
+    static void update(IntervalNode* node); // Height and maxEnd from the children
+    static IntervalNode* rotateLeft(IntervalNode* node);
+    static IntervalNode* rotateRight(IntervalNode* node);
+    static IntervalNode* rebalance(IntervalNode* node);
+    static bool less(time_t startA, int idA, time_t startB, int idB);
+    
+public:
+    IntervalTree();
+    ~IntervalTree();
+    
+    bool insert(time_t start, time_t end, int id); // False for an empty window or a duplicate
+    bool remove(time_t start, int id);             // False if not present
+    int findOverlap(time_t start, time_t end) const; // Id of a window meeting [start, end), or -1
+    bool isFree(time_t start, time_t end) const;
+    int findCovering(time_t start, time_t end) const; // Earliest-starting window containing [start, end), or -1
+    int findLastBefore(time_t time) const;           // Latest-starting window starting before time, or -1
+    int findFirstFrom(time_t time) const;            // Earliest-starting window starting at or after time, or -1
+    
+    void clear();
+    int getCount() const;
+    int getHeight() const;
+    
+private:
+    // Non-copyable: owns its nodes
+    IntervalTree(const IntervalTree&);
+    IntervalTree& operator=(const IntervalTree&);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include "MinCostFlow.h"
+#include <chrono>
+using namespace std;
+
+// Dijkstra frontier entry, ordered by reduced distance
+struct PathEntry {
+    long long distance;
+    int node;
+};
+
+static void pushEntry(PathEntry* heap, int& heapSize, PathEntry entry) {
+    int index = heapSize++;
+    while (index > 0 && heap[(index - 1) / 2].distance > entry.distance) {
+        heap[index] = heap[(index - 1) / 2];
+        index = (index - 1) / 2;
+    }
+    heap[index] = entry;
+}
+
+static PathEntry popEntry(PathEntry* heap, int& heapSize) {
+    PathEntry top = heap[0];
+    PathEntry last = heap[--heapSize];
+    int index = 0;
+    while (true) {
+        int child = 2 * index + 1;
+        if (child >= heapSize) {
+            break;
+        }
+        if (child + 1 < heapSize && heap[child + 1].distance < heap[child].distance) {
+            child++;
+        }
+        if (heap[child].distance >= last.distance) {
+            break;
+        }
+        heap[index] = heap[child];
+        index = child;
+    }
+    if (heapSize > 0) {
+        heap[index] = last;
+    }
+    return top;
+}
+
+MinCostFlow::MinCostFlow(int nodeCount, int expectedEdges)
+    : edgeCount(0), nodeCount(nodeCount) {
+    edgeCapacity = (expectedEdges > 0) ? 2 * expectedEdges : 2;
+    edges = new Edge[edgeCapacity];
+    firstEdge = new int[nodeCount];
+    for (int i = 0; i < nodeCount; i++) {
+        firstEdge[i] = -1;
+    }
+}
+
+MinCostFlow::~MinCostFlow() {
+    delete[] edges;
+    delete[] firstEdge;
+}
+
+int MinCostFlow::addEdge(int from, int to, int capacity, long long cost) {
+    if (edgeCount + 2 > edgeCapacity) {
+        int newCapacity = edgeCapacity * 2;
+        Edge* newEdges = new Edge[newCapacity];
+        for (int i = 0; i < edgeCount; i++) {
+            newEdges[i] = edges[i];
+        }
+        delete[] edges;
+        edges = newEdges;
+        edgeCapacity = newCapacity;
+    }
+    
+    int id = edgeCount;
+    edges[edgeCount] = {to, capacity, cost, firstEdge[from]};
+    firstEdge[from] = edgeCount++;
+    edges[edgeCount] = {from, 0, -cost, firstEdge[to]};
+    firstEdge[to] = edgeCount++;
+    return id;
+}
+
+int MinCostFlow::getFlow(int edge) const {
+    // The reverse edge's residual is what has been pushed forward
+    return edges[edge ^ 1].capacity;
+}
+
+int MinCostFlow::solve(int source, int sink, long long budgetNanos, long long& totalCost, bool& budgetExceeded) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    totalCost = 0;
+    budgetExceeded = false;
+    int totalFlow = 0;
+    
+    long long* potential = new long long[nodeCount];
+    long long* distance = new long long[nodeCount];
+    int* viaEdge = new int[nodeCount];
+    PathEntry* heap = new PathEntry[edgeCount + 1];
+    for (int i = 0; i < nodeCount; i++) {
+        potential[i] = 0; // Costs start non-negative
+    }
+    
+    while (true) {
+        if (budgetNanos > 0 && chrono::duration_cast<chrono::nanoseconds>(
+                chrono::steady_clock::now() - start).count() > budgetNanos) {
+            budgetExceeded = true;
+            break;
+        }
+        
+        for (int i = 0; i < nodeCount; i++) {
+            distance[i] = -1;
+            viaEdge[i] = -1;
+        }
+        int heapSize = 0;
+        distance[source] = 0;
+        pushEntry(heap, heapSize, {0, source});
+        
+        while (heapSize > 0) {
+            PathEntry top = popEntry(heap, heapSize);
+            if (top.distance != distance[top.node]) {
+                continue; // Stale entry
+            }
+            for (int e = firstEdge[top.node]; e != -1; e = edges[e].next) {
+                if (edges[e].capacity == 0) {
+                    continue;
+                }
+                int to = edges[e].to;
+                long long reduced = edges[e].cost + potential[top.node] - potential[to];
+                long long candidate = top.distance + reduced;
+                if (distance[to] == -1 || candidate < distance[to]) {
+                    distance[to] = candidate;
+                    viaEdge[to] = e;
+                    pushEntry(heap, heapSize, {candidate, to});
+                }
+            }
+        }
+        
+        if (distance[sink] == -1) {
+            break; // No augmenting path left
+        }
+        
+        for (int i = 0; i < nodeCount; i++) {
+            if (distance[i] != -1) {
+                potential[i] += distance[i];
+            }
+        }
+        
+        // Push the bottleneck along the path
+        int pushed = -1;
+        for (int node = sink; node != source; node = edges[viaEdge[node] ^ 1].to) {
+            int residual = edges[viaEdge[node]].capacity;
+            if (pushed == -1 || residual < pushed) {
+                pushed = residual;
+            }
+        }
+        for (int node = sink; node != source; node = edges[viaEdge[node] ^ 1].to) {
+            edges[viaEdge[node]].capacity -= pushed;
+            edges[viaEdge[node] ^ 1].capacity += pushed;
+            totalCost += pushed * edges[viaEdge[node]].cost;
+        }
+        totalFlow += pushed;
+    }
+    
+    delete[] heap;
+    delete[] viaEdge;
+    delete[] distance;
+    delete[] potential;
+    return totalFlow;
+}
\ No newline at end of file
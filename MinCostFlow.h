@@ -0,0 +1,45 @@
+#ifndef MINCOSTFLOW_H
+#define MINCOSTFLOW_H
+
+using namespace std;
+
+// Min-cost flow by successive shortest paths.
+// Each round finds the cheapest augmenting path with Dijkstra over reduced
+// costs (Johnson potentials keep them non-negative) and pushes the path's
+// bottleneck, so after every round the routed flow is the cheapest way to
+// route that much. That makes a partial result useful: solving stops at
+// the deadline with a valid, optimal-for-its-size flow.
+// Edge costs must be non-negative.
+class MinCostFlow {
+private:
+    struct Edge {
+        int to;
+        int capacity; // Residual
+        long long cost;
+        int next;     // Next edge out of the same node, -1 at the end
+    };
+    
+    Edge* edges;  // Edge e and its reverse e ^ 1 are stored side by side
+    int edgeCount;
+    int edgeCapacity;
+    int* firstEdge; // Per node
+    int nodeCount;
+    
+public:
+    MinCostFlow(int nodeCount, int expectedEdges = 64);
+    ~MinCostFlow();
+    
+    int addEdge(int from, int to, int capacity, long long cost); // Returns the edge id
+    int getFlow(int edge) const;
+    
+    // Returns the flow routed; totalCost receives its cost. Stops early,
+    // with budgetExceeded set, once budgetNanos have passed (<= 0: no limit).
+    int solve(int source, int sink, long long budgetNanos, long long& totalCost, bool& budgetExceeded);
+    
+private:
+    // Non-copyable: owns its edge arrays
+    MinCostFlow(const MinCostFlow&);
+    MinCostFlow& operator=(const MinCostFlow&);
+};
+
+#endif
\ No newline at end of file
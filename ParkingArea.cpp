@@ -1,16 +1,39 @@
 #include "ParkingArea.h"
+#include "Zone.h"
+#include "SymbolTable.h"
 #include <iostream>
 using namespace std;
 
-ParkingArea::ParkingArea() : maxSlots(0), currentSlots(0), slots(nullptr) {}
+ParkingArea::ParkingArea() 
+    : slots(nullptr), maxSlots(0), currentSlots(0), store(nullptr), ownsStore(false),
+      baseIndex(0), availableSlots(0), nextSlot(0), parentZone(nullptr) {
+    resetClassCounters();
+}
 
 ParkingArea::ParkingArea(const string& areaId, const string& zoneId, int maxSlots)
-    : areaId(areaId), zoneId(zoneId), maxSlots(maxSlots), currentSlots(0) {
+    : areaId(areaId), zoneId(zoneId), maxSlots(maxSlots), currentSlots(0),
+      ownsStore(true), availableSlots(0), nextSlot(0), parentZone(nullptr) {
+    slots = new ParkingSlot[maxSlots];
+    resetClassCounters();
+    
+    // Standalone area: keep a private store holding just this block
+    store = new SlotStore(zoneId);
+    baseIndex = store->reserveBlock(maxSlots, 0);
+}
+
+ParkingArea::ParkingArea(const string& areaId, SlotStore* sharedStore, int baseIndex, int maxSlots)
+    : areaId(areaId), maxSlots(maxSlots), currentSlots(0), store(sharedStore),
+      ownsStore(false), baseIndex(baseIndex), availableSlots(0), nextSlot(0), parentZone(nullptr) {
     slots = new ParkingSlot[maxSlots];
+    resetClassCounters();
+    zoneId = SymbolTable::zones().nameOf(store->getZoneHandle());
 }
 
 ParkingArea::~ParkingArea() {
     delete[] slots;
+    if (ownsStore) {
+        delete store;
+    }
 }
 
 string ParkingArea::getAreaId() const {
@@ -29,33 +52,95 @@ int ParkingArea::getCurrentSlots() const {
     return currentSlots;
 }
 
-bool ParkingArea::addSlot(const string& slotId) {
+SlotStore* ParkingArea::getStore() const {
+    return store;
+}
+
+Zone* ParkingArea::getParentZone() const {
+    return parentZone;
+}
+
+int ParkingArea::getBaseIndex() const {
+    return baseIndex;
+}
+
+bool ParkingArea::addSlot(const string& slotId, SlotClass slotClass) {
     if (currentSlots >= maxSlots) {
         cout << "Error: Cannot add more slots. Area is full!" << endl;
         return false;
     }
     
-    slots[currentSlots] = ParkingSlot(slotId, zoneId);
+    store->initSlot(baseIndex + currentSlots, slotId, slotClass);
+    slots[currentSlots] = ParkingSlot(this, currentSlots);
     currentSlots++;
+    availableSlots++;
+    availableByClass[(int)slotClass]++;
+    slotsByClass[(int)slotClass]++;
+    
+    if (parentZone != nullptr) {
+        parentZone->onSlotAdded(slotClass);
+    }
     return true;
 }
 
 ParkingSlot* ParkingArea::findSlot(const string& slotId) {
+    // Compare interned handles instead of strings
+    int handle = SymbolTable::slots().find(slotId);
+    if (handle == SymbolTable::NONE) {
+        return nullptr;
+    }
+    
     for (int i = 0; i < currentSlots; i++) {
-        if (slots[i].getSlotId() == slotId) {
+        if (store->getSlotName(baseIndex + i) == handle) {
             return &slots[i];
         }
     }
     return nullptr;
 }
 
+ParkingSlot* ParkingArea::getSlotAt(int index) {
+    if (index < 0 || index >= currentSlots) {
+        return nullptr;
+    }
+    return &slots[index];
+}
+
 ParkingSlot* ParkingArea::getFirstAvailableSlot() {
-    for (int i = 0; i < currentSlots; i++) {
-        if (slots[i].getAvailability()) {
-            return &slots[i];
-        }
+    // Find-first-set over this area's words of the store's free bits
+    int index = store->findFirstFree(baseIndex, baseIndex + currentSlots);
+    if (index < 0) {
+        return nullptr;
     }
-    return nullptr;
+    return &slots[index - baseIndex];
+}
+
+ParkingSlot* ParkingArea::claimFirstAvailableSlot(int slotClass) {
+    int index = store->claimFirstFree(baseIndex, baseIndex + currentSlots, slotClass);
+    if (index < 0) {
+        return nullptr;
+    }
+    onSlotClaimed(store->getSlotClass(index));
+    return &slots[index - baseIndex];
+}
+
+ParkingSlot* ParkingArea::claimNextAvailableSlot(int slotClass) {
+    // Resume after the previous claim and wrap, so use spreads over the
+    // whole area instead of always reusing its lowest free slots. The
+    // cursor is only a starting hint; racing claimers may both move it.
+    int start = nextSlot.load(memory_order_relaxed);
+    if (start >= currentSlots) {
+        start = 0;
+    }
+    int index = store->claimFirstFree(baseIndex + start, baseIndex + currentSlots, slotClass);
+    if (index < 0) {
+        index = store->claimFirstFree(baseIndex, baseIndex + start, slotClass);
+    }
+    if (index < 0) {
+        return nullptr;
+    }
+    nextSlot.store(index - baseIndex + 1, memory_order_relaxed);
+    onSlotClaimed(store->getSlotClass(index));
+    return &slots[index - baseIndex];
 }
 
 void ParkingArea::displayAllSlots() const {
@@ -74,11 +159,85 @@ void ParkingArea::displayAllSlots() const {
 }
 
 int ParkingArea::countAvailableSlots() const {
-    int count = 0;
+    return availableSlots;
+}
+
+int ParkingArea::countAvailableSlots(SlotClass slotClass) const {
+    return availableByClass[(int)slotClass];
+}
+
+int ParkingArea::countSlots(SlotClass slotClass) const {
+    return slotsByClass[(int)slotClass];
+}
+
+bool ParkingArea::verifyCounters() const {
+    int slotCount = 0;
     for (int i = 0; i < currentSlots; i++) {
         if (slots[i].getAvailability()) {
-            count++;
+            slotCount++;
+        }
+    }
+    
+    // Popcount over the whole block also catches stray bits past currentSlots
+    int bitmapCount = store->countFree(baseIndex, baseIndex + ((maxSlots + 63) / 64) * 64);
+    
+    if (slotCount != availableSlots || bitmapCount != availableSlots) {
+        cout << "Counter mismatch in area " << areaId << ": counter=" << availableSlots
+             << ", bitmap=" << bitmapCount << ", recount=" << slotCount << endl;
+        return false;
+    }
+    
+    int blockEnd = baseIndex + ((maxSlots + 63) / 64) * 64;
+    for (int c = 0; c < SLOT_CLASS_COUNT; c++) {
+        int classCount = store->countFree(baseIndex, blockEnd, c);
+        if (classCount != availableByClass[c]) {
+            cout << "Counter mismatch in area " << areaId << " for " << slotClassName((SlotClass)c)
+                 << " slots: counter=" << availableByClass[c] << ", bitmap=" << classCount << endl;
+            return false;
         }
     }
-    return count;
-}
\ No newline at end of file
+    return true;
+}
+
+bool ParkingArea::setSlotAvailability(int index, bool available) {
+    // The store flips the bit atomically; only the caller that actually
+    // changed it adjusts the counters
+    if (!store->setFree(baseIndex + index, available)) {
+        return false;
+    }
+    
+    SlotClass slotClass = store->getSlotClass(baseIndex + index);
+    if (!available) {
+        onSlotClaimed(slotClass);
+        return true;
+    }
+    availableSlots++;
+    availableByClass[(int)slotClass]++;
+    if (parentZone != nullptr) {
+        parentZone->onAvailabilityChanged(1, slotClass);
+    }
+    return true;
+}
+
+void ParkingArea::onSlotClaimed(SlotClass slotClass) {
+    onSlotsClaimed(slotClass, 1);
+}
+
+void ParkingArea::onSlotsClaimed(SlotClass slotClass, int count) {
+    availableSlots -= count;
+    availableByClass[(int)slotClass] -= count;
+    if (parentZone != nullptr) {
+        parentZone->onAvailabilityChanged(-count, slotClass);
+    }
+}
+
+void ParkingArea::resetClassCounters() {
+    for (int c = 0; c < SLOT_CLASS_COUNT; c++) {
+        availableByClass[c] = 0;
+        slotsByClass[c] = 0;
+    }
+}
+
+void ParkingArea::attachToZone(Zone* zone) {
+    parentZone = zone;
+}
@@ -2,20 +2,39 @@
 #define PARKINGAREA_H
 
 #include <string>
+#include <atomic>
 #include "ParkingSlot.h"
+#include "SlotStore.h"
 using namespace std;
 
+// Forward declaration
+class Zone;
+
 class ParkingArea {
 private:
     string areaId;
     string zoneId;
-    ParkingSlot* slots; // Array of parking slots
+    ParkingSlot* slots; // Array of slot views
     int maxSlots;
     int currentSlots;
     
+    // Slot state lives in a block of the zone's SlotStore starting at baseIndex.
+    // Its free bits double as this area's free-slot bitmap.
+    SlotStore* store;
+    bool ownsStore; // True for standalone areas created without a zone
+    int baseIndex;
+    
+    // Maintained on every slot transition so availability queries are O(1)
+    atomic<int> availableSlots;
+    atomic<int> availableByClass[SLOT_CLASS_COUNT];
+    int slotsByClass[SLOT_CLASS_COUNT];
+    atomic<int> nextSlot; // Where claimNextAvailableSlot starts looking
+    Zone* parentZone; // Zone whose counters aggregate this area
+    
 public:
     ParkingArea();
     ParkingArea(const string& areaId, const string& zoneId, int maxSlots);
+    ParkingArea(const string& areaId, SlotStore* sharedStore, int baseIndex, int maxSlots);
     ~ParkingArea();
     
     // Getters
@@ -23,15 +42,35 @@ public:
     string getZoneId() const;
     int getMaxSlots() const;
     int getCurrentSlots() const;
+    SlotStore* getStore() const;
+    int getBaseIndex() const;
+    Zone* getParentZone() const; // Null for a standalone area
     
     // Slot management
-    bool addSlot(const string& slotId);
+    bool addSlot(const string& slotId, SlotClass slotClass = SlotClass::LARGE);
     ParkingSlot* findSlot(const string& slotId);
+    ParkingSlot* getSlotAt(int index);
     ParkingSlot* getFirstAvailableSlot();
+    // Lock-free; slot comes back already taken. slotClass limits the claim
+    // to one class (SlotStore::ANY_CLASS: any slot).
+    ParkingSlot* claimFirstAvailableSlot(int slotClass = SlotStore::ANY_CLASS);
+    ParkingSlot* claimNextAvailableSlot(int slotClass = SlotStore::ANY_CLASS); // Round-robin from the last claim
     void displayAllSlots() const;
     
     // Statistics
     int countAvailableSlots() const;
+    int countAvailableSlots(SlotClass slotClass) const;
+    int countSlots(SlotClass slotClass) const;
+    bool verifyCounters() const; // Full recount, for consistency checks
+    
+private:
+    friend class ParkingSlot;
+    friend class Zone;
+    bool setSlotAvailability(int index, bool available); // False if another caller got there first
+    void onSlotClaimed(SlotClass slotClass);
+    void onSlotsClaimed(SlotClass slotClass, int count); // One counter update for a batch
+    void attachToZone(Zone* zone);
+    void resetClassCounters();
 };
 
 #endif
\ No newline at end of file
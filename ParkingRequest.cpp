@@ -5,18 +5,19 @@
 using namespace std;
 
 ParkingRequest::ParkingRequest() 
-    : vehicle(nullptr), allocatedSlot(nullptr), crossZoneAllocation(false),
-      requestTime(0), allocationTime(0), releaseTime(0),
-      currentState(RequestState::REQUESTED) {}
+    : vehicle(nullptr), requestTime(0), allocationTime(0), releaseTime(0),
+      currentState(RequestState::REQUESTED), allocatedSlot(nullptr), crossZoneAllocation(false),
+      stateListener(nullptr), intakeSequence(0), priorityClass(PriorityClass::STANDARD),
+      schedulerPosition(-1), waitlisted(false), waitSequence(0),
+      waitPrev(nullptr), waitNext(nullptr), expiryTimer(-1) {}
 
 ParkingRequest::ParkingRequest(const string& requestId, Vehicle* vehicle, const string& zoneId)
     : requestId(requestId), vehicle(vehicle), requestedZoneId(zoneId),
-      allocatedSlot(nullptr), crossZoneAllocation(false),
-      currentState(RequestState::REQUESTED) {
-    requestTime = time(0);
-    allocationTime = 0;
-    releaseTime = 0;
-}
+      requestTime(time(0)), allocationTime(0), releaseTime(0),
+      currentState(RequestState::REQUESTED), allocatedSlot(nullptr), crossZoneAllocation(false),
+      stateListener(nullptr), intakeSequence(0), priorityClass(PriorityClass::STANDARD),
+      schedulerPosition(-1), waitlisted(false), waitSequence(0),
+      waitPrev(nullptr), waitNext(nullptr), expiryTimer(-1) {}
 
 string ParkingRequest::getRequestId() const {
     return requestId;
@@ -54,6 +55,83 @@ bool ParkingRequest::isCrossZoneAllocation() const {
     return crossZoneAllocation;
 }
 
+unsigned long long ParkingRequest::getIntakeSequence() const {
+    return intakeSequence;
+}
+
+PriorityClass ParkingRequest::getPriorityClass() const {
+    return priorityClass;
+}
+
+int ParkingRequest::getSchedulerPosition() const {
+    return schedulerPosition;
+}
+
+bool ParkingRequest::isWaitlisted() const {
+    return waitlisted;
+}
+
+unsigned long long ParkingRequest::getWaitSequence() const {
+    return waitSequence;
+}
+
+ParkingRequest* ParkingRequest::getWaitPrev() const {
+    return waitPrev;
+}
+
+ParkingRequest* ParkingRequest::getWaitNext() const {
+    return waitNext;
+}
+
+int ParkingRequest::getExpiryTimer() const {
+    return expiryTimer;
+}
+
+SlotClass ParkingRequest::getSlotClass() const {
+    return (vehicle != nullptr) ? vehicle->getSlotClass() : SlotClass::STANDARD;
+}
+
+void ParkingRequest::setStateListener(RequestStateListener* listener) {
+    stateListener = listener;
+}
+
+void ParkingRequest::setIntakeSequence(unsigned long long sequence) {
+    intakeSequence = sequence;
+}
+
+void ParkingRequest::setPriorityClass(PriorityClass priority) {
+    priorityClass = priority;
+}
+
+void ParkingRequest::setSchedulerPosition(int position) {
+    schedulerPosition = position;
+}
+
+void ParkingRequest::setWaitlisted(bool waiting) {
+    waitlisted = waiting;
+}
+
+void ParkingRequest::setWaitSequence(unsigned long long sequence) {
+    waitSequence = sequence;
+}
+
+void ParkingRequest::setWaitLinks(ParkingRequest* prev, ParkingRequest* next) {
+    waitPrev = prev;
+    waitNext = next;
+}
+
+void ParkingRequest::setExpiryTimer(int node) {
+    expiryTimer = node;
+}
+
+void ParkingRequest::transitionTo(RequestState newState) {
+    RequestState previousState = currentState;
+    currentState = newState;
+    if (stateListener != nullptr) {
+        stateListener->onRequestStateChanged(this, previousState);
+    }
+}
+
 bool ParkingRequest::allocateSlot(ParkingSlot* slot, bool crossZone) {
     if (currentState != RequestState::REQUESTED) {
         cout << "Error: Cannot allocate slot. Request is not in REQUESTED state." << endl;
@@ -65,21 +143,38 @@ bool ParkingRequest::allocateSlot(ParkingSlot* slot, bool crossZone) {
         return false;
     }
     
-    if (!slot->getAvailability()) {
+    // Check and take in one step, so two allocators can't both win the slot
+    if (!slot->tryClaim()) {
         cout << "Error: Slot is not available." << endl;
         return false;
     }
     
+    assignSlot(slot, crossZone);
+    return true;
+}
+
+bool ParkingRequest::bindClaimedSlot(ParkingSlot* slot, bool crossZone) {
+    if (currentState != RequestState::REQUESTED) {
+        cout << "Error: Cannot allocate slot. Request is not in REQUESTED state." << endl;
+        return false;
+    }
+    
+    if (slot == nullptr) {
+        cout << "Error: Cannot allocate null slot." << endl;
+        return false;
+    }
+    
+    assignSlot(slot, crossZone);
+    return true;
+}
+
+void ParkingRequest::assignSlot(ParkingSlot* slot, bool crossZone) {
     allocatedSlot = slot;
     crossZoneAllocation = crossZone;
-    currentState = RequestState::ALLOCATED;
     allocationTime = time(0);
-    
-    // Mark slot as occupied
-    slot->setAvailability(false);
     slot->setVehicleId(vehicle->getVehicleId());
     
-    return true;
+    transitionTo(RequestState::ALLOCATED);
 }
 
 bool ParkingRequest::markAsOccupied() {
@@ -88,7 +183,7 @@ bool ParkingRequest::markAsOccupied() {
         return false;
     }
     
-    currentState = RequestState::OCCUPIED;
+    transitionTo(RequestState::OCCUPIED);
     return true;
 }
 
@@ -98,15 +193,16 @@ bool ParkingRequest::markAsReleased() {
         return false;
     }
     
-    currentState = RequestState::RELEASED;
     releaseTime = time(0);
     
-    // Free the slot
+    // Free the slot. The occupant is cleared first: once the bit is set,
+    // another thread may claim the slot and write its own occupant.
     if (allocatedSlot != nullptr) {
-        allocatedSlot->setAvailability(true);
         allocatedSlot->setVehicleId("");
+        allocatedSlot->setAvailability(true);
     }
     
+    transitionTo(RequestState::RELEASED);
     return true;
 }
 
@@ -118,11 +214,11 @@ bool ParkingRequest::cancelRequest() {
     
     // Free the slot if it was allocated
     if (allocatedSlot != nullptr && currentState == RequestState::ALLOCATED) {
+        allocatedSlot->setVehicleId(""); // Before the bit, as in markAsReleased
         allocatedSlot->setAvailability(true);
-        allocatedSlot->setVehicleId("");
     }
     
-    currentState = RequestState::CANCELLED;
+    transitionTo(RequestState::CANCELLED);
     return true;
 }
 
@@ -132,6 +228,7 @@ void ParkingRequest::displayRequestInfo() const {
     cout << "Vehicle ID: " << (vehicle ? vehicle->getVehicleId() : "None") << endl;
     cout << "Requested Zone: " << requestedZoneId << endl;
     cout << "Current State: " << stateToString() << endl;
+    cout << "Priority: " << priorityToString() << endl;
     cout << "Cross Zone Allocation: " << (crossZoneAllocation ? "Yes" : "No") << endl;
     
     if (allocatedSlot != nullptr) {
@@ -175,6 +272,15 @@ string ParkingRequest::stateToString() const {
     }
 }
 
+string ParkingRequest::priorityToString() const {
+    switch(priorityClass) {
+        case PriorityClass::STANDARD: return "STANDARD";
+        case PriorityClass::PERMIT: return "PERMIT";
+        case PriorityClass::ACCESSIBLE: return "ACCESSIBLE";
+        default: return "UNKNOWN";
+    }
+}
+
 double ParkingRequest::calculateDuration() const {
     if (currentState != RequestState::RELEASED || releaseTime == 0) {
         return 0.0;
@@ -16,6 +16,26 @@ enum class RequestState {
     CANCELLED
 };
 
+const int REQUEST_STATE_COUNT = 5;
+
+// Scheduling classes, lowest to highest priority
+enum class PriorityClass {
+    STANDARD,   // Walk-in
+    PERMIT,     // Permit holder
+    ACCESSIBLE  // Disabled driver
+};
+
+const int PRIORITY_CLASS_COUNT = 3;
+
+class ParkingRequest;
+
+// Observer notified after every request state transition
+class RequestStateListener {
+public:
+    virtual ~RequestStateListener() {}
+    virtual void onRequestStateChanged(ParkingRequest* request, RequestState previousState) = 0;
+};
+
 class ParkingRequest {
 private:
     string requestId;
@@ -27,6 +47,15 @@ private:
     RequestState currentState;
     ParkingSlot* allocatedSlot;
     bool crossZoneAllocation;
+    RequestStateListener* stateListener; // Owner tracking this request, may be null
+    unsigned long long intakeSequence;   // Arrival order across all zone queues
+    PriorityClass priorityClass;
+    int schedulerPosition;               // Heap index while queued in a RequestScheduler, else -1
+    bool waitlisted;                     // Waiting in a zone waitlist for a freed slot
+    unsigned long long waitSequence;     // Arrival order on the waitlist, across slot classes
+    ParkingRequest* waitPrev;            // Neighbours in a waitlist queue while waitlisted
+    ParkingRequest* waitNext;
+    int expiryTimer;                     // Node in a TimerWheel while a deadline is set, else -1
     
 public:
     ParkingRequest();
@@ -42,9 +71,27 @@ public:
     RequestState getCurrentState() const;
     ParkingSlot* getAllocatedSlot() const;
     bool isCrossZoneAllocation() const;
+    unsigned long long getIntakeSequence() const;
+    PriorityClass getPriorityClass() const;
+    int getSchedulerPosition() const;
+    bool isWaitlisted() const;
+    unsigned long long getWaitSequence() const;
+    ParkingRequest* getWaitPrev() const;
+    ParkingRequest* getWaitNext() const;
+    int getExpiryTimer() const;
+    SlotClass getSlotClass() const; // Smallest slot class the vehicle fits
     
     // State management
+    void setStateListener(RequestStateListener* listener);
+    void setIntakeSequence(unsigned long long sequence);
+    void setPriorityClass(PriorityClass priority);
+    void setSchedulerPosition(int position);
+    void setWaitlisted(bool waiting);
+    void setWaitSequence(unsigned long long sequence);
+    void setWaitLinks(ParkingRequest* prev, ParkingRequest* next);
+    void setExpiryTimer(int node);
     bool allocateSlot(ParkingSlot* slot, bool crossZone = false);
+    bool bindClaimedSlot(ParkingSlot* slot, bool crossZone); // Slot already taken by the caller
     bool markAsOccupied();
     bool markAsReleased();
     bool cancelRequest();
@@ -52,10 +99,15 @@ public:
     // Utility
     void displayRequestInfo() const;
     string stateToString() const;
+    string priorityToString() const;
     double calculateDuration() const; // in minutes
     
     // Check if request is active
     bool isActive() const;
+    
+private:
+    void transitionTo(RequestState newState);
+    void assignSlot(ParkingSlot* slot, bool crossZone);
 };
 
 #endif
\ No newline at end of file
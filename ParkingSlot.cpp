@@ -1,39 +1,61 @@
 #include "ParkingSlot.h"
+#include "ParkingArea.h"
+#include "SlotStore.h"
+#include "SymbolTable.h"
 #include <iostream>
 using namespace std;
 
-ParkingSlot::ParkingSlot() : isAvailable(true), vehicleId("") {}
+ParkingSlot::ParkingSlot() : parentArea(nullptr), slotIndex(-1) {}
 
-ParkingSlot::ParkingSlot(const string& slotId, const string& zoneId) 
-    : slotId(slotId), zoneId(zoneId), isAvailable(true), vehicleId("") {}
+ParkingSlot::ParkingSlot(ParkingArea* area, int index)
+    : parentArea(area), slotIndex(index) {}
 
 string ParkingSlot::getSlotId() const {
-    return slotId;
+    const SlotStore* store = parentArea->getStore();
+    return SymbolTable::slots().nameOf(store->getSlotName(parentArea->getBaseIndex() + slotIndex));
 }
 
 string ParkingSlot::getZoneId() const {
-    return zoneId;
+    return SymbolTable::zones().nameOf(parentArea->getStore()->getZoneHandle());
 }
 
 bool ParkingSlot::getAvailability() const {
-    return isAvailable;
+    return parentArea->getStore()->isFree(parentArea->getBaseIndex() + slotIndex);
 }
 
 string ParkingSlot::getVehicleId() const {
-    return vehicleId;
+    const SlotStore* store = parentArea->getStore();
+    return SymbolTable::vehicles().nameOf(store->getOccupant(parentArea->getBaseIndex() + slotIndex));
+}
+
+SlotClass ParkingSlot::getSlotClass() const {
+    return parentArea->getStore()->getSlotClass(parentArea->getBaseIndex() + slotIndex);
+}
+
+ParkingArea* ParkingSlot::getParentArea() const {
+    return parentArea;
 }
 
 void ParkingSlot::setAvailability(bool available) {
-    isAvailable = available;
+    // The area flips the store bit and keeps its counters in sync
+    parentArea->setSlotAvailability(slotIndex, available);
+}
+
+bool ParkingSlot::tryClaim() {
+    return parentArea->setSlotAvailability(slotIndex, false);
 }
 
 void ParkingSlot::setVehicleId(const string& vehicleId) {
-    this->vehicleId = vehicleId;
+    int handle = vehicleId.empty() ? SymbolTable::NONE : SymbolTable::vehicles().intern(vehicleId);
+    parentArea->getStore()->setOccupant(parentArea->getBaseIndex() + slotIndex, handle);
 }
 
 void ParkingSlot::displaySlotInfo() const {
-    cout << "Slot ID: " << slotId 
-         << ", Zone: " << zoneId 
+    bool isAvailable = getAvailability();
+    string vehicleId = getVehicleId();
+    
+    cout << "Slot ID: " << getSlotId()
+         << ", Zone: " << getZoneId()
          << ", Available: " << (isAvailable ? "Yes" : "No");
     if (!isAvailable && !vehicleId.empty()) {
         cout << ", Vehicle: " << vehicleId;
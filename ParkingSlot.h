@@ -2,28 +2,36 @@
 #define PARKINGSLOT_H
 
 #include <string>
+#include "SlotClass.h"
 using namespace std;
 
+// Forward declaration
+class ParkingArea;
+
+// Lightweight view over one entry of a zone's SlotStore.
+// The slot id, zone, availability and occupant all live in the store's
+// parallel arrays; this object only remembers where to find them.
 class ParkingSlot {
 private:
-    string slotId;
-    string zoneId;
-    bool isAvailable;
-    string vehicleId; // Vehicle currently parked
-
+    ParkingArea* parentArea; // Area that owns the slot's block in the store
+    int slotIndex;           // Position inside the parent area
+    
 public:
     // Constructor
     ParkingSlot();
-    ParkingSlot(const string& slotId, const string& zoneId);
+    ParkingSlot(ParkingArea* area, int index);
     
     // Getters
     string getSlotId() const;
     string getZoneId() const;
     bool getAvailability() const;
     string getVehicleId() const;
+    SlotClass getSlotClass() const;
+    ParkingArea* getParentArea() const;
     
     // Setters
     void setAvailability(bool available);
+    bool tryClaim(); // Atomically available -> taken; false if already taken
     void setVehicleId(const string& vehicleId);
     
     // Utility
@@ -2,45 +2,65 @@
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <functional>
+#include <chrono>
 using namespace std;
 
-ParkingSystem::ParkingSystem(int maxZones) 
-    : maxZones(maxZones), zoneCount(0),
-      nextVehicleId(1000), nextRequestId(1000) {
+ParkingSystem::ParkingSystem(int initialZoneCapacity, int rollbackDepth) 
+    : schedulingPolicy(SchedulingPolicy::ZONE_FIFO), allocationHoldSeconds(15 * 60),
+      clockStopping(false), nextVehicleId(1000), nextRequestId(1000) {
     
-    // Allocate zones array
-    zones = new Zone*[maxZones];
-    for (int i = 0; i < maxZones; i++) {
-        zones[i] = nullptr;
-    }
+    // Zone registry grows as zones are added
+    zoneRegistry = new ZoneRegistry(initialZoneCapacity);
     
     // Create core components
-    allocationEngine = new AllocationEngine(maxZones);
+    allocationEngine = new AllocationEngine(zoneRegistry);
     requestManager = new RequestManager();
-    rollbackManager = new RollbackManager();
-    requestQueue = new RequestQueue();
+    rollbackManager = new RollbackManager(rollbackDepth);
+    requestDispatcher = new RequestDispatcher();
+    requestScheduler = new RequestScheduler();
+    waitlist = new Waitlist();
+    reservationBook = new ReservationBook();
+    expiryWheel = new TimerWheel(time(0));
+    workerPool = new AllocationWorkerPool(requestDispatcher, this);
     vehicleBST = new VehicleBST();
     
+    // Every transition arms or clears the request's expiry timer
+    requestManager->setStateObserver(this);
+    
     // Initialize with default zones
     initializeDefaultZones();
     
-    cout << "Parking System initialized with " << zoneCount << " zones." << endl;
+    cout << "Parking System initialized with " << zoneRegistry->getZoneCount() << " zones." << endl;
+    
+    clockThread = thread(&ParkingSystem::clockLoop, this);
 }
 
 ParkingSystem::~ParkingSystem() {
-    // Delete zones
-    for (int i = 0; i < zoneCount; i++) {
-        delete zones[i];
+    // The clock and the workers must be joined before anything they touch
+    // goes away
+    {
+        lock_guard<mutex> guard(clockLock);
+        clockStopping = true;
     }
-    delete[] zones;
+    clockWake.notify_all();
+    clockThread.join();
+    delete workerPool;
     
     // Delete core components
     delete allocationEngine;
     delete requestManager;
     delete rollbackManager;
-    delete requestQueue;
+    delete requestDispatcher;
+    delete requestScheduler;
+    delete waitlist;
+    delete reservationBook;
+    delete expiryWheel;
     delete vehicleBST;
     
+    // Delete zones (after the engine that references them)
+    delete zoneRegistry;
+    
     cout << "Parking System destroyed." << endl;
 }
 
@@ -50,6 +70,11 @@ void ParkingSystem::initializeDefaultZones() {
     addZone("Z2", "Uptown", 2);
     addZone("Z3", "Midtown", 2);
     
+    // Every default zone borders the other two
+    addZoneAdjacency("Z1", "Z2", 1);
+    addZoneAdjacency("Z2", "Z3", 1);
+    addZoneAdjacency("Z1", "Z3", 1);
+    
     // Add areas to zones
     addAreaToZone("Z1", "A1", 3);
     addAreaToZone("Z1", "A2", 2);
@@ -70,29 +95,46 @@ void ParkingSystem::initializeDefaultZones() {
 }
 
 bool ParkingSystem::addZone(const string& zoneId, const string& zoneName, int maxAreas) {
-    if (zoneCount >= maxZones) {
-        cout << "Error: Cannot add more zones. Maximum " << maxZones << " reached." << endl;
+    unique_lock<shared_mutex> topology(topologyLock);
+    
+    // Check if zone already exists
+    if (zoneRegistry->findZone(zoneId) != nullptr) {
+        cout << "Error: Zone " << zoneId << " already exists." << endl;
         return false;
     }
     
-    // Check if zone already exists
-    for (int i = 0; i < zoneCount; i++) {
-        if (zones[i]->getZoneId() == zoneId) {
-            cout << "Error: Zone " << zoneId << " already exists." << endl;
-            return false;
-        }
+    // Workers scan the zone queues without the system lock
+    if (workerPool->isRunning()) {
+        cout << "Error: Stop allocation workers before adding zones." << endl;
+        return false;
     }
     
-    zones[zoneCount] = new Zone(zoneId, zoneName, maxAreas);
-    allocationEngine->addZone(zones[zoneCount]);
-    zoneCount++;
+    zoneRegistry->addZone(new Zone(zoneId, zoneName, maxAreas));
+    requestDispatcher->addZone(zoneId);
+    waitlist->addZone(zoneId);
+    allocationEngine->refreshZoneGraph();
     
     cout << "Zone " << zoneId << " (" << zoneName << ") added successfully." << endl;
     return true;
 }
 
+bool ParkingSystem::addZoneAdjacency(const string& zoneA, const string& zoneB, int distance) {
+    // Exclusive: cached fallback orders are dropped and rebuilt on demand
+    unique_lock<shared_mutex> topology(topologyLock);
+    
+    if (!allocationEngine->addZoneAdjacency(zoneA, zoneB, distance)) {
+        return false;
+    }
+    
+    cout << "Zones " << zoneA << " and " << zoneB << " are now adjacent (distance "
+         << distance << ")." << endl;
+    return true;
+}
+
 bool ParkingSystem::addAreaToZone(const string& zoneId, const string& areaId, int maxSlots) {
-    Zone* zone = findZone(zoneId);
+    unique_lock<shared_mutex> topology(topologyLock);
+    
+    Zone* zone = zoneRegistry->findZone(zoneId);
     if (zone == nullptr) {
         cout << "Error: Zone " << zoneId << " not found." << endl;
         return false;
@@ -105,8 +147,11 @@ bool ParkingSystem::addAreaToZone(const string& zoneId, const string& areaId, in
     return success;
 }
 
-bool ParkingSystem::addSlotToArea(const string& zoneId, const string& areaId, const string& slotId) {
-    Zone* zone = findZone(zoneId);
+bool ParkingSystem::addSlotToArea(const string& zoneId, const string& areaId, const string& slotId,
+                                  SlotClass slotClass) {
+    unique_lock<shared_mutex> topology(topologyLock);
+    
+    Zone* zone = zoneRegistry->findZone(zoneId);
     if (zone == nullptr) {
         cout << "Error: Zone " << zoneId << " not found." << endl;
         return false;
@@ -118,37 +163,62 @@ bool ParkingSystem::addSlotToArea(const string& zoneId, const string& areaId, co
         return false;
     }
     
-    bool success = area->addSlot(slotId);
+    if (allocationEngine->findSlot(slotId) != nullptr) {
+        cout << "Error: Slot " << slotId << " already exists." << endl;
+        return false;
+    }
+    
+    bool success = area->addSlot(slotId, slotClass);
     if (success) {
-        cout << "Slot " << slotId << " added to area " << areaId << " in zone " << zoneId << endl;
+        // Index the new slot so lookups by ID don't depend on the zone/area layout
+        ParkingSlot* slot = area->getSlotAt(area->getCurrentSlots() - 1);
+        allocationEngine->registerSlot(slot);
+        reservationBook->addSlot(slot);
+        cout << "Slot " << slotId << " (" << slotClassName(slotClass) << ") added to area "
+             << areaId << " in zone " << zoneId << endl;
+        
+        // A new slot is a freed slot as far as waiting requests are concerned
+        topology.unlock();
+        shared_lock<shared_mutex> serving(topologyLock);
+        serveWaitlists();
     }
     return success;
 }
 
 Zone* ParkingSystem::findZone(const string& zoneId) const {
-    for (int i = 0; i < zoneCount; i++) {
-        if (zones[i]->getZoneId() == zoneId) {
-            return zones[i];
-        }
-    }
-    return nullptr;
+    shared_lock<shared_mutex> topology(topologyLock);
+    return zoneRegistry->findZone(zoneId);
+}
+
+ParkingSlot* ParkingSystem::findSlot(const string& slotId) const {
+    shared_lock<shared_mutex> topology(topologyLock);
+    return allocationEngine->findSlot(slotId);
+}
+
+mutex& ParkingSystem::stripeFor(const string& requestId) const {
+    return requestStripes[hash<string>()(requestId) & (REQUEST_STRIPES - 1)];
+}
+
+long long ParkingSystem::nowMillis() {
+    return chrono::duration_cast<chrono::milliseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
 }
 
 string ParkingSystem::generateVehicleId() {
     stringstream ss;
-    ss << "V" << nextVehicleId;
-    nextVehicleId++;
+    ss << "V" << nextVehicleId.fetch_add(1);
     return ss.str();
 }
 
 string ParkingSystem::generateRequestId() {
     stringstream ss;
-    ss << "R" << nextRequestId;
-    nextRequestId++;
+    ss << "R" << nextRequestId.fetch_add(1);
     return ss.str();
 }
 
 bool ParkingSystem::addVehicle(const string& vehicleType, const string& preferredZone) {
+    lock_guard<mutex> guard(vehicleLock);
+    
     string vehicleId = generateVehicleId();
     Vehicle* vehicle = new Vehicle(vehicleId, vehicleType, preferredZone);
     
@@ -164,50 +234,217 @@ bool ParkingSystem::addVehicle(const string& vehicleType, const string& preferre
 }
 
 Vehicle* ParkingSystem::findVehicle(const string& vehicleId) const {
+    lock_guard<mutex> guard(vehicleLock);
     return vehicleBST->search(vehicleId);
 }
 
 void ParkingSystem::displayAllVehicles() const {
+    lock_guard<mutex> guard(vehicleLock);
+    
     vehicleBST->displayInorder();
 }
 
-string ParkingSystem::createParkingRequest(const string& vehicleId, const string& requestedZone) {
-    Vehicle* vehicle = findVehicle(vehicleId);
-    if (vehicle == nullptr) {
-        // If vehicle doesn't exist, create and register it
-        cout << "Vehicle " << vehicleId << " not found. Auto-registering..." << endl;
-        vehicle = new Vehicle(vehicleId, "Unknown", requestedZone);
-        if (!vehicleBST->insert(vehicle)) {
-            delete vehicle;
-            cout << "Error: Failed to auto-register vehicle." << endl;
-            return "";
+string ParkingSystem::createParkingRequest(const string& vehicleId, const string& requestedZone,
+                                           PriorityClass priority) {
+    // Shared, so the scheduling policy can't switch under this request
+    shared_lock<shared_mutex> topology(topologyLock);
+    
+    ParkingRequest* request = nullptr;
+    string requestId;
+    
+    {
+        lock_guard<mutex> guard(vehicleLock);
+        
+        Vehicle* vehicle = vehicleBST->search(vehicleId);
+        if (vehicle == nullptr) {
+            // If vehicle doesn't exist, create and register it
+            cout << "Vehicle " << vehicleId << " not found. Auto-registering..." << endl;
+            vehicle = new Vehicle(vehicleId, "Unknown", requestedZone);
+            if (!vehicleBST->insert(vehicle)) {
+                delete vehicle;
+                cout << "Error: Failed to auto-register vehicle." << endl;
+                return "";
+            }
+            cout << "Vehicle " << vehicleId << " auto-registered successfully." << endl;
         }
-        cout << "Vehicle " << vehicleId << " auto-registered successfully." << endl;
+        
+        requestId = generateRequestId();
+        request = new ParkingRequest(requestId, vehicle, requestedZone);
+        request->setPriorityClass(priority);
     }
     
-    string requestId = generateRequestId();
-    ParkingRequest* request = new ParkingRequest(requestId, vehicle, requestedZone);
-    
-    // Add to queue first
-    if (requestQueue->enqueue(request)) {
+    if (schedulingPolicy == SchedulingPolicy::PRIORITY) {
+        if (!requestScheduler->enqueue(request, nowMillis())) {
+            delete request;
+            return "";
+        }
         cout << "Parking request " << requestId << " created successfully." << endl;
-        cout << "Vehicle: " << vehicleId << " -> Zone: " << requestedZone << endl;
-        cout << "Request added to queue. Use 'Process Next Request' to allocate." << endl;
+        cout << "Vehicle: " << vehicleId << " -> Zone: " << requestedZone
+             << " (Priority: " << request->priorityToString() << ")" << endl;
+        cout << "Request added to priority queue. Use 'Process Next Request' to allocate." << endl;
         return requestId;
-    } else {
-        delete request;
-        cout << "Error: Request queue is full. Cannot create new request." << endl;
-        return "";
     }
+    
+    // Add to the zone's queue first; lock-free until a lane outgrows its ring
+    requestDispatcher->enqueue(request);
+    cout << "Parking request " << requestId << " created successfully." << endl;
+    cout << "Vehicle: " << vehicleId << " -> Zone: " << requestedZone << endl;
+    if (!workerPool->isRunning()) {
+        cout << "Request added to queue. Use 'Process Next Request' to allocate." << endl;
+    }
+    return requestId;
 }
 
 bool ParkingSystem::processNextRequest() {
-    ParkingRequest* request = requestQueue->dequeue();
+    shared_lock<shared_mutex> topology(topologyLock);
+    
+    // Slots held for drivers who never came go back first, then
+    // reservations whose window has opened go ahead of new arrivals
+    if (expiryWheel->hasDue(time(0))) {
+        expireAllocations(time(0));
+    }
+    if (reservationBook->hasDue(time(0))) {
+        activateReservations(time(0));
+    }
+    
+    if (workerPool->isRunning()) {
+        cout << "Allocation workers are running; pending requests are processed automatically." << endl;
+        return false;
+    }
+    
+    ParkingRequest* request = (schedulingPolicy == SchedulingPolicy::PRIORITY)
+        ? requestScheduler->dequeue()
+        : requestDispatcher->dequeueOldest();
     if (request == nullptr) {
         cout << "No pending requests in queue." << endl;
         return false;
     }
     
+    return admitRequest(request);
+}
+
+int ParkingSystem::processPendingBatch(int maxRequests, BatchAssignment assignment, long long budgetMicros) {
+    // Exclusive for the whole burst: no request can change state under the
+    // batch, so slots are bound without request stripes and the rollback
+    // records go onto the stack together, in order
+    unique_lock<shared_mutex> topology(topologyLock);
+    
+    if (workerPool->isRunning()) {
+        cout << "Allocation workers are running; pending requests are processed automatically." << endl;
+        return 0;
+    }
+    if (maxRequests <= 0) {
+        cout << "Error: Batch size must be positive." << endl;
+        return 0;
+    }
+    if (expiryWheel->hasDue(time(0))) {
+        expireAllocations(time(0));
+    }
+    if (reservationBook->hasDue(time(0))) {
+        activateReservations(time(0));
+    }
+    
+    // Same order processNextRequest would serve them in
+    ParkingRequest** batch = new ParkingRequest*[maxRequests];
+    int count = 0;
+    if (schedulingPolicy == SchedulingPolicy::PRIORITY) {
+        while (count < maxRequests && (batch[count] = requestScheduler->dequeue()) != nullptr) {
+            count++;
+        }
+    } else {
+        count = requestDispatcher->dequeueOldestBatch(batch, maxRequests);
+    }
+    for (int i = 0; i < count; i++) {
+        requestManager->addRequest(batch[i]);
+    }
+    
+    if (count == 0) {
+        cout << "No pending requests in queue." << endl;
+        delete[] batch;
+        return 0;
+    }
+    
+    // One pass per requested zone; whoever that leaves without a slot is
+    // matched across zones (MIN_COST) or takes the single-request path
+    ParkingSlot** slots = new ParkingSlot*[count];
+    bool budgetExceeded = false;
+    if (assignment == BatchAssignment::MIN_COST) {
+        allocationEngine->claimSlotsMinCost(batch, count, slots, budgetMicros * 1000, budgetExceeded);
+    } else {
+        allocationEngine->claimSlotsByZone(batch, count, slots);
+    }
+    
+    ParkingRequest** allocated = new ParkingRequest*[count];
+    int allocatedCount = 0;
+    int crossZoneCount = 0;
+    int waitlistedCount = 0;
+    bool returnedSlots = false;
+    stringstream audit;
+    
+    for (int i = 0; i < count; i++) {
+        ParkingRequest* request = batch[i];
+        ParkingSlot* slot = slots[i];
+        if (request->getCurrentState() != RequestState::REQUESTED) {
+            if (slot != nullptr) {
+                slot->setAvailability(true);
+                returnedSlots = true;
+            }
+            audit << "  " << request->getRequestId() << " -> skipped, " << request->stateToString() << "\n";
+            continue;
+        }
+        
+        if (slot != nullptr) {
+            request->bindClaimedSlot(slot, slot->getZoneId() != request->getRequestedZoneId());
+        } else {
+            slot = allocationEngine->claimSlot(request);
+        }
+        if (slot == nullptr) {
+            waitlistedCount += waitlist->add(request) ? 1 : 0;
+            audit << "  " << request->getRequestId() << " -> waiting for zone "
+                  << request->getRequestedZoneId() << "\n";
+            continue;
+        }
+        
+        allocated[allocatedCount++] = request;
+        if (request->isCrossZoneAllocation()) {
+            crossZoneCount++;
+        }
+        audit << "  " << request->getRequestId() << " -> " << slot->getSlotId()
+              << (request->isCrossZoneAllocation() ? " (cross-zone)" : "") << "\n";
+    }
+    
+    if (allocatedCount > 0) {
+        rollbackManager->recordAllocationBatch(allocated, allocatedCount);
+    }
+    
+    cout << "Batch processed " << count << " requests: " << allocatedCount << " allocated ("
+         << crossZoneCount << " cross-zone), " << waitlistedCount << " waitlisted." << endl;
+    if (budgetExceeded) {
+        cout << "Min-cost assignment ran out of its " << budgetMicros
+             << " us budget; the remaining overflow was allocated greedily." << endl;
+    }
+    cout << audit.str();
+    if (returnedSlots) {
+        serveWaitlists();
+    }
+    debugCheckCounters();
+    
+    delete[] allocated;
+    delete[] slots;
+    delete[] batch;
+    return allocatedCount;
+}
+
+void ParkingSystem::processDequeuedRequest(ParkingRequest* request) {
+    // Called on a worker thread
+    shared_lock<shared_mutex> topology(topologyLock);
+    if (expiryWheel->hasDue(time(0))) {
+        expireAllocations(time(0));
+    }
+    admitRequest(request);
+}
+
+bool ParkingSystem::admitRequest(ParkingRequest* request) {
     // Add to request manager
     requestManager->addRequest(request);
     
@@ -216,19 +453,21 @@ bool ParkingSystem::processNextRequest() {
     cout << "Requested Zone: " << request->getRequestedZoneId() << endl;
     
     // Try to allocate immediately
-    bool allocated = allocateSlotToRequest(request->getRequestId());
+    bool allocated = allocateRequest(request);
     
     if (allocated) {
         cout << "Request " << request->getRequestId() << " processed and allocated successfully." << endl;
     } else {
         cout << "Request " << request->getRequestId() << " processed but could not allocate (no available slots)." << endl;
-        cout << "Request remains in REQUESTED state. Try again later." << endl;
+        cout << "Request remains in REQUESTED state." << endl;
     }
     
     return allocated;
 }
 
 bool ParkingSystem::allocateSlotToRequest(const string& requestId) {
+    shared_lock<shared_mutex> topology(topologyLock);
+    
     ParkingRequest* request = requestManager->findRequest(requestId);
     if (request == nullptr) {
         // Check if request is still in queue
@@ -237,42 +476,171 @@ bool ParkingSystem::allocateSlotToRequest(const string& requestId) {
         return false;
     }
     
+    return allocateRequest(request);
+}
+
+bool ParkingSystem::allocateRequest(ParkingRequest* request) {
+    string requestId = request->getRequestId();
+    lock_guard<mutex> stripe(stripeFor(requestId));
+    
     if (request->getCurrentState() != RequestState::REQUESTED) {
         cout << "Error: Request " << requestId << " is not in REQUESTED state." << endl;
         cout << "Current state: " << request->stateToString() << endl;
         return false;
     }
     
-    ParkingSlot* slot = allocationEngine->allocateSlot(request);
+    // Search and claim are one lock-free CAS on the zone's free bits
+    ParkingSlot* slot = allocationEngine->claimSlot(request);
     if (slot == nullptr) {
         cout << "Error: No available slots in system." << endl;
+        if (waitlist->add(request)) {
+            cout << "Request " << requestId << " added to the waitlist for zone "
+                 << request->getRequestedZoneId() << "; it gets the next slot freed there." << endl;
+        }
         return false;
     }
     
-    bool crossZone = (slot->getZoneId() != request->getRequestedZoneId());
-    bool success = request->allocateSlot(slot, crossZone);
+    reportAllocation(request, slot);
+    debugCheckCounters();
+    return true;
+}
+
+void ParkingSystem::reportAllocation(ParkingRequest* request, ParkingSlot* slot) {
+    rollbackManager->recordAllocation(request->getRequestId(), slot->getSlotId(), slot->getZoneId());
+    cout << "Slot allocated successfully!" << endl;
+    cout << "Allocated Slot: " << slot->getSlotId() << " in Zone " << slot->getZoneId() << endl;
+    if (request->isCrossZoneAllocation()) {
+        cout << "Cross-zone allocation. Extra cost applies." << endl;
+    }
+}
+
+bool ParkingSystem::handOffSlot(ParkingSlot* slot) {
+    // Caller holds topologyLock shared and no request stripe
+    // A reservation about to open on the slot comes before any waiter
+    if (reservationBook->holdFreedSlot(slot)) {
+        cout << "Slot " << slot->getSlotId() << " held for an upcoming reservation." << endl;
+        return true;
+    }
+    if (waitlist->getTotalWaiting() == 0) {
+        return false;
+    }
     
-    if (success) {
-        rollbackManager->recordAllocation(requestId, slot->getSlotId(), slot->getZoneId());
-        cout << "Slot allocated successfully!" << endl;
-        cout << "Allocated Slot: " << slot->getSlotId() << " in Zone " << slot->getZoneId() << endl;
-        if (crossZone) {
-            cout << "Cross-zone allocation. Extra cost applies." << endl;
+    // The slot's own zone first, then the others nearest first. Only
+    // waiters whose vehicle fits the slot are considered.
+    SlotClass slotClass = slot->getSlotClass();
+    int origin = zoneRegistry->indexOf(slot->getZoneId());
+    int index;
+    while ((index = nearestZoneWithWaiters(origin, slotClass)) != -1) {
+        ParkingRequest* waiter = waitlist->takeOldest(zoneRegistry->getZoneAt(index)->getZoneId(), slotClass);
+        if (waiter == nullptr) {
+            continue; // Another thread served the zone meanwhile
         }
-    } else {
-        cout << "Error: Failed to allocate slot." << endl;
+        
+        lock_guard<mutex> stripe(stripeFor(waiter->getRequestId()));
+        if (waiter->getCurrentState() != RequestState::REQUESTED) {
+            continue; // Cancelled between leaving the waitlist and here
+        }
+        
+        if (!slot->tryClaim()) {
+            // A concurrent allocator took the slot first
+            waitlist->putBack(waiter);
+            return false;
+        }
+        waiter->bindClaimedSlot(slot, index != origin);
+        cout << "Freed slot " << slot->getSlotId() << " handed to waiting request "
+             << waiter->getRequestId() << "." << endl;
+        reportAllocation(waiter, slot);
+        return true;
+    }
+    return false;
+}
+
+int ParkingSystem::nearestZoneWithWaiters(int origin, SlotClass slotClass) {
+    // Only zones with a waiter that fits are visited, found through the
+    // waitlist's per-class trees; each is ranked by where the fallback walk
+    // from origin would reach it, and a direct neighbour ends the search
+    int first = waitlist->findZoneWithWaiters(origin, slotClass);
+    if (first == origin || first == -1) {
+        return first;
     }
     
-    return success;
+    ZoneGraph* graph = allocationEngine->getZoneGraph();
+    int zoneCount = zoneRegistry->getZoneCount();
+    int nearest = -1;
+    int nearestRank = 0;
+    for (int zone = first; zone != -1; ) {
+        int rank = graph->getFallbackRank(origin, zone, zoneCount);
+        if (nearest == -1 || rank < nearestRank) {
+            nearest = zone;
+            nearestRank = rank;
+        }
+        if (rank == 0) {
+            break;
+        }
+        
+        int zoneOffset = (zone - origin + zoneCount) % zoneCount;
+        int next = waitlist->findZoneWithWaiters((zone + 1) % zoneCount, slotClass);
+        int nextOffset = (next - origin + zoneCount) % zoneCount;
+        if (next == -1 || nextOffset <= zoneOffset) {
+            break; // Wrapped back around to the origin
+        }
+        zone = next;
+    }
+    return nearest;
+}
+
+void ParkingSystem::serveWaitlists() {
+    // Caller holds topologyLock shared and no request stripe
+    if (waitlist->getTotalWaiting() == 0) {
+        return;
+    }
+    
+    // Only zones with free slots can serve anyone; the capacity tree jumps
+    // from one to the next
+    int zoneCount = zoneRegistry->getZoneCount();
+    for (int z = zoneRegistry->findZoneWithCapacity(0); z != -1; ) {
+        Zone* zone = zoneRegistry->getZoneAt(z);
+        while (zone->getAvailableSlots() > 0) {
+            // Anyone who fits the largest free class can be served here
+            int largest = SLOT_CLASS_COUNT - 1;
+            while (largest > 0 && zone->getAvailableSlots((SlotClass)largest) == 0) {
+                largest--;
+            }
+            ParkingRequest* waiter = waitlist->takeOldest(zone->getZoneId(), (SlotClass)largest);
+            if (waiter == nullptr) {
+                break;
+            }
+            
+            lock_guard<mutex> stripe(stripeFor(waiter->getRequestId()));
+            if (waiter->getCurrentState() != RequestState::REQUESTED) {
+                continue;
+            }
+            
+            ParkingSlot* slot = zone->claimAvailableSlotInZone(waiter->getSlotClass());
+            if (slot == nullptr) {
+                waitlist->putBack(waiter);
+                break;
+            }
+            waiter->bindClaimedSlot(slot, false);
+            cout << "Waiting request " << waiter->getRequestId() << " allocated." << endl;
+            reportAllocation(waiter, slot);
+        }
+        
+        int next = (z + 1 < zoneCount) ? zoneRegistry->findZoneWithCapacity(z + 1) : -1;
+        z = (next > z) ? next : -1; // Stop instead of wrapping to the front
+    }
 }
 
 bool ParkingSystem::markAsOccupied(const string& requestId) {
+    shared_lock<shared_mutex> topology(topologyLock);
+    
     ParkingRequest* request = requestManager->findRequest(requestId);
     if (request == nullptr) {
         cout << "Error: Request " << requestId << " not found." << endl;
         return false;
     }
     
+    lock_guard<mutex> stripe(stripeFor(requestId));
     RequestState previousState = request->getCurrentState();
     bool success = request->markAsOccupied();
     
@@ -290,12 +658,15 @@ bool ParkingSystem::markAsOccupied(const string& requestId) {
 }
 
 bool ParkingSystem::markAsReleased(const string& requestId) {
+    shared_lock<shared_mutex> topology(topologyLock);
+    
     ParkingRequest* request = requestManager->findRequest(requestId);
     if (request == nullptr) {
         cout << "Error: Request " << requestId << " not found." << endl;
         return false;
     }
     
+    unique_lock<mutex> stripe(stripeFor(requestId));
     RequestState previousState = request->getCurrentState();
     bool success = request->markAsReleased();
     
@@ -303,24 +674,48 @@ bool ParkingSystem::markAsReleased(const string& requestId) {
         rollbackManager->recordStateChange(requestId, previousState);
         cout << "Request " << requestId << " marked as RELEASED." << endl;
         cout << "Slot " << request->getAllocatedSlot()->getSlotId() << " is now available." << endl;
-        cout << "Parking Duration: " << fixed << setprecision(2) 
-             << request->calculateDuration() << " minutes" << endl;
+        // Format locally: cout's flags are shared by every releasing thread
+        stringstream duration;
+        duration << fixed << setprecision(2) << request->calculateDuration();
+        cout << "Parking Duration: " << duration.str() << " minutes" << endl;
+        
+        // Stripes are never nested, so let go before taking the waiter's
+        ParkingSlot* freedSlot = request->getAllocatedSlot();
+        stripe.unlock();
+        handOffSlot(freedSlot);
     } else {
         cout << "Error: Cannot mark as RELEASED." << endl;
         cout << "Current state: " << request->stateToString() << endl;
         cout << "Required state: OCCUPIED" << endl;
     }
     
+    debugCheckCounters();
     return success;
 }
 
 bool ParkingSystem::cancelRequest(const string& requestId) {
+    shared_lock<shared_mutex> topology(topologyLock);
+    
     ParkingRequest* request = requestManager->findRequest(requestId);
     if (request == nullptr) {
         cout << "Error: Request " << requestId << " not found." << endl;
         return false;
     }
     
+    return cancelTracked(request, false);
+}
+
+bool ParkingSystem::cancelTracked(ParkingRequest* request, bool unclaimedOnly) {
+    // Caller holds topologyLock (either mode) and no request stripe
+    string requestId = request->getRequestId();
+    unique_lock<mutex> stripe(stripeFor(requestId));
+    if (unclaimedOnly) {
+        if (request->getCurrentState() != RequestState::ALLOCATED) {
+            return false; // Occupied or cancelled after its timer fired
+        }
+        cout << "Allocation " << requestId << " expired: the vehicle did not arrive." << endl;
+    }
+    
     RequestState previousState = request->getCurrentState();
     bool success = request->cancelRequest();
     
@@ -330,6 +725,13 @@ bool ParkingSystem::cancelRequest(const string& requestId) {
         
         if (previousState == RequestState::ALLOCATED) {
             cout << "Slot " << request->getAllocatedSlot()->getSlotId() << " has been freed." << endl;
+            ParkingSlot* freedSlot = request->getAllocatedSlot();
+            stripe.unlock();
+            handOffSlot(freedSlot);
+        } else if (waitlist->getTotalWaiting() > 0) {
+            // A reservation cancelled while holding its slot frees it
+            stripe.unlock();
+            serveWaitlists();
         }
     } else {
         cout << "Error: Cannot cancel request." << endl;
@@ -337,18 +739,319 @@ bool ParkingSystem::cancelRequest(const string& requestId) {
         cout << "Cancellation only allowed from REQUESTED or ALLOCATED states." << endl;
     }
     
+    debugCheckCounters();
     return success;
 }
 
+string ParkingSystem::reserveSlot(const string& vehicleId, const string& zoneId, time_t start, time_t end) {
+    shared_lock<shared_mutex> topology(topologyLock);
+    
+    if (end <= start) {
+        cout << "Error: A reservation must end after it starts." << endl;
+        return "";
+    }
+    if (start < time(0)) {
+        cout << "Error: A reservation cannot start in the past." << endl;
+        return "";
+    }
+    
+    Zone* zone = zoneRegistry->findZone(zoneId);
+    if (zone == nullptr) {
+        cout << "Error: Zone " << zoneId << " not found." << endl;
+        return "";
+    }
+    
+    ParkingRequest* request = nullptr;
+    {
+        lock_guard<mutex> guard(vehicleLock);
+        Vehicle* vehicle = vehicleBST->search(vehicleId);
+        if (vehicle == nullptr) {
+            cout << "Error: Vehicle " << vehicleId << " not found. Register it before reserving." << endl;
+            return "";
+        }
+        request = new ParkingRequest(generateRequestId(), vehicle, zoneId);
+    }
+    
+    // The clock thread may take the booking as due at once; the stripe
+    // keeps it off the request until the request is tracked
+    lock_guard<mutex> stripe(stripeFor(request->getRequestId()));
+    ParkingSlot* slot = reservationBook->bookInZone(request, zone, request->getSlotClass(), start, end);
+    if (slot == nullptr) {
+        cout << "Error: No " << slotClassName(request->getSlotClass()) << "-or-larger slot in zone "
+             << zoneId << " is free for that window." << endl;
+        delete request;
+        return "";
+    }
+    
+    // Tracked like any admitted request, but queued nowhere: the
+    // reservation book allocates it when the window opens
+    requestManager->addRequest(request);
+    cout << "Reservation " << request->getRequestId() << " booked: slot " << slot->getSlotId()
+         << " in zone " << zoneId << " for " << (end - start + 59) / 60 << " min." << endl;
+    return request->getRequestId();
+}
+
+bool ParkingSystem::isWindowFree(const string& zoneId, SlotClass fits, time_t start, time_t end) const {
+    shared_lock<shared_mutex> topology(topologyLock);
+    Zone* zone = zoneRegistry->findZone(zoneId);
+    return (zone != nullptr) && (reservationBook->findFreeSlot(zone, fits, start, end) != nullptr);
+}
+
+int ParkingSystem::activateDueReservations(time_t now) {
+    shared_lock<shared_mutex> topology(topologyLock);
+    return activateReservations(now);
+}
+
+int ParkingSystem::activateReservations(time_t now) {
+    // Caller holds topologyLock (either mode) and no request stripe
+    int allocated = 0;
+    ParkingSlot* booked;
+    bool held;
+    bool freedHold = false;
+    ParkingRequest* request;
+    
+    while ((request = reservationBook->takeDue(now, booked, held)) != nullptr) {
+        lock_guard<mutex> stripe(stripeFor(request->getRequestId()));
+        if (request->getCurrentState() != RequestState::REQUESTED) {
+            if (held) {
+                booked->setAvailability(true); // Allocated by hand meanwhile
+                freedHold = true;
+            }
+            continue;
+        }
+        
+        cout << "Reservation " << request->getRequestId() << " window open." << endl;
+        
+        // The book has held the slot since shortly before the window
+        // opened, unless a car parked there never left; then the request
+        // claims like any other, in-zone first
+        ParkingSlot* slot = nullptr;
+        if (held) {
+            slot = booked;
+            request->bindClaimedSlot(slot, false);
+        } else if (booked->tryClaim()) {
+            slot = booked;
+            request->bindClaimedSlot(slot, false);
+        } else {
+            cout << "Booked slot " << booked->getSlotId() << " is occupied; allocating another." << endl;
+            slot = allocationEngine->claimSlot(request);
+        }
+        if (slot == nullptr) {
+            if (waitlist->add(request)) {
+                cout << "Reservation " << request->getRequestId() << " added to the waitlist for zone "
+                     << request->getRequestedZoneId() << "." << endl;
+            }
+            continue;
+        }
+        
+        reportAllocation(request, slot);
+        allocated++;
+    }
+    
+    if (freedHold) {
+        serveWaitlists();
+    }
+    debugCheckCounters();
+    return allocated;
+}
+
+void ParkingSystem::displayReservations() const {
+    reservationBook->displayUpcoming(time(0));
+}
+
+int ParkingSystem::getReservationCount() const {
+    return reservationBook->getBookingCount();
+}
+
+bool ParkingSystem::setAllocationHold(int seconds) {
+    if (seconds < 0) {
+        cout << "Error: The hold time cannot be negative." << endl;
+        return false;
+    }
+    allocationHoldSeconds = seconds;
+    if (seconds == 0) {
+        cout << "New allocations no longer expire." << endl;
+    } else {
+        cout << "New allocations expire after " << (seconds + 59) / 60
+             << " min unless the vehicle arrives." << endl;
+    }
+    return true;
+}
+
+int ParkingSystem::getAllocationHold() const {
+    return allocationHoldSeconds;
+}
+
+int ParkingSystem::expireUnclaimedAllocations(time_t now) {
+    shared_lock<shared_mutex> topology(topologyLock);
+    return expireAllocations(now);
+}
+
+int ParkingSystem::expireAllocations(time_t now) {
+    // Caller holds topologyLock (either mode) and no request stripe. Only
+    // timers that fired are visited, never the whole request list.
+    int expired = 0;
+    ParkingRequest* request;
+    while ((request = expiryWheel->takeExpired(now)) != nullptr) {
+        if (cancelTracked(request, true)) {
+            expired++;
+        }
+    }
+    return expired;
+}
+
+void ParkingSystem::clockLoop() {
+    unique_lock<mutex> guard(clockLock);
+    while (!clockWake.wait_for(guard, chrono::seconds(1), [this] { return clockStopping; })) {
+        guard.unlock();
+        tick(time(0));
+        guard.lock();
+    }
+}
+
+void ParkingSystem::tick(time_t now) {
+    // Both due checks are lock-free, so an idle second takes no lock
+    bool expiring = expiryWheel->hasDue(now);
+    bool opening = reservationBook->hasDue(now);
+    if (!expiring && !opening) {
+        return;
+    }
+    shared_lock<shared_mutex> topology(topologyLock);
+    if (expiring) {
+        expireAllocations(now);
+    }
+    if (opening) {
+        activateReservations(now);
+    }
+}
+
+int ParkingSystem::getExpiryTimerCount() const {
+    return expiryWheel->getScheduledCount();
+}
+
+void ParkingSystem::onRequestStateChanged(ParkingRequest* request, RequestState previousState) {
+    // Called with the request's stripe held, or the topology lock exclusive
+    if (request->getCurrentState() == RequestState::CANCELLED && previousState == RequestState::REQUESTED) {
+        waitlist->remove(request); // Stop counting it as waiting, if it was
+    }
+    
+    // However it ends (released, cancelled, expired or rolled back), a
+    // reservation's booking frees the rest of its window
+    if (request->getCurrentState() == RequestState::RELEASED ||
+        request->getCurrentState() == RequestState::CANCELLED) {
+        reservationBook->release(request);
+    }
+    
+    if (request->getCurrentState() == RequestState::ALLOCATED) {
+        int hold = allocationHoldSeconds;
+        if (hold > 0) {
+            expiryWheel->schedule(request, request->getAllocationTime() + hold);
+        }
+    } else if (previousState == RequestState::ALLOCATED) {
+        expiryWheel->cancel(request);
+    }
+}
+
 void ParkingSystem::displayPendingRequests() const {
-    requestQueue->displayQueue();
+    if (schedulingPolicy == SchedulingPolicy::PRIORITY) {
+        requestScheduler->displayQueue();
+    } else {
+        // Lane contents can only be listed while no worker is dequeuing
+        requestDispatcher->displayQueues(!workerPool->isRunning());
+    }
+    
+    if (waitlist->getTotalWaiting() > 0) {
+        waitlist->displayWaitlists();
+    }
 }
 
 int ParkingSystem::getPendingRequestCount() const {
-    return requestQueue->getSize();
+    return requestDispatcher->getPendingCount() + requestScheduler->getSize();
+}
+
+bool ParkingSystem::setSchedulingPolicy(SchedulingPolicy policy) {
+    unique_lock<shared_mutex> topology(topologyLock);
+    
+    if (workerPool->isRunning()) {
+        cout << "Error: Stop the allocation workers before changing the scheduling policy." << endl;
+        return false;
+    }
+    if (getPendingRequestCount() > 0) {
+        cout << "Error: Process pending requests before changing the scheduling policy." << endl;
+        return false;
+    }
+    
+    schedulingPolicy = policy;
+    cout << "Scheduling policy set to "
+         << (policy == SchedulingPolicy::PRIORITY ? "priority classes with aging." : "per-zone FIFO.") << endl;
+    return true;
+}
+
+void ParkingSystem::displayWaitlists() const {
+    waitlist->displayWaitlists();
+}
+
+int ParkingSystem::getWaitlistedCount() const {
+    return waitlist->getTotalWaiting();
+}
+
+SchedulingPolicy ParkingSystem::getSchedulingPolicy() const {
+    return schedulingPolicy;
+}
+
+void ParkingSystem::setAllocationPolicy(AllocationPolicy policy) {
+    // Exclusive, so no claim runs half under the old policy
+    unique_lock<shared_mutex> topology(topologyLock);
+    allocationEngine->setPolicy(policy);
+    cout << "Allocation policy set to " << allocationPolicyName(policy) << "." << endl;
+}
+
+AllocationPolicy ParkingSystem::getAllocationPolicy() const {
+    return allocationEngine->getPolicy();
+}
+
+bool ParkingSystem::updateRequestPriority(const string& requestId, PriorityClass priority) {
+    if (!requestScheduler->updatePriority(requestId, priority)) {
+        cout << "Error: Request " << requestId << " is not waiting in the priority queue." << endl;
+        return false;
+    }
+    cout << "Request " << requestId << " rescheduled." << endl;
+    return true;
+}
+
+bool ParkingSystem::startAllocationWorkers(int workerCount) {
+    // Shared, so the scheduling policy can't switch while workers start
+    shared_lock<shared_mutex> topology(topologyLock);
+    
+    if (schedulingPolicy == SchedulingPolicy::PRIORITY) {
+        cout << "Error: Allocation workers drain the per-zone FIFO queues. Switch to FIFO scheduling first." << endl;
+        return false;
+    }
+    if (!workerPool->start(workerCount)) {
+        cout << "Error: Allocation workers are already running or the count is invalid." << endl;
+        return false;
+    }
+    cout << workerCount << " allocation workers started across "
+         << zoneRegistry->getZoneCount() << " zone queues." << endl;
+    return true;
+}
+
+void ParkingSystem::stopAllocationWorkers() {
+    if (!workerPool->isRunning()) {
+        return;
+    }
+    workerPool->stop();
+    cout << "Allocation workers stopped. Processed: " << workerPool->getProcessedCount()
+         << " (stolen from other zones: " << workerPool->getStolenCount() << ")" << endl;
+}
+
+bool ParkingSystem::areAllocationWorkersRunning() const {
+    return workerPool->isRunning();
 }
 
 bool ParkingSystem::rollbackLastOperation() {
+    unique_lock<shared_mutex> topology(topologyLock);
+    
     cout << "Attempting to rollback last operation..." << endl;
     bool success = rollbackManager->rollbackLastOperation(requestManager, allocationEngine);
     if (success) {
@@ -356,10 +1059,18 @@ bool ParkingSystem::rollbackLastOperation() {
     } else {
         cout << "Rollback failed or no operations to rollback." << endl;
     }
+    debugCheckCounters();
+    
+    // Undone allocations may have freed slots that someone is waiting for
+    topology.unlock();
+    shared_lock<shared_mutex> serving(topologyLock);
+    serveWaitlists();
     return success;
 }
 
 bool ParkingSystem::rollbackLastKOperations(int k) {
+    unique_lock<shared_mutex> topology(topologyLock);
+    
     cout << "Attempting to rollback last " << k << " operations..." << endl;
     bool success = rollbackManager->rollbackLastKOperations(k, requestManager, allocationEngine);
     if (success) {
@@ -367,18 +1078,25 @@ bool ParkingSystem::rollbackLastKOperations(int k) {
     } else {
         cout << "Rollback failed." << endl;
     }
+    debugCheckCounters();
+    
+    topology.unlock();
+    shared_lock<shared_mutex> serving(topologyLock);
+    serveWaitlists();
     return success;
 }
 
 void ParkingSystem::displaySystemStatus() const {
+    shared_lock<shared_mutex> topology(topologyLock);
+    
     cout << "\n=======================================" << endl;
     cout << "       SYSTEM STATUS REPORT" << endl;
     cout << "=======================================" << endl;
     
     cout << "\n--- Zones Summary ---" << endl;
-    cout << "Total Zones: " << zoneCount << endl;
-    for (int i = 0; i < zoneCount; i++) {
-        Zone* zone = zones[i];
+    cout << "Total Zones: " << zoneRegistry->getZoneCount() << endl;
+    for (int i = 0; i < zoneRegistry->getZoneCount(); i++) {
+        Zone* zone = zoneRegistry->getZoneAt(i);
         cout << "  " << zone->getZoneId() << " (" << zone->getZoneName() << "): "
              << zone->getAvailableSlots() << "/" << zone->getTotalSlots() << " slots available" << endl;
     }
@@ -387,14 +1105,32 @@ void ParkingSystem::displaySystemStatus() const {
     cout << "Total Slots: " << getTotalSlots() << endl;
     cout << "Available Slots: " << getAvailableSlots() << endl;
     cout << "Occupied Slots: " << (getTotalSlots() - getAvailableSlots()) << endl;
+    cout << "Available by Slot Class:";
+    for (int c = 0; c < SLOT_CLASS_COUNT; c++) {
+        cout << " " << slotClassName((SlotClass)c) << " " << getAvailableSlots((SlotClass)c)
+             << "/" << getTotalSlots((SlotClass)c);
+    }
+    cout << endl;
     
     cout << "\n--- Requests Summary ---" << endl;
     cout << "Total Requests: " << getTotalRequests() << endl;
     cout << "Active Requests: " << getActiveRequests() << endl;
     cout << "Pending in Queue: " << getPendingRequestCount() << endl;
+    cout << "Waiting for a Slot: " << getWaitlistedCount() << endl;
+    cout << "Booked Reservations: " << getReservationCount() << endl;
+    cout << "Awaiting Arrival: " << getExpiryTimerCount();
+    if (allocationHoldSeconds > 0) {
+        cout << " (expire after " << (allocationHoldSeconds + 59) / 60 << " min)";
+    }
+    cout << endl;
     
     cout << "\n--- Vehicles Summary ---" << endl;
-    cout << "Registered Vehicles: " << vehicleBST->getCount() << endl;
+    int vehicleCount;
+    {
+        lock_guard<mutex> guard(vehicleLock);
+        vehicleCount = vehicleBST->getCount();
+    }
+    cout << "Registered Vehicles: " << vehicleCount << endl;
     
     cout << "\n--- Rollback Status ---" << endl;
     cout << "Available Rollbacks: " << rollbackManager->getAvailableRollbacks() << endl;
@@ -403,12 +1139,14 @@ void ParkingSystem::displaySystemStatus() const {
 }
 
 void ParkingSystem::displayZoneAnalytics() const {
+    shared_lock<shared_mutex> topology(topologyLock);
+    
     cout << "\n=======================================" << endl;
     cout << "         ZONE ANALYTICS" << endl;
     cout << "=======================================" << endl;
     
-    for (int i = 0; i < zoneCount; i++) {
-        Zone* zone = zones[i];
+    for (int i = 0; i < zoneRegistry->getZoneCount(); i++) {
+        Zone* zone = zoneRegistry->getZoneAt(i);
         int totalSlots = zone->getTotalSlots();
         int availableSlots = zone->getAvailableSlots();
         int occupiedSlots = totalSlots - availableSlots;
@@ -419,6 +1157,17 @@ void ParkingSystem::displayZoneAnalytics() const {
         cout << "  Occupied Slots: " << occupiedSlots << endl;
         cout << "  Available Slots: " << availableSlots << endl;
         cout << "  Utilization Rate: " << fixed << setprecision(2) << utilization << "%" << endl;
+        cout << "  Available by Slot Class:";
+        for (int c = 0; c < SLOT_CLASS_COUNT; c++) {
+            if (zone->getTotalSlots((SlotClass)c) > 0) {
+                cout << " " << slotClassName((SlotClass)c) << " " << zone->getAvailableSlots((SlotClass)c)
+                     << "/" << zone->getTotalSlots((SlotClass)c);
+            }
+        }
+        cout << endl;
+        cout << "  Fallback Zones: ";
+        allocationEngine->getZoneGraph()->displayFallbackOrder(i);
+        cout << endl;
         
         // Display utilization bar
         cout << "  [";
@@ -433,6 +1182,8 @@ void ParkingSystem::displayZoneAnalytics() const {
 }
 
 void ParkingSystem::displayRequestAnalytics() const {
+    shared_lock<shared_mutex> topology(topologyLock);
+    
     cout << "\n=======================================" << endl;
     cout << "        REQUEST ANALYTICS" << endl;
     cout << "=======================================" << endl;
@@ -464,10 +1215,15 @@ void ParkingSystem::displayRequestAnalytics() const {
     cout << "Average Parking Duration: " << fixed << setprecision(2) 
          << requestManager->getAverageDuration() << " minutes" << endl;
     
+    cout << "\n--- Duration Distribution ---" << endl;
+    requestManager->displayDurationStatistics();
+    
     cout << "\n=======================================" << endl;
 }
 
 void ParkingSystem::displayPeakUsage() const {
+    shared_lock<shared_mutex> topology(topologyLock);
+    
     cout << "\n=======================================" << endl;
     cout << "        PEAK USAGE ANALYSIS" << endl;
     cout << "=======================================" << endl;
@@ -477,8 +1233,8 @@ void ParkingSystem::displayPeakUsage() const {
     int maxUtilization = 0;
     int minUtilization = 100;
     
-    for (int i = 0; i < zoneCount; i++) {
-        Zone* zone = zones[i];
+    for (int i = 0; i < zoneRegistry->getZoneCount(); i++) {
+        Zone* zone = zoneRegistry->getZoneAt(i);
         int totalSlots = zone->getTotalSlots();
         int availableSlots = zone->getAvailableSlots();
         int occupiedSlots = totalSlots - availableSlots;
@@ -526,19 +1282,19 @@ void ParkingSystem::displayPeakUsage() const {
 }
 
 int ParkingSystem::getTotalSlots() const {
-    int total = 0;
-    for (int i = 0; i < zoneCount; i++) {
-        total += zones[i]->getTotalSlots();
-    }
-    return total;
+    return allocationEngine->getTotalSlots();
 }
 
 int ParkingSystem::getAvailableSlots() const {
-    int total = 0;
-    for (int i = 0; i < zoneCount; i++) {
-        total += zones[i]->getAvailableSlots();
-    }
-    return total;
+    return allocationEngine->getTotalAvailableSlots();
+}
+
+int ParkingSystem::getTotalSlots(SlotClass slotClass) const {
+    return zoneRegistry->getTotalSlots(slotClass);
+}
+
+int ParkingSystem::getAvailableSlots(SlotClass slotClass) const {
+    return zoneRegistry->getAvailableSlots(slotClass);
 }
 
 int ParkingSystem::getTotalRequests() const {
@@ -550,6 +1306,66 @@ int ParkingSystem::getActiveRequests() const {
            requestManager->countByState(RequestState::OCCUPIED);
 }
 
+bool ParkingSystem::verifyCapacityCounters() const {
+    // Exclusive, so no slot transition is in flight during the recount
+    unique_lock<shared_mutex> topology(topologyLock);
+    return recountCapacity();
+}
+
+bool ParkingSystem::recountCapacity() const {
+    bool consistent = true;
+    int total = 0;
+    int available = 0;
+    int totalOfClass[SLOT_CLASS_COUNT] = {0};
+    int availableOfClass[SLOT_CLASS_COUNT] = {0};
+    
+    for (int i = 0; i < zoneRegistry->getZoneCount(); i++) {
+        Zone* zone = zoneRegistry->getZoneAt(i);
+        if (!zone->verifyCounters()) {
+            consistent = false;
+        }
+        total += zone->getTotalSlots();
+        available += zone->getAvailableSlots();
+        for (int c = 0; c < SLOT_CLASS_COUNT; c++) {
+            totalOfClass[c] += zone->getTotalSlots((SlotClass)c);
+            availableOfClass[c] += zone->getAvailableSlots((SlotClass)c);
+        }
+        
+        int indexed = zoneRegistry->getAvailableSlotsInRange(i, i + 1);
+        if (indexed != zone->getAvailableSlots()) {
+            cout << "Capacity tree mismatch in zone " << zone->getZoneId() << ": tree="
+                 << indexed << ", counter=" << zone->getAvailableSlots() << endl;
+            consistent = false;
+        }
+    }
+    
+    if (total != getTotalSlots() || available != getAvailableSlots()) {
+        cout << "Counter mismatch system-wide: counters=" << getAvailableSlots() 
+             << "/" << getTotalSlots() << ", recount=" << available << "/" << total << endl;
+        consistent = false;
+    }
+    for (int c = 0; c < SLOT_CLASS_COUNT; c++) {
+        if (totalOfClass[c] != getTotalSlots((SlotClass)c) ||
+            availableOfClass[c] != getAvailableSlots((SlotClass)c)) {
+            cout << "Counter mismatch system-wide for " << slotClassName((SlotClass)c) << " slots: counters="
+                 << getAvailableSlots((SlotClass)c) << "/" << getTotalSlots((SlotClass)c)
+                 << ", recount=" << availableOfClass[c] << "/" << totalOfClass[c] << endl;
+            consistent = false;
+        }
+    }
+    return consistent;
+}
+
+// Compile with -DPARKING_DEBUG_COUNTERS to recount after every slot transition.
+// Runs inside the caller's locks, so it is only exact without allocation workers.
+void ParkingSystem::debugCheckCounters() const {
+#ifdef PARKING_DEBUG_COUNTERS
+    if (!recountCapacity()) {
+        cout << "DEBUG: Capacity counters diverged from a full recount!" << endl;
+    }
+#endif
+}
+
 void ParkingSystem::runTestSuite() {
     // Note: This would integrate with TestSuite class
     cout << "Test suite execution would run here." << endl;
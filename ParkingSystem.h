@@ -2,39 +2,75 @@
 #define PARKINGSYSTEM_H
 
 #include "Zone.h"
+#include "ZoneRegistry.h"
 #include "AllocationEngine.h"
 #include "RequestManager.h"
 #include "RollbackManager.h"
-#include "RequestQueue.h"
+#include "RequestDispatcher.h"
+#include "RequestScheduler.h"
+#include "Waitlist.h"
+#include "ReservationBook.h"
+#include "TimerWheel.h"
+#include "AllocationWorkerPool.h"
 #include "VehicleBST.h"
 #include <string>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
 using namespace std;
 
-class ParkingSystem {
+class ParkingSystem : public RequestProcessor, public RequestStateListener {
 private:
-    Zone** zones;
+    ZoneRegistry* zoneRegistry; // Owns the zones, shared with the engine
     AllocationEngine* allocationEngine;
     RequestManager* requestManager;
     RollbackManager* rollbackManager;
-    RequestQueue* requestQueue;
+    RequestDispatcher* requestDispatcher; // Per-zone pending queues
+    RequestScheduler* requestScheduler;   // Pending requests under PRIORITY scheduling
+    atomic<SchedulingPolicy> schedulingPolicy;
+    Waitlist* waitlist; // Admitted requests waiting for a slot to free up
+    ReservationBook* reservationBook; // Slot windows booked ahead
+    TimerWheel* expiryWheel; // Deadlines of ALLOCATED requests
+    atomic<int> allocationHoldSeconds; // 0: allocations never expire
+    AllocationWorkerPool* workerPool;
     VehicleBST* vehicleBST;
     
-    int zoneCount;
-    int maxZones;
+    // Once a second the clock thread fires whatever has fallen due, so
+    // nothing waits for the next request to be processed
+    thread clockThread;
+    mutex clockLock;
+    condition_variable clockWake;
+    bool clockStopping; // Guarded by clockLock
+    
+    // Lock hierarchy, always acquired in this order:
+    //   topologyLock -> request stripe -> leaf locks
+    // Slot state needs no lock: slots are claimed by CAS on the zones'
+    // free bits. Leaf locks (vehicleLock and the ones inside
+    // RequestManager, RollbackManager and SymbolTable) are held only
+    // briefly and never while taking another lock.
+    static const int REQUEST_STRIPES = 64;
+    mutable shared_mutex topologyLock; // Exclusive: zone/area/slot/adjacency changes, rollback, recount
+    mutable mutex requestStripes[REQUEST_STRIPES]; // Serialize transitions of one request
+    mutable mutex vehicleLock; // Guards vehicleBST
     
     // Counters for ID generation
-    int nextVehicleId;
-    int nextRequestId;
+    atomic<int> nextVehicleId;
+    atomic<int> nextRequestId;
     
 public:
-    ParkingSystem(int maxZones = 10);
+    ParkingSystem(int initialZoneCapacity = 10, int rollbackDepth = 1024);
     ~ParkingSystem();
     
     // Zone management
     bool addZone(const string& zoneId, const string& zoneName, int maxAreas);
     bool addAreaToZone(const string& zoneId, const string& areaId, int maxSlots);
-    bool addSlotToArea(const string& zoneId, const string& areaId, const string& slotId);
+    bool addSlotToArea(const string& zoneId, const string& areaId, const string& slotId,
+                       SlotClass slotClass = SlotClass::LARGE);
+    bool addZoneAdjacency(const string& zoneA, const string& zoneB, int distance = 1);
     Zone* findZone(const string& zoneId) const;
+    ParkingSlot* findSlot(const string& slotId) const;
     
     // Vehicle management (using BST)
     bool addVehicle(const string& vehicleType, const string& preferredZone);
@@ -42,8 +78,13 @@ public:
     void displayAllVehicles() const;
     
     // Request management (with Queue)
-    string createParkingRequest(const string& vehicleId, const string& requestedZone);
-    bool processNextRequest();  // Process from queue
+    string createParkingRequest(const string& vehicleId, const string& requestedZone,
+                                PriorityClass priority = PriorityClass::STANDARD);
+    bool processNextRequest();  // Process oldest pending request on the caller's thread
+    // Up to maxRequests at once; returns how many got a slot. MIN_COST spends
+    // at most budgetMicros matching the overflow before falling back to greedy.
+    int processPendingBatch(int maxRequests, BatchAssignment assignment = BatchAssignment::GREEDY,
+                            long long budgetMicros = 1000);
     bool allocateSlotToRequest(const string& requestId);
     bool markAsOccupied(const string& requestId);
     bool markAsReleased(const string& requestId);
@@ -53,6 +94,45 @@ public:
     void displayPendingRequests() const;
     int getPendingRequestCount() const;
     
+    // Requests that found no slot, served as soon as one frees up
+    void displayWaitlists() const;
+    int getWaitlistedCount() const;
+    
+    // Reservations: a slot booked for [start, end). The request stays
+    // REQUESTED until its window opens, then gets ALLOCATED to the booked
+    // slot, or to another slot that fits if a walk-in is still parked there.
+    // The clock thread holds and opens bookings as they fall due.
+    string reserveSlot(const string& vehicleId, const string& zoneId, time_t start, time_t end);
+    bool isWindowFree(const string& zoneId, SlotClass fits, time_t start, time_t end) const;
+    int activateDueReservations(time_t now); // Returns how many were allocated
+    void displayReservations() const;
+    int getReservationCount() const;
+    
+    // Unclaimed allocations: a request left ALLOCATED for the hold time
+    // (default 15 minutes) is cancelled and its slot freed. Checked every
+    // second and as requests are processed; a new hold applies to later
+    // allocations.
+    bool setAllocationHold(int seconds); // 0 turns expiry off
+    int getAllocationHold() const;
+    int expireUnclaimedAllocations(time_t now); // Returns how many were cancelled
+    int getExpiryTimerCount() const;
+    void onRequestStateChanged(ParkingRequest* request, RequestState previousState) override;
+    
+    // Scheduling: per-zone FIFO, or priority classes with aging
+    bool setSchedulingPolicy(SchedulingPolicy policy); // Only while nothing is pending
+    SchedulingPolicy getSchedulingPolicy() const;
+    bool updateRequestPriority(const string& requestId, PriorityClass priority);
+    
+    // Slot choice for single requests (batches claim first-fit per zone)
+    void setAllocationPolicy(AllocationPolicy policy);
+    AllocationPolicy getAllocationPolicy() const;
+    
+    // Allocation workers drain the zone queues in the background
+    bool startAllocationWorkers(int workerCount);
+    void stopAllocationWorkers();
+    bool areAllocationWorkersRunning() const;
+    void processDequeuedRequest(ParkingRequest* request) override;
+    
     // Rollback operations
     bool rollbackLastOperation();
     bool rollbackLastKOperations(int k);
@@ -66,8 +146,11 @@ public:
     // Utility
     int getTotalSlots() const;
     int getAvailableSlots() const;
+    int getTotalSlots(SlotClass slotClass) const;
+    int getAvailableSlots(SlotClass slotClass) const;
     int getTotalRequests() const;
     int getActiveRequests() const;
+    bool verifyCapacityCounters() const; // Full recount against the maintained counters
     
     // Testing
     void runTestSuite();
@@ -76,6 +159,21 @@ private:
     void initializeDefaultZones();
     string generateVehicleId();
     string generateRequestId();
+    bool admitRequest(ParkingRequest* request);
+    bool allocateRequest(ParkingRequest* request);
+    void reportAllocation(ParkingRequest* request, ParkingSlot* slot);
+    bool handOffSlot(ParkingSlot* slot);
+    int nearestZoneWithWaiters(int origin, SlotClass slotClass);
+    int activateReservations(time_t now);
+    int expireAllocations(time_t now);
+    bool cancelTracked(ParkingRequest* request, bool unclaimedOnly);
+    void clockLoop();
+    void tick(time_t now);
+    void serveWaitlists();
+    mutex& stripeFor(const string& requestId) const;
+    static long long nowMillis();
+    bool recountCapacity() const;
+    void debugCheckCounters() const;
 };
 
 #endif
\ No newline at end of file
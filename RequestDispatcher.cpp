@@ -0,0 +1,268 @@
+#include "RequestDispatcher.h"
+#include <iostream>
+#include <thread>
+using namespace std;
+
+// ==================== ZoneLane Implementation ====================
+RequestDispatcher::ZoneLane::ZoneLane(const string& zoneId, int ringCapacity)
+    : zoneId(zoneId), ring(ringCapacity), spillCount(0), busy(false) {}
+
+void RequestDispatcher::ZoneLane::push(ParkingRequest* request) {
+    // Lock-free unless the ring is full or earlier requests already spilled
+    if (spillCount.load(memory_order_acquire) == 0 && ring.enqueue(request)) {
+        return;
+    }
+    lock_guard<mutex> guard(spillLock);
+    spill.enqueue(request);
+    spillCount.fetch_add(1, memory_order_release);
+}
+
+ParkingRequest* RequestDispatcher::ZoneLane::pop() {
+    // Everything in the ring arrived before the spill began
+    ParkingRequest* request = ring.dequeue();
+    if (request != nullptr || spillCount.load(memory_order_acquire) == 0) {
+        return request;
+    }
+    lock_guard<mutex> guard(spillLock);
+    request = spill.dequeue();
+    if (request != nullptr) {
+        spillCount.fetch_sub(1, memory_order_release);
+    }
+    return request;
+}
+
+ParkingRequest* RequestDispatcher::ZoneLane::peekAt(int offset) const {
+    int ringSize = ring.getSize();
+    if (offset < ringSize) {
+        return ring.peekAt(offset);
+    }
+    lock_guard<mutex> guard(spillLock);
+    return spill.peekAt(offset - ringSize);
+}
+
+int RequestDispatcher::ZoneLane::getSize() const {
+    return ring.getSize() + spillCount.load(memory_order_acquire);
+}
+
+// ==================== RequestDispatcher Implementation ====================
+RequestDispatcher::RequestDispatcher(int laneRingCapacity, int initialLanes)
+    : laneCount(0), laneRingCapacity(laneRingCapacity), nextSequence(0), pendingCount(0) {
+    maxLanes = (initialLanes > 1) ? initialLanes : 2;
+    lanes = new ZoneLane*[maxLanes];
+    
+    // Lane 0 takes requests for zones without a lane of their own
+    lanes[laneCount++] = new ZoneLane("", laneRingCapacity);
+}
+
+RequestDispatcher::~RequestDispatcher() {
+    for (int i = 0; i < laneCount; i++) {
+        delete lanes[i];
+    }
+    delete[] lanes;
+}
+
+bool RequestDispatcher::addZone(const string& zoneId) {
+    if (laneIndex.find(zoneId) != nullptr) {
+        return false;
+    }
+    
+    if (laneCount == maxLanes) {
+        ZoneLane** grown = new ZoneLane*[maxLanes * 2];
+        for (int i = 0; i < laneCount; i++) {
+            grown[i] = lanes[i];
+        }
+        delete[] lanes;
+        lanes = grown;
+        maxLanes *= 2;
+    }
+    
+    laneIndex.insert(zoneId, laneCount);
+    lanes[laneCount++] = new ZoneLane(zoneId, laneRingCapacity);
+    return true;
+}
+
+void RequestDispatcher::enqueue(ParkingRequest* request) {
+    ZoneLane* lane = findLane(request->getRequestedZoneId());
+    if (lane == nullptr) {
+        lane = lanes[0];
+    }
+    
+    request->setIntakeSequence(nextSequence.fetch_add(1, memory_order_relaxed));
+    
+    // Count first so a fast consumer never drives the total negative
+    pendingCount.fetch_add(1, memory_order_relaxed);
+    lane->push(request);
+}
+
+ParkingRequest* RequestDispatcher::dequeueFrom(ZoneLane* lane) {
+    ParkingRequest* request = lane->pop();
+    if (request != nullptr) {
+        pendingCount.fetch_sub(1, memory_order_relaxed);
+    }
+    return request;
+}
+
+ParkingRequest* RequestDispatcher::dequeueOldest() {
+    while (true) {
+        ZoneLane* oldestLane = nullptr;
+        unsigned long long oldestSequence = 0;
+        
+        for (int i = 0; i < laneCount; i++) {
+            ParkingRequest* head = lanes[i]->peekAt(0);
+            if (head != nullptr && (oldestLane == nullptr || head->getIntakeSequence() < oldestSequence)) {
+                oldestLane = lanes[i];
+                oldestSequence = head->getIntakeSequence();
+            }
+        }
+        
+        if (oldestLane == nullptr) {
+            // pendingCount is raised before a producer publishes, so a
+            // positive count here means an enqueue is still in flight and
+            // may be hiding requests published behind it
+            if (getPendingCount() == 0) {
+                return nullptr;
+            }
+            this_thread::yield();
+            continue;
+        }
+        
+        // A concurrent caller may have emptied the lane since the scan;
+        // rescan rather than report "no pending requests" while others wait
+        ParkingRequest* request = dequeueFrom(oldestLane);
+        if (request != nullptr) {
+            return request;
+        }
+    }
+}
+
+int RequestDispatcher::dequeueOldestBatch(ParkingRequest** requests, int maxCount) {
+    if (maxCount <= 0) {
+        return 0;
+    }
+    
+    // The first request goes through dequeueOldest, which waits out
+    // enqueues still in flight instead of reporting an empty queue
+    requests[0] = dequeueOldest();
+    if (requests[0] == nullptr) {
+        return 0;
+    }
+    int count = 1;
+    
+    // Min-heap of lane positions keyed by their head's intake sequence.
+    // Requests published after the snapshot carry newer sequences than
+    // every head in it, so they can wait for the next batch.
+    int* heap = new int[laneCount];
+    unsigned long long* headSequence = new unsigned long long[laneCount];
+    int heapSize = 0;
+    
+    for (int i = 0; i < laneCount; i++) {
+        ParkingRequest* head = lanes[i]->peekAt(0);
+        if (head == nullptr) {
+            continue;
+        }
+        headSequence[i] = head->getIntakeSequence();
+        
+        int index = heapSize++;
+        while (index > 0 && headSequence[heap[(index - 1) / 2]] > headSequence[i]) {
+            heap[index] = heap[(index - 1) / 2];
+            index = (index - 1) / 2;
+        }
+        heap[index] = i;
+    }
+    
+    while (count < maxCount && heapSize > 0) {
+        int lane = heap[0];
+        ParkingRequest* request = dequeueFrom(lanes[lane]);
+        if (request != nullptr) {
+            requests[count++] = request;
+        }
+        
+        // Re-key the lane with its next head, or drop it once it is empty
+        ParkingRequest* head = (request != nullptr) ? lanes[lane]->peekAt(0) : nullptr;
+        if (head != nullptr) {
+            headSequence[lane] = head->getIntakeSequence();
+        } else {
+            lane = heap[--heapSize];
+        }
+        
+        int index = 0;
+        while (heapSize > 0) {
+            int child = 2 * index + 1;
+            if (child >= heapSize) {
+                break;
+            }
+            if (child + 1 < heapSize && headSequence[heap[child + 1]] < headSequence[heap[child]]) {
+                child++;
+            }
+            if (headSequence[heap[child]] >= headSequence[lane]) {
+                break;
+            }
+            heap[index] = heap[child];
+            index = child;
+        }
+        if (heapSize > 0) {
+            heap[index] = lane;
+        }
+    }
+    
+    delete[] headSequence;
+    delete[] heap;
+    return count;
+}
+
+RequestDispatcher::ZoneLane* RequestDispatcher::findLane(const string& zoneId) {
+    int* index = laneIndex.find(zoneId);
+    return (index != nullptr) ? lanes[*index] : nullptr;
+}
+
+RequestDispatcher::ZoneLane* RequestDispatcher::getLaneAt(int index) const {
+    if (index < 0 || index >= laneCount) {
+        return nullptr;
+    }
+    return lanes[index];
+}
+
+int RequestDispatcher::getLaneCount() const {
+    return laneCount;
+}
+
+int RequestDispatcher::getPendingCount() const {
+    int pending = pendingCount.load(memory_order_relaxed);
+    return (pending > 0) ? pending : 0;
+}
+
+void RequestDispatcher::displayQueues(bool detailed) const {
+    cout << "\n=== PENDING REQUESTS QUEUE ===" << endl;
+    cout << "Queue Size: " << getPendingCount() << " across " << (laneCount - 1) << " zone queues" << endl;
+    
+    if (getPendingCount() == 0) {
+        cout << "Queue is empty." << endl;
+        return;
+    }
+    
+    for (int i = 0; i < laneCount; i++) {
+        const ZoneLane* lane = lanes[i];
+        int size = lane->getSize();
+        if (size == 0) {
+            continue;
+        }
+        
+        cout << "\nZone " << (lane->zoneId.empty() ? "(unknown zones)" : lane->zoneId)
+             << ": " << size << " pending" << endl;
+        if (!detailed) {
+            continue;
+        }
+        
+        for (int j = 0; j < size; j++) {
+            ParkingRequest* request = lane->peekAt(j);
+            if (request == nullptr) {
+                break;
+            }
+            cout << "  " << (j + 1) << ". ";
+            cout << "Request ID: " << request->getRequestId();
+            cout << ", Vehicle: " << request->getVehicle()->getVehicleId();
+            cout << ", Zone: " << request->getRequestedZoneId();
+            cout << ", State: " << request->stateToString() << endl;
+        }
+    }
+}
\ No newline at end of file
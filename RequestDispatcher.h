@@ -0,0 +1,82 @@
+#ifndef REQUESTDISPATCHER_H
+#define REQUESTDISPATCHER_H
+
+#include "ParkingRequest.h"
+#include "ConcurrentRequestQueue.h"
+#include "RequestQueue.h"
+#include "HashIndex.h"
+#include <string>
+#include <atomic>
+#include <mutex>
+using namespace std;
+
+// Pending requests partitioned into one lane per zone, keyed by
+// ParkingRequest::getRequestedZoneId(). Lane 0 collects requests for zones
+// that have no lane of their own. Every request is stamped with a global
+// intake sequence so a single consumer can still serve them in arrival order.
+class RequestDispatcher {
+public:
+    // A lane is a lock-free ring until the ring fills. Later requests spill
+    // into a growable RequestQueue under spillLock, and new arrivals keep
+    // going there until it drains, so the lane stays FIFO and never
+    // refuses a request.
+    struct ZoneLane {
+        string zoneId;
+        ConcurrentRequestQueue ring;
+        RequestQueue spill;
+        mutable mutex spillLock;
+        atomic<int> spillCount; // spill's size, readable without the lock
+        atomic<bool> busy; // Held by the worker draining this lane; keeps zone order
+        
+        ZoneLane(const string& zoneId, int ringCapacity);
+        
+        void push(ParkingRequest* request);
+        ParkingRequest* pop();                    // nullptr when empty
+        ParkingRequest* peekAt(int offset) const; // Only exact while no other thread uses the lane
+        int getSize() const;
+    };
+    
+private:
+    ZoneLane** lanes;
+    int laneCount;
+    int maxLanes;
+    int laneRingCapacity;
+    HashIndex<int> laneIndex; // zoneId -> lane position
+    
+    atomic<unsigned long long> nextSequence;
+    atomic<int> pendingCount;
+    
+public:
+    RequestDispatcher(int laneRingCapacity = 4096, int initialLanes = 16);
+    ~RequestDispatcher();
+    
+    // Topology; must not run while workers are draining lanes
+    bool addZone(const string& zoneId);
+    
+    // Safe to call from any number of threads
+    void enqueue(ParkingRequest* request); // Lanes are unbounded
+    ParkingRequest* dequeueFrom(ZoneLane* lane);
+    
+    // Single-consumer path: oldest request across all lanes, O(lanes)
+    ParkingRequest* dequeueOldest();
+    
+    // Up to maxCount requests in the same order as repeated dequeueOldest
+    // calls, merging the lane heads through a heap: O(lanes + n log lanes)
+    int dequeueOldestBatch(ParkingRequest** requests, int maxCount);
+    
+    // Accessors
+    ZoneLane* findLane(const string& zoneId);
+    ZoneLane* getLaneAt(int index) const;
+    int getLaneCount() const;
+    int getPendingCount() const;
+    
+    // Utility
+    void displayQueues(bool detailed) const;
+    
+private:
+    // Non-copyable: owns its lanes
+    RequestDispatcher(const RequestDispatcher&);
+    RequestDispatcher& operator=(const RequestDispatcher&);
+};
+
+#endif
\ No newline at end of file
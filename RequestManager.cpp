@@ -1,17 +1,34 @@
 #include "RequestManager.h"
 #include <iostream>
 #include <iomanip>
+#include <functional>
 using namespace std;
 
 // ==================== RequestNode Implementation ====================
 RequestNode::RequestNode(ParkingRequest* req) 
-    : request(req), next(nullptr) {}
+    : request(req), prev(nullptr), next(nullptr), prevInState(nullptr), nextInState(nullptr) {}
+
+// ==================== ZoneDurationStats Implementation ====================
+ZoneDurationStats::ZoneDurationStats(const string& zoneId) : zoneId(zoneId) {}
 
 // ==================== RequestManager Implementation ====================
-RequestManager::RequestManager() : head(nullptr), tail(nullptr), requestCount(0) {}
+RequestManager::RequestManager() 
+    : head(nullptr), tail(nullptr), requestCount(0),
+      zoneStatsCount(0), zoneStatsCapacity(8), stateObserver(nullptr) {
+    zoneStats = new ZoneDurationStats*[zoneStatsCapacity];
+    for (int i = 0; i < REQUEST_STATE_COUNT; i++) {
+        stateHeads[i] = nullptr;
+        stateTails[i] = nullptr;
+        stateCounts[i] = 0;
+    }
+}
 
 RequestManager::~RequestManager() {
     clearList();
+    for (int i = 0; i < zoneStatsCount; i++) {
+        delete zoneStats[i];
+    }
+    delete[] zoneStats;
 }
 
 void RequestManager::clearList() {
@@ -25,6 +42,110 @@ void RequestManager::clearList() {
     head = nullptr;
     tail = nullptr;
     requestCount = 0;
+    for (int i = 0; i < INDEX_SHARDS; i++) {
+        requestIndex[i].clear();
+    }
+    for (int i = 0; i < REQUEST_STATE_COUNT; i++) {
+        stateHeads[i] = nullptr;
+        stateTails[i] = nullptr;
+        stateCounts[i] = 0;
+    }
+}
+
+int RequestManager::shardOf(const string& requestId) {
+    return (int)(hash<string>()(requestId) & (INDEX_SHARDS - 1));
+}
+
+RequestNode* RequestManager::findNode(const string& requestId) const {
+    int shard = shardOf(requestId);
+    lock_guard<mutex> guard(indexLocks[shard]);
+    RequestNode* const* node = requestIndex[shard].find(requestId);
+    return (node != nullptr) ? *node : nullptr;
+}
+
+void RequestManager::linkIntoState(RequestNode* node, RequestState state) {
+    int s = (int)state;
+    node->prevInState = stateTails[s];
+    node->nextInState = nullptr;
+    if (stateTails[s] != nullptr) {
+        stateTails[s]->nextInState = node;
+    } else {
+        stateHeads[s] = node;
+    }
+    stateTails[s] = node;
+    stateCounts[s]++;
+}
+
+void RequestManager::unlinkFromState(RequestNode* node, RequestState state) {
+    int s = (int)state;
+    if (node->prevInState != nullptr) {
+        node->prevInState->nextInState = node->nextInState;
+    } else {
+        stateHeads[s] = node->nextInState;
+    }
+    if (node->nextInState != nullptr) {
+        node->nextInState->prevInState = node->prevInState;
+    } else {
+        stateTails[s] = node->prevInState;
+    }
+    node->prevInState = nullptr;
+    node->nextInState = nullptr;
+    stateCounts[s]--;
+}
+
+void RequestManager::onRequestStateChanged(ParkingRequest* request, RequestState previousState) {
+    RequestNode* node = findNode(request->getRequestId());
+    if (node == nullptr) {
+        return;
+    }
+    
+    {
+        lock_guard<mutex> guard(listLock);
+        unlinkFromState(node, previousState);
+        linkIntoState(node, request->getCurrentState());
+        
+        if (request->getCurrentState() == RequestState::RELEASED) {
+            recordDuration(request);
+        }
+    }
+    
+    // Outside listLock, which is never held while taking another lock
+    if (stateObserver != nullptr) {
+        stateObserver->onRequestStateChanged(request, previousState);
+    }
+}
+
+void RequestManager::setStateObserver(RequestStateListener* observer) {
+    stateObserver = observer;
+}
+
+void RequestManager::recordDuration(ParkingRequest* request) {
+    double minutes = request->calculateDuration();
+    durationStats.add(minutes);
+    
+    // Attribute the stay to the zone the vehicle actually parked in
+    ParkingSlot* slot = request->getAllocatedSlot();
+    string zoneId = (slot != nullptr) ? slot->getZoneId() : request->getRequestedZoneId();
+    
+    int* index = zoneStatsIndex.find(zoneId);
+    if (index == nullptr) {
+        if (zoneStatsCount >= zoneStatsCapacity) {
+            int newCapacity = zoneStatsCapacity * 2;
+            ZoneDurationStats** newStats = new ZoneDurationStats*[newCapacity];
+            for (int i = 0; i < zoneStatsCount; i++) {
+                newStats[i] = zoneStats[i];
+            }
+            delete[] zoneStats;
+            zoneStats = newStats;
+            zoneStatsCapacity = newCapacity;
+        }
+        zoneStats[zoneStatsCount] = new ZoneDurationStats(zoneId);
+        zoneStatsIndex.insert(zoneId, zoneStatsCount);
+        zoneStatsCount++;
+        index = zoneStatsIndex.find(zoneId);
+    }
+    
+    zoneStats[*index]->stats.add(minutes);
 }
 
 bool RequestManager::addRequest(ParkingRequest* request) {
@@ -33,76 +154,108 @@ bool RequestManager::addRequest(ParkingRequest* request) {
         return false;
     }
     
+    string requestId = request->getRequestId();
+    int shard = shardOf(requestId);
     RequestNode* newNode = new RequestNode(request);
     
-    if (head == nullptr) {
-        head = newNode;
-        tail = newNode;
-    } else {
-        tail->next = newNode;
-        tail = newNode;
+    // Link before publishing in the index: once findRequest can return the
+    // request, state changes expect it to be on its state list
+    {
+        lock_guard<mutex> guard(listLock);
+        if (head == nullptr) {
+            head = newNode;
+            tail = newNode;
+        } else {
+            newNode->prev = tail;
+            tail->next = newNode;
+            tail = newNode;
+        }
+        linkIntoState(newNode, request->getCurrentState());
+        requestCount++;
     }
     
-    requestCount++;
+    request->setStateListener(this);
+    bool inserted;
+    {
+        lock_guard<mutex> guard(indexLocks[shard]);
+        inserted = requestIndex[shard].insert(requestId, newNode);
+    }
+    
+    if (!inserted) {
+        // Duplicate ID: take the node back out, the request stays with the caller
+        request->setStateListener(nullptr);
+        lock_guard<mutex> guard(listLock);
+        unlinkFromState(newNode, request->getCurrentState());
+        if (newNode->prev != nullptr) {
+            newNode->prev->next = newNode->next;
+        } else {
+            head = newNode->next;
+        }
+        if (newNode->next != nullptr) {
+            newNode->next->prev = newNode->prev;
+        } else {
+            tail = newNode->prev;
+        }
+        requestCount--;
+        delete newNode;
+        cout << "Error: Request " << requestId << " already exists." << endl;
+        return false;
+    }
     return true;
 }
 
 ParkingRequest* RequestManager::findRequest(const string& requestId) {
-    RequestNode* current = head;
-    while (current != nullptr) {
-        if (current->request->getRequestId() == requestId) {
-            return current->request;
-        }
-        current = current->next;
-    }
-    return nullptr;
+    RequestNode* node = findNode(requestId);
+    return (node != nullptr) ? node->request : nullptr;
 }
 
 bool RequestManager::removeRequest(const string& requestId) {
-    if (head == nullptr) {
-        return false;
-    }
+    int shard = shardOf(requestId);
+    RequestNode* node = nullptr;
     
-    // Special case: head node
-    if (head->request->getRequestId() == requestId) {
-        RequestNode* temp = head;
-        head = head->next;
-        if (head == nullptr) {
-            tail = nullptr;
+    {
+        lock_guard<mutex> guard(indexLocks[shard]);
+        RequestNode** found = requestIndex[shard].find(requestId);
+        if (found == nullptr) {
+            return false;
         }
-        delete temp->request;
-        delete temp;
-        requestCount--;
-        return true;
+        node = *found;
+        requestIndex[shard].remove(requestId);
     }
     
-    // Search for node to delete
-    RequestNode* current = head;
-    while (current->next != nullptr) {
-        if (current->next->request->getRequestId() == requestId) {
-            RequestNode* temp = current->next;
-            current->next = temp->next;
-            
-            if (temp == tail) {
-                tail = current;
-            }
-            
-            delete temp->request;
-            delete temp;
-            requestCount--;
-            return true;
-        }
-        current = current->next;
+    // Unlink in O(1) using the node's neighbours
+    lock_guard<mutex> guard(listLock);
+    unlinkFromState(node, node->request->getCurrentState());
+    
+    if (node->prev != nullptr) {
+        node->prev->next = node->next;
+    } else {
+        head = node->next;
+    }
+    
+    if (node->next != nullptr) {
+        node->next->prev = node->prev;
+    } else {
+        tail = node->prev;
     }
     
-    return false;
+    delete node->request;
+    delete node;
+    requestCount--;
+    return true;
 }
 
 int RequestManager::getRequestCount() const {
+    lock_guard<mutex> guard(listLock);
     return requestCount;
 }
 
+RequestNode* RequestManager::getFirstInState(RequestState state) const {
+    return stateHeads[(int)state];
+}
+
 void RequestManager::displayAllRequests() const {
+    lock_guard<mutex> guard(listLock);
     cout << "\n=== ALL PARKING REQUESTS (" << requestCount << ") ===" << endl;
     
     if (head == nullptr) {
@@ -122,20 +275,25 @@ void RequestManager::displayAllRequests() const {
 }
 
 void RequestManager::displayActiveRequests() const {
+    lock_guard<mutex> guard(listLock);
     cout << "\n=== ACTIVE PARKING REQUESTS ===" << endl;
     
-    RequestNode* current = head;
+    // Walk only the active state lists, never the released/cancelled history
+    const RequestState activeStates[] = {
+        RequestState::REQUESTED, RequestState::ALLOCATED, RequestState::OCCUPIED
+    };
     int activeCount = 0;
     int counter = 1;
     
-    while (current != nullptr) {
-        if (current->request->isActive()) {
+    for (RequestState state : activeStates) {
+        RequestNode* current = stateHeads[(int)state];
+        while (current != nullptr) {
             cout << "\n" << counter << ". ";
             current->request->displayRequestInfo();
             activeCount++;
             counter++;
+            current = current->nextInState;
         }
-        current = current->next;
     }
     
     if (activeCount == 0) {
@@ -146,28 +304,22 @@ void RequestManager::displayActiveRequests() const {
 }
 
 void RequestManager::displayRequestHistory() const {
+    lock_guard<mutex> guard(listLock);
     cout << "\n=== REQUEST HISTORY ===" << endl;
     
     RequestNode* current = head;
-    int completed = 0;
-    int cancelled = 0;
-    int active = 0;
+    int completed = stateCounts[(int)RequestState::RELEASED];
+    int cancelled = stateCounts[(int)RequestState::CANCELLED];
+    int active = stateCounts[(int)RequestState::REQUESTED] + 
+                 stateCounts[(int)RequestState::ALLOCATED] + 
+                 stateCounts[(int)RequestState::OCCUPIED];
     int counter = 1;
     
-    // First pass: count statistics
-    while (current != nullptr) {
-        RequestState state = current->request->getCurrentState();
-        if (state == RequestState::RELEASED) completed++;
-        else if (state == RequestState::CANCELLED) cancelled++;
-        else if (current->request->isActive()) active++;
-        current = current->next;
-    }
-    
     cout << "Total Requests: " << requestCount << endl;
     cout << "Completed: " << completed << endl;
     cout << "Cancelled: " << cancelled << endl;
     cout << "Active: " << active << endl;
-    cout << "Average Duration: " << fixed << setprecision(2) << getAverageDuration() << " minutes" << endl;
+    cout << "Average Duration: " << fixed << setprecision(2) << durationStats.getMean() << " minutes" << endl;
     
     // Display all requests
     current = head;
@@ -190,35 +342,41 @@ void RequestManager::displayRequestHistory() const {
 }
 
 int RequestManager::countByState(RequestState state) const {
-    int count = 0;
-    RequestNode* current = head;
-    
-    while (current != nullptr) {
-        if (current->request->getCurrentState() == state) {
-            count++;
-        }
-        current = current->next;
-    }
-    
-    return count;
+    lock_guard<mutex> guard(listLock);
+    return stateCounts[(int)state];
 }
 
 double RequestManager::getAverageDuration() const {
-    RequestNode* current = head;
-    double totalDuration = 0.0;
-    int completedCount = 0;
-    
-    while (current != nullptr) {
-        if (current->request->getCurrentState() == RequestState::RELEASED) {
-            totalDuration += current->request->calculateDuration();
-            completedCount++;
-        }
-        current = current->next;
-    }
+    lock_guard<mutex> guard(listLock);
+    return durationStats.getMean();
+}
+
+const DurationStats& RequestManager::getDurationStats() const {
+    return durationStats;
+}
+
+const DurationStats* RequestManager::getZoneDurationStats(const string& zoneId) const {
+    lock_guard<mutex> guard(listLock);
+    const int* index = zoneStatsIndex.find(zoneId);
+    return (index != nullptr) ? &zoneStats[*index]->stats : nullptr;
+}
+
+void RequestManager::displayDurationStatistics() const {
+    lock_guard<mutex> guard(listLock);
+    cout << fixed << setprecision(2);
+    cout << "Completed Stays: " << durationStats.getCount() << endl;
+    cout << "Mean: " << durationStats.getMean() << " min"
+         << ", Std Dev: " << durationStats.getStdDev() << " min" << endl;
+    cout << "p50: " << durationStats.getPercentile(50)
+         << " min, p90: " << durationStats.getPercentile(90)
+         << " min, p99: " << durationStats.getPercentile(99) << " min" << endl;
     
-    if (completedCount == 0) {
-        return 0.0;
+    for (int i = 0; i < zoneStatsCount; i++) {
+        const DurationStats& stats = zoneStats[i]->stats;
+        cout << "  Zone " << zoneStats[i]->zoneId << ": " << stats.getCount() << " stays"
+             << ", mean " << stats.getMean()
+             << ", p50 " << stats.getPercentile(50)
+             << ", p90 " << stats.getPercentile(90)
+             << ", p99 " << stats.getPercentile(99) << " min" << endl;
     }
-    
-    return totalDuration / completedCount;
 }
\ No newline at end of file
@@ -2,22 +2,58 @@
 #define REQUESTMANAGER_H
 
 #include "ParkingRequest.h"
+#include "HashIndex.h"
+#include "DurationStats.h"
 #include <string>
+#include <mutex>
 using namespace std;
 
-// Node for linked list
+// Node for doubly linked list, also threaded on an intrusive per-state list
 struct RequestNode {
     ParkingRequest* request;
+    RequestNode* prev;
     RequestNode* next;
+    RequestNode* prevInState;
+    RequestNode* nextInState;
     
     RequestNode(ParkingRequest* req);
 };
 
-class RequestManager {
+// Duration statistics for one zone
+struct ZoneDurationStats {
+    string zoneId;
+    DurationStats stats;
+    
+    ZoneDurationStats(const string& zoneId);
+};
+
+// Safe to use from several threads. Lookups go through a sharded index so
+// they only contend per shard; the lists, counters and statistics share
+// one short-held lock. Neither lock is held while taking the other.
+class RequestManager : public RequestStateListener {
 private:
+    static const int INDEX_SHARDS = 16;
+    
     RequestNode* head;
     RequestNode* tail;
     int requestCount;
+    HashIndex<RequestNode*> requestIndex[INDEX_SHARDS]; // requestId -> node, kept in sync with the list
+    mutable mutex indexLocks[INDEX_SHARDS];
+    mutable mutex listLock; // Everything below, plus head/tail/requestCount
+    
+    // Per-state lists and counters, updated on every transition
+    RequestNode* stateHeads[REQUEST_STATE_COUNT];
+    RequestNode* stateTails[REQUEST_STATE_COUNT];
+    int stateCounts[REQUEST_STATE_COUNT];
+    
+    // Streaming duration statistics, fed once per release
+    DurationStats durationStats;
+    ZoneDurationStats** zoneStats;     // Growable array, one entry per zone seen
+    int zoneStatsCount;
+    int zoneStatsCapacity;
+    HashIndex<int> zoneStatsIndex;     // zoneId -> position in zoneStats
+    
+    RequestStateListener* stateObserver; // Told of every transition after the lists; set before use
     
 public:
     RequestManager();
@@ -28,8 +64,11 @@ public:
     ParkingRequest* findRequest(const string& requestId);
     bool removeRequest(const string& requestId);
     
+    void setStateObserver(RequestStateListener* observer);
+    
     // Getters
     int getRequestCount() const;
+    RequestNode* getFirstInState(RequestState state) const; // Follow nextInState to iterate; single-threaded use only
     
     // Display functions
     void displayAllRequests() const;
@@ -39,9 +78,20 @@ public:
     // Statistics
     int countByState(RequestState state) const;
     double getAverageDuration() const;
+    const DurationStats& getDurationStats() const; // Snapshot views: only stable while no
+    const DurationStats* getZoneDurationStats(const string& zoneId) const; // request is being released
+    void displayDurationStatistics() const;
+    
+    // RequestStateListener
+    void onRequestStateChanged(ParkingRequest* request, RequestState previousState) override;
     
 private:
+    static int shardOf(const string& requestId);
+    RequestNode* findNode(const string& requestId) const;
     void clearList();
+    void linkIntoState(RequestNode* node, RequestState state);
+    void unlinkFromState(RequestNode* node, RequestState state);
+    void recordDuration(ParkingRequest* request);
 };
 
 #endif
\ No newline at end of file
@@ -2,22 +2,33 @@
 #include <iostream>
 using namespace std;
 
-RequestQueue::RequestQueue(int maxSize) 
-    : front(nullptr), rear(nullptr), queueSize(0), maxSize(maxSize) {}
+RequestQueue::RequestQueue(int initialCapacity, int maxSize)
+    : head(0), queueSize(0), maxSize(maxSize) {
+    capacity = 16;
+    while (capacity < initialCapacity) {
+        capacity *= 2;
+    }
+    buffer = new ParkingRequest*[capacity];
+}
 
 RequestQueue::~RequestQueue() {
-    clearQueue();
+    // Note: We don't delete request objects as they're managed elsewhere
+    delete[] buffer;
 }
 
-void RequestQueue::clearQueue() {
-    while (!isEmpty()) {
-        QueueNode* temp = front;
-        front = front->next;
-        // Note: We don't delete request object as it's managed elsewhere
-        delete temp;
+void RequestQueue::grow() {
+    int newCapacity = capacity * 2;
+    ParkingRequest** newBuffer = new ParkingRequest*[newCapacity];
+    
+    // Unwrap so the front lands at index 0
+    for (int i = 0; i < queueSize; i++) {
+        newBuffer[i] = buffer[(head + i) & (capacity - 1)];
     }
-    rear = nullptr;
-    queueSize = 0;
+    
+    delete[] buffer;
+    buffer = newBuffer;
+    capacity = newCapacity;
+    head = 0;
 }
 
 bool RequestQueue::enqueue(ParkingRequest* request) {
@@ -26,15 +37,27 @@ bool RequestQueue::enqueue(ParkingRequest* request) {
         return false;
     }
     
-    QueueNode* newNode = new QueueNode(request);
+    if (queueSize == capacity) {
+        grow();
+    }
     
-    if (isEmpty()) {
-        front = rear = newNode;
-    } else {
-        rear->next = newNode;
-        rear = newNode;
+    buffer[(head + queueSize) & (capacity - 1)] = request;
+    queueSize++;
+    return true;
+}
+
+bool RequestQueue::enqueueFront(ParkingRequest* request) {
+    if (isFull()) {
+        cout << "Error: Request queue is full. Cannot add more requests." << endl;
+        return false;
     }
     
+    if (queueSize == capacity) {
+        grow();
+    }
+    
+    head = (head - 1) & (capacity - 1);
+    buffer[head] = request;
     queueSize++;
     return true;
 }
@@ -44,15 +67,8 @@ ParkingRequest* RequestQueue::dequeue() {
         return nullptr;
     }
     
-    QueueNode* temp = front;
-    ParkingRequest* request = temp->request;
-    
-    front = front->next;
-    if (front == nullptr) {
-        rear = nullptr;
-    }
-    
-    delete temp;
+    ParkingRequest* request = buffer[head];
+    head = (head + 1) & (capacity - 1);
     queueSize--;
     return request;
 }
@@ -61,45 +77,57 @@ ParkingRequest* RequestQueue::peek() const {
     if (isEmpty()) {
         return nullptr;
     }
-    return front->request;
+    return buffer[head];
+}
+
+ParkingRequest* RequestQueue::peekAt(int offset) const {
+    if (offset < 0 || offset >= queueSize) {
+        return nullptr;
+    }
+    return buffer[(head + offset) & (capacity - 1)];
 }
 
 bool RequestQueue::isEmpty() const {
-    return front == nullptr;
+    return queueSize == 0;
 }
 
 bool RequestQueue::isFull() const {
-    return queueSize >= maxSize;
+    return maxSize > 0 && queueSize >= maxSize;
 }
 
 int RequestQueue::getSize() const {
     return queueSize;
 }
 
+int RequestQueue::getCapacity() const {
+    return capacity;
+}
+
 void RequestQueue::displayQueue() const {
     cout << "\n=== PENDING REQUESTS QUEUE ===" << endl;
-    cout << "Queue Size: " << queueSize << "/" << maxSize << endl;
+    if (maxSize > 0) {
+        cout << "Queue Size: " << queueSize << "/" << maxSize << endl;
+    } else {
+        cout << "Queue Size: " << queueSize << " (unbounded)" << endl;
+    }
     
     if (isEmpty()) {
         cout << "Queue is empty." << endl;
         return;
     }
     
-    QueueNode* current = front;
-    int counter = 1;
-    
-    while (current != nullptr) {
-        cout << "\n" << counter << ". ";
-        cout << "Request ID: " << current->request->getRequestId();
-        cout << ", Vehicle: " << current->request->getVehicle()->getVehicleId();
-        cout << ", Zone: " << current->request->getRequestedZoneId();
-        cout << ", State: " << current->request->stateToString();
-        current = current->next;
-        counter++;
+    for (int i = 0; i < queueSize; i++) {
+        ParkingRequest* request = buffer[(head + i) & (capacity - 1)];
+        cout << "\n" << (i + 1) << ". ";
+        cout << "Request ID: " << request->getRequestId();
+        cout << ", Vehicle: " << request->getVehicle()->getVehicleId();
+        cout << ", Zone: " << request->getRequestedZoneId();
+        cout << ", State: " << request->stateToString();
     }
     cout << endl;
 }
 
 void RequestQueue::clear() {
-    clearQueue();
+    head = 0;
+    queueSize = 0;
 }
\ No newline at end of file
@@ -5,38 +5,42 @@
 #include <string>
 using namespace std;
 
+// FIFO of pending requests stored in a contiguous ring buffer.
+// The buffer doubles when full, so enqueue/dequeue never allocate per
+// element; maxSize = 0 leaves the queue unbounded.
 class RequestQueue {
 private:
-    struct QueueNode {
-        ParkingRequest* request;
-        QueueNode* next;
-        
-        QueueNode(ParkingRequest* req) : request(req), next(nullptr) {}
-    };
-    
-    QueueNode* front;
-    QueueNode* rear;
+    ParkingRequest** buffer;
+    int capacity;  // Always a power of two
+    int head;      // Index of the front element
     int queueSize;
     int maxSize;
     
 public:
-    RequestQueue(int maxSize = 100);
+    RequestQueue(int initialCapacity = 64, int maxSize = 0);
     ~RequestQueue();
     
     // Queue operations
     bool enqueue(ParkingRequest* request);
+    bool enqueueFront(ParkingRequest* request); // Put back at the head, O(1)
     ParkingRequest* dequeue();
     ParkingRequest* peek() const;
+    ParkingRequest* peekAt(int offset) const; // offset 0 is the front
     bool isEmpty() const;
     bool isFull() const;
     int getSize() const;
+    int getCapacity() const;
     
     // Utility
     void displayQueue() const;
     void clear();
     
 private:
-    void clearQueue();
+    void grow();
+    
+    // Non-copyable: owns its buffer
+    RequestQueue(const RequestQueue&);
+    RequestQueue& operator=(const RequestQueue&);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,270 @@
+#include "RequestScheduler.h"
+#include <iostream>
+using namespace std;
+
+RequestScheduler::RequestScheduler(int initialCapacity)
+    : heapSize(0), nextSequence(0) {
+    capacity = (initialCapacity > 0) ? initialCapacity : 64;
+    heap = new HeapEntry[capacity];
+    
+    // Default head starts: a permit holder counts as having waited
+    // 5 minutes longer than a walk-in, a disabled driver 15 minutes
+    classHeadStart[(int)PriorityClass::STANDARD] = 0;
+    classHeadStart[(int)PriorityClass::PERMIT] = 5 * 60 * 1000LL;
+    classHeadStart[(int)PriorityClass::ACCESSIBLE] = 15 * 60 * 1000LL;
+}
+
+RequestScheduler::~RequestScheduler() {
+    delete[] heap;
+}
+
+bool RequestScheduler::before(const HeapEntry& a, const HeapEntry& b) {
+    if (a.key != b.key) {
+        return a.key < b.key;
+    }
+    return a.sequence < b.sequence;
+}
+
+long long RequestScheduler::keyFor(PriorityClass priority, long long arrivalMillis) const {
+    return arrivalMillis - classHeadStart[(int)priority];
+}
+
+void RequestScheduler::grow() {
+    int newCapacity = capacity * 2;
+    HeapEntry* newHeap = new HeapEntry[newCapacity];
+    for (int i = 0; i < heapSize; i++) {
+        newHeap[i] = heap[i];
+    }
+    delete[] heap;
+    heap = newHeap;
+    capacity = newCapacity;
+}
+
+void RequestScheduler::place(int index, const HeapEntry& entry) {
+    heap[index] = entry;
+    entry.request->setSchedulerPosition(index);
+}
+
+void RequestScheduler::siftUp(int index) {
+    HeapEntry entry = heap[index];
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (!before(entry, heap[parent])) {
+            break;
+        }
+        place(index, heap[parent]);
+        index = parent;
+    }
+    place(index, entry);
+}
+
+void RequestScheduler::siftDown(int index) {
+    HeapEntry entry = heap[index];
+    while (true) {
+        int child = 2 * index + 1;
+        if (child >= heapSize) {
+            break;
+        }
+        if (child + 1 < heapSize && before(heap[child + 1], heap[child])) {
+            child++;
+        }
+        if (!before(heap[child], entry)) {
+            break;
+        }
+        place(index, heap[child]);
+        index = child;
+    }
+    place(index, entry);
+}
+
+bool RequestScheduler::enqueue(ParkingRequest* request, long long arrivalMillis) {
+    if (request == nullptr) {
+        cout << "Error: Cannot schedule a null request." << endl;
+        return false;
+    }
+    
+    lock_guard<mutex> guard(heapLock);
+    if (!queuedById.insert(request->getRequestId(), request)) {
+        cout << "Error: Request " << request->getRequestId() << " is already scheduled." << endl;
+        return false;
+    }
+    
+    if (heapSize == capacity) {
+        grow();
+    }
+    
+    HeapEntry entry;
+    entry.key = keyFor(request->getPriorityClass(), arrivalMillis);
+    entry.sequence = nextSequence++;
+    entry.arrivalMillis = arrivalMillis;
+    entry.request = request;
+    request->setIntakeSequence(entry.sequence);
+    
+    place(heapSize, entry);
+    heapSize++;
+    siftUp(heapSize - 1);
+    return true;
+}
+
+ParkingRequest* RequestScheduler::dequeue() {
+    lock_guard<mutex> guard(heapLock);
+    if (heapSize == 0) {
+        return nullptr;
+    }
+    
+    ParkingRequest* request = heap[0].request;
+    heapSize--;
+    if (heapSize > 0) {
+        place(0, heap[heapSize]);
+        siftDown(0);
+    }
+    
+    request->setSchedulerPosition(-1);
+    queuedById.remove(request->getRequestId());
+    return request;
+}
+
+ParkingRequest* RequestScheduler::peek() const {
+    lock_guard<mutex> guard(heapLock);
+    return (heapSize > 0) ? heap[0].request : nullptr;
+}
+
+bool RequestScheduler::updatePriority(const string& requestId, PriorityClass priority) {
+    lock_guard<mutex> guard(heapLock);
+    ParkingRequest** found = queuedById.find(requestId);
+    if (found == nullptr) {
+        return false;
+    }
+    
+    ParkingRequest* request = *found;
+    int index = request->getSchedulerPosition();
+    long long oldKey = heap[index].key;
+    
+    request->setPriorityClass(priority);
+    heap[index].key = keyFor(priority, heap[index].arrivalMillis);
+    
+    // A smaller key moves towards the root, a larger one towards the leaves
+    if (heap[index].key < oldKey) {
+        siftUp(index);
+    } else {
+        siftDown(index);
+    }
+    return true;
+}
+
+void RequestScheduler::setClassHeadStart(PriorityClass priority, long long millis) {
+    lock_guard<mutex> guard(heapLock);
+    classHeadStart[(int)priority] = millis;
+    
+    // Existing keys embed the old head start; rebuild bottom-up in O(n)
+    for (int i = 0; i < heapSize; i++) {
+        heap[i].key = keyFor(heap[i].request->getPriorityClass(), heap[i].arrivalMillis);
+    }
+    for (int i = heapSize / 2 - 1; i >= 0; i--) {
+        siftDown(i);
+    }
+}
+
+long long RequestScheduler::getClassHeadStart(PriorityClass priority) const {
+    lock_guard<mutex> guard(heapLock);
+    return classHeadStart[(int)priority];
+}
+
+bool RequestScheduler::isEmpty() const {
+    lock_guard<mutex> guard(heapLock);
+    return heapSize == 0;
+}
+
+int RequestScheduler::getSize() const {
+    lock_guard<mutex> guard(heapLock);
+    return heapSize;
+}
+
+int RequestScheduler::getCapacity() const {
+    lock_guard<mutex> guard(heapLock);
+    return capacity;
+}
+
+void RequestScheduler::displayQueue() const {
+    lock_guard<mutex> guard(heapLock);
+    cout << "\n=== PENDING REQUESTS (PRIORITY SCHEDULING) ===" << endl;
+    cout << "Queue Size: " << heapSize << endl;
+    
+    if (heapSize == 0) {
+        cout << "Queue is empty." << endl;
+        return;
+    }
+    
+    // Best-first walk of the heap: the next entry in order is always the
+    // best of the children of the entries already printed. The frontier is
+    // itself a heap of indices, so the walk is O(n log n)
+    int* frontier = new int[heapSize];
+    int frontierSize = 0;
+    frontierPush(frontier, frontierSize, 0);
+    
+    for (int shown = 1; frontierSize > 0; shown++) {
+        int index = frontierPop(frontier, frontierSize);
+        if (2 * index + 1 < heapSize) {
+            frontierPush(frontier, frontierSize, 2 * index + 1);
+        }
+        if (2 * index + 2 < heapSize) {
+            frontierPush(frontier, frontierSize, 2 * index + 2);
+        }
+        
+        ParkingRequest* request = heap[index].request;
+        cout << "\n" << shown << ". ";
+        cout << "Request ID: " << request->getRequestId();
+        cout << ", Vehicle: " << request->getVehicle()->getVehicleId();
+        cout << ", Zone: " << request->getRequestedZoneId();
+        cout << ", Priority: " << request->priorityToString();
+    }
+    cout << endl;
+    
+    delete[] frontier;
+}
+
+void RequestScheduler::frontierPush(int* frontier, int& size, int index) const {
+    int position = size++;
+    while (position > 0) {
+        int parent = (position - 1) / 2;
+        if (!before(heap[index], heap[frontier[parent]])) {
+            break;
+        }
+        frontier[position] = frontier[parent];
+        position = parent;
+    }
+    frontier[position] = index;
+}
+
+int RequestScheduler::frontierPop(int* frontier, int& size) const {
+    int top = frontier[0];
+    int last = frontier[--size];
+    int position = 0;
+    while (true) {
+        int child = 2 * position + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size && before(heap[frontier[child + 1]], heap[frontier[child]])) {
+            child++;
+        }
+        if (!before(heap[frontier[child]], heap[last])) {
+            break;
+        }
+        frontier[position] = frontier[child];
+        position = child;
+    }
+    if (size > 0) {
+        frontier[position] = last;
+    }
+    return top;
+}
+
+void RequestScheduler::clear() {
+    lock_guard<mutex> guard(heapLock);
+    for (int i = 0; i < heapSize; i++) {
+        heap[i].request->setSchedulerPosition(-1);
+    }
+    heapSize = 0;
+    queuedById.clear();
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#ifndef REQUESTSCHEDULER_H
+#define REQUESTSCHEDULER_H
+
+#include "ParkingRequest.h"
+#include "HashIndex.h"
+#include <string>
+#include <mutex>
+using namespace std;
+
+// How ParkingSystem orders pending requests
+enum class SchedulingPolicy {
+    ZONE_FIFO, // Per-zone arrival order (RequestDispatcher)
+    PRIORITY   // Priority classes with aging (RequestScheduler)
+};
+
+// Pending requests ordered by priority class with waiting-time aging.
+// An entry's key is its arrival time minus its class's head start, so a
+// request that has waited longer than the gap between two classes overtakes
+// newer requests of the higher class. Keys never change as time passes,
+// which makes aging free: no periodic re-keying of queued entries.
+// Binary min-heap in a growable array; each queued request remembers its
+// heap position, so priority changes are a lookup plus one sift.
+class RequestScheduler {
+private:
+    struct HeapEntry {
+        long long key;                // arrivalMillis - class head start
+        unsigned long long sequence;  // Arrival order, breaks ties
+        long long arrivalMillis;
+        ParkingRequest* request;
+    };
+    
+    HeapEntry* heap;
+    int heapSize;
+    int capacity;
+    unsigned long long nextSequence;
+    HashIndex<ParkingRequest*> queuedById; // For updates by request ID
+    long long classHeadStart[PRIORITY_CLASS_COUNT]; // Milliseconds
+    mutable mutex heapLock;
+    
+public:
+    RequestScheduler(int initialCapacity = 64);
+    ~RequestScheduler();
+    
+    // Queue operations, O(log n)
+    bool enqueue(ParkingRequest* request, long long arrivalMillis);
+    ParkingRequest* dequeue();
+    ParkingRequest* peek() const;
+    bool updatePriority(const string& requestId, PriorityClass priority);
+    
+    // Aging: how many milliseconds of waiting a class is worth
+    void setClassHeadStart(PriorityClass priority, long long millis);
+    long long getClassHeadStart(PriorityClass priority) const;
+    
+    bool isEmpty() const;
+    int getSize() const;
+    int getCapacity() const;
+    
+    // Utility
+    void displayQueue() const; // In scheduling order
+    void clear();
+    
+private:
+    long long keyFor(PriorityClass priority, long long arrivalMillis) const;
+    void grow();
+    void place(int index, const HeapEntry& entry);
+    void siftUp(int index);
+    void siftDown(int index);
+    static bool before(const HeapEntry& a, const HeapEntry& b);
+    void frontierPush(int* frontier, int& size, int index) const; // Display walk, by heap order
+    int frontierPop(int* frontier, int& size) const;
+    
+    // Non-copyable: owns its heap array
+    RequestScheduler(const RequestScheduler&);
+    RequestScheduler& operator=(const RequestScheduler&);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,424 @@
+#include "ReservationBook.h"
+#include <iostream>
+#include <climits>
+using namespace std;
+
+// Nothing pending; hasDue never fires
+static const time_t NO_DUE = LLONG_MAX;
+
+// Bounds of a slot's gap before its first and after its last booking
+static const time_t OPEN_PAST = LLONG_MIN;
+static const time_t OPEN_FUTURE = LLONG_MAX;
+
+// ==================== SlotBook Implementation ====================
+ReservationBook::SlotBook::SlotBook(ParkingSlot* slot, int group)
+    : slot(slot), group(group), waitingHolds(0) {}
+
+// ==================== ReservationBook Implementation ====================
+ReservationBook::ReservationBook(int initialCapacity, int holdLeadSeconds)
+    : freeCount(0), usedCount(0), liveCount(0), heapSize(0), slotBookCount(0), groupCount(0),
+      nextDue(NO_DUE), waitingHoldCount(0) {
+    holdLead = (holdLeadSeconds >= 0) ? holdLeadSeconds : 0;
+    bookingCapacity = (initialCapacity > 0) ? initialCapacity : 64;
+    bookings = new Booking[bookingCapacity];
+    freeIds = new int[bookingCapacity];
+    heap = new int[bookingCapacity];
+    slotBookCapacity = bookingCapacity;
+    slotBooks = new SlotBook*[slotBookCapacity];
+    groupCapacity = 4 * SLOT_CLASS_COUNT;
+    groupGaps = new IntervalTree*[groupCapacity];
+}
+
+ReservationBook::~ReservationBook() {
+    // Requests are owned by the RequestManager
+    for (int i = 0; i < slotBookCount; i++) {
+        delete slotBooks[i];
+    }
+    for (int i = 0; i < groupCount; i++) {
+        delete groupGaps[i];
+    }
+    delete[] groupGaps;
+    delete[] slotBooks;
+    delete[] heap;
+    delete[] freeIds;
+    delete[] bookings;
+}
+
+void ReservationBook::addSlot(ParkingSlot* slot) {
+    lock_guard<mutex> guard(bookLock);
+    addSlotLocked(slot);
+}
+
+int ReservationBook::addSlotLocked(ParkingSlot* slot) {
+    const int* found = slotBookOf.find(slot->getSlotId());
+    if (found != nullptr) {
+        return *found;
+    }
+    
+    const int* zoneGroups = groupsOfZone.find(slot->getZoneId());
+    int firstGroup;
+    if (zoneGroups != nullptr) {
+        firstGroup = *zoneGroups;
+    } else {
+        if (groupCount + SLOT_CLASS_COUNT > groupCapacity) {
+            groupCapacity *= 2;
+            IntervalTree** newGroups = new IntervalTree*[groupCapacity];
+            for (int i = 0; i < groupCount; i++) {
+                newGroups[i] = groupGaps[i];
+            }
+            delete[] groupGaps;
+            groupGaps = newGroups;
+        }
+        firstGroup = groupCount;
+        for (int c = 0; c < SLOT_CLASS_COUNT; c++) {
+            groupGaps[groupCount++] = new IntervalTree();
+        }
+        groupsOfZone.insert(slot->getZoneId(), firstGroup);
+    }
+    
+    if (slotBookCount == slotBookCapacity) {
+        slotBookCapacity *= 2;
+        SlotBook** newSlotBooks = new SlotBook*[slotBookCapacity];
+        for (int i = 0; i < slotBookCount; i++) {
+            newSlotBooks[i] = slotBooks[i];
+        }
+        delete[] slotBooks;
+        slotBooks = newSlotBooks;
+    }
+    
+    // With no bookings the whole timeline is one gap
+    int index = slotBookCount++;
+    slotBooks[index] = new SlotBook(slot, firstGroup + (int)slot->getSlotClass());
+    slotBookOf.insert(slot->getSlotId(), index);
+    groupGaps[slotBooks[index]->group]->insert(OPEN_PAST, OPEN_FUTURE, gapId(index, -1));
+    return index;
+}
+
+int ReservationBook::gapId(int slotBook, int nextBooking) const {
+    return (nextBooking != -1) ? 2 * nextBooking : 2 * slotBook + 1;
+}
+
+ParkingSlot* ReservationBook::slotOfGap(int gap) const {
+    return (gap % 2 == 0) ? bookings[gap / 2].slot : slotBooks[gap / 2]->slot;
+}
+
+bool ReservationBook::isSlotFree(ParkingSlot* slot, time_t start, time_t end) const {
+    lock_guard<mutex> guard(bookLock);
+    const int* found = slotBookOf.find(slot->getSlotId());
+    return (found == nullptr) || slotBooks[*found]->windows.isFree(start, end);
+}
+
+ParkingSlot* ReservationBook::findFreeSlot(Zone* zone, SlotClass fits, time_t start, time_t end) const {
+    lock_guard<mutex> guard(bookLock);
+    return findFreeSlotLocked(zone, fits, start, end);
+}
+
+ParkingSlot* ReservationBook::findFreeSlotLocked(Zone* zone, SlotClass fits, time_t start, time_t end) const {
+    // Smallest class that fits first, as for walk-in claims; one gap query
+    // per class, however many slots the zone has
+    const int* zoneGroups = groupsOfZone.find(zone->getZoneId());
+    if (zoneGroups == nullptr || end <= start) {
+        return nullptr;
+    }
+    for (int c = (int)fits; c < SLOT_CLASS_COUNT; c++) {
+        int gap = groupGaps[*zoneGroups + c]->findCovering(start, end);
+        if (gap != -1) {
+            return slotOfGap(gap);
+        }
+    }
+    return nullptr;
+}
+
+bool ReservationBook::book(ParkingRequest* request, ParkingSlot* slot, time_t start, time_t end) {
+    lock_guard<mutex> guard(bookLock);
+    if (slot == nullptr) {
+        return false;
+    }
+    return bookLocked(request, addSlotLocked(slot), start, end);
+}
+
+ParkingSlot* ReservationBook::bookInZone(ParkingRequest* request, Zone* zone, SlotClass fits,
+                                         time_t start, time_t end) {
+    lock_guard<mutex> guard(bookLock);
+    ParkingSlot* slot = findFreeSlotLocked(zone, fits, start, end);
+    if (slot == nullptr || !bookLocked(request, *slotBookOf.find(slot->getSlotId()), start, end)) {
+        return nullptr;
+    }
+    return slot;
+}
+
+bool ReservationBook::bookLocked(ParkingRequest* request, int slotBook, time_t start, time_t end) {
+    if (request == nullptr || end <= start ||
+        bookingOfRequest.find(request->getRequestId()) != nullptr) {
+        return false;
+    }
+    
+    SlotBook* book = slotBooks[slotBook];
+    if (!book->windows.isFree(start, end)) {
+        return false;
+    }
+    
+    // The window splits the gap between its neighbours in two
+    int previous = book->windows.findLastBefore(start);
+    int next = book->windows.findFirstFrom(start);
+    time_t gapStart = (previous != -1) ? bookings[previous].end : OPEN_PAST;
+    time_t gapEnd = (next != -1) ? bookings[next].start : OPEN_FUTURE;
+    
+    int id;
+    if (freeCount > 0) {
+        id = freeIds[--freeCount];
+    } else {
+        if (usedCount == bookingCapacity) {
+            // Grow the booking table and the arrays sized by it
+            int newCapacity = bookingCapacity * 2;
+            Booking* newBookings = new Booking[newCapacity];
+            int* newHeap = new int[newCapacity];
+            for (int i = 0; i < usedCount; i++) {
+                newBookings[i] = bookings[i];
+            }
+            for (int i = 0; i < heapSize; i++) {
+                newHeap[i] = heap[i];
+            }
+            delete[] bookings;
+            delete[] heap;
+            delete[] freeIds;
+            bookings = newBookings;
+            heap = newHeap;
+            freeIds = new int[newCapacity]; // Empty: freeCount is 0 here
+            bookingCapacity = newCapacity;
+        }
+        id = usedCount++;
+    }
+    
+    bookings[id] = {request, book->slot, start, end, slotBook, -1, start - holdLead, false, false};
+    book->windows.insert(start, end, id);
+    bookingOfRequest.insert(request->getRequestId(), id);
+    liveCount++;
+    
+    IntervalTree* gaps = groupGaps[book->group];
+    gaps->remove(gapStart, gapId(slotBook, next));
+    if (gapStart < start) {
+        gaps->insert(gapStart, start, gapId(slotBook, id));
+    }
+    if (end < gapEnd) {
+        gaps->insert(end, gapEnd, gapId(slotBook, next));
+    }
+    
+    heapPlace(heapSize++, id);
+    siftUp(heapSize - 1);
+    refreshNextDue();
+    return true;
+}
+
+bool ReservationBook::release(ParkingRequest* request) {
+    lock_guard<mutex> guard(bookLock);
+    int* found = bookingOfRequest.find(request->getRequestId());
+    if (found == nullptr) {
+        return false;
+    }
+    
+    int id = *found;
+    Booking& booking = bookings[id];
+    SlotBook* book = slotBooks[booking.slotBook];
+    book->windows.remove(booking.start, id);
+    
+    // The gaps on either side merge into one
+    int previous = book->windows.findLastBefore(booking.start);
+    int next = book->windows.findFirstFrom(booking.start);
+    time_t gapStart = (previous != -1) ? bookings[previous].end : OPEN_PAST;
+    time_t gapEnd = (next != -1) ? bookings[next].start : OPEN_FUTURE;
+    IntervalTree* gaps = groupGaps[book->group];
+    gaps->remove(gapStart, gapId(booking.slotBook, id));
+    gaps->remove(booking.end, gapId(booking.slotBook, next));
+    if (gapStart < gapEnd) {
+        gaps->insert(gapStart, gapEnd, gapId(booking.slotBook, next));
+    }
+    
+    if (booking.heapPosition != -1) {
+        // Cancelled before its window opened: the hold passes to the next
+        // booking waiting on the slot, else the slot is freed
+        if (booking.holdsSlot) {
+            int waiting = nextWaitingHold(booking.slotBook);
+            if (waiting != -1) {
+                bookings[waiting].holdsSlot = true;
+                book->waitingHolds--;
+                waitingHoldCount--;
+            } else {
+                booking.slot->setAvailability(true);
+            }
+        } else if (booking.held) {
+            book->waitingHolds--;
+            waitingHoldCount--;
+        }
+        heapRemove(booking.heapPosition);
+        refreshNextDue();
+    }
+    bookingOfRequest.remove(request->getRequestId());
+    freeIds[freeCount++] = id;
+    liveCount--;
+    return true;
+}
+
+bool ReservationBook::hasDue(time_t now) const {
+    return nextDue.load(memory_order_acquire) <= now;
+}
+
+ParkingRequest* ReservationBook::takeDue(time_t now, ParkingSlot*& slot, bool& held) {
+    lock_guard<mutex> guard(bookLock);
+    while (heapSize > 0 && bookings[heap[0]].dueAt <= now) {
+        int id = heap[0];
+        Booking& booking = bookings[id];
+        if (!booking.held) {
+            // Keep walk-ins off the slot until the window opens; if a car
+            // is still parked there, wait for holdFreedSlot
+            booking.held = true;
+            booking.holdsSlot = booking.slot->tryClaim();
+            if (!booking.holdsSlot) {
+                slotBooks[booking.slotBook]->waitingHolds++;
+                waitingHoldCount++;
+            }
+            booking.dueAt = booking.start;
+            siftDown(0);
+            continue;
+        }
+        
+        // The window stays booked in the slot's tree until release()
+        heapRemove(0);
+        refreshNextDue();
+        if (!booking.holdsSlot) {
+            slotBooks[booking.slotBook]->waitingHolds--;
+            waitingHoldCount--;
+        }
+        slot = booking.slot;
+        held = booking.holdsSlot;
+        booking.holdsSlot = false; // The request owns the claim from here
+        return booking.request;
+    }
+    
+    refreshNextDue();
+    slot = nullptr;
+    held = false;
+    return nullptr;
+}
+
+bool ReservationBook::holdFreedSlot(ParkingSlot* slot) {
+    if (waitingHoldCount.load(memory_order_acquire) == 0) {
+        return false;
+    }
+    
+    lock_guard<mutex> guard(bookLock);
+    const int* found = slotBookOf.find(slot->getSlotId());
+    if (found == nullptr || slotBooks[*found]->waitingHolds == 0) {
+        return false;
+    }
+    
+    int id = nextWaitingHold(*found);
+    if (id == -1 || !slot->tryClaim()) {
+        return false;
+    }
+    bookings[id].holdsSlot = true;
+    slotBooks[*found]->waitingHolds--;
+    waitingHoldCount--;
+    return true;
+}
+
+int ReservationBook::nextWaitingHold(int slotBook) const {
+    if (slotBooks[slotBook]->waitingHolds == 0) {
+        return -1;
+    }
+    
+    // Windows on one slot never overlap, so starts are distinct and the
+    // earliest waiting booking is the first held one without its slot
+    const IntervalTree& windows = slotBooks[slotBook]->windows;
+    int id = windows.findFirstFrom(OPEN_PAST);
+    while (id != -1 && !(bookings[id].heapPosition != -1 && bookings[id].held && !bookings[id].holdsSlot)) {
+        id = windows.findFirstFrom(bookings[id].start + 1);
+    }
+    return id;
+}
+
+int ReservationBook::getBookingCount() const {
+    lock_guard<mutex> guard(bookLock);
+    return liveCount;
+}
+
+int ReservationBook::getUpcomingCount() const {
+    lock_guard<mutex> guard(bookLock);
+    return heapSize;
+}
+
+int ReservationBook::getHoldLead() const {
+    return (int)holdLead;
+}
+
+void ReservationBook::displayUpcoming(time_t now) const {
+    lock_guard<mutex> guard(bookLock);
+    cout << "\n=== UPCOMING RESERVATIONS ===" << endl;
+    cout << "Booked windows: " << liveCount << ", not yet open: " << heapSize << endl;
+    
+    // Heap order: the first entry opens next, the rest are unsorted
+    for (int i = 0; i < heapSize; i++) {
+        const Booking& booking = bookings[heap[i]];
+        cout << booking.request->getRequestId() << ": slot " << booking.slot->getSlotId()
+             << ", opens in " << (booking.start - now + 59) / 60 << " min for "
+             << (booking.end - booking.start + 59) / 60 << " min"
+             << (booking.holdsSlot ? " (slot held)" : (booking.held ? " (waiting for slot)" : "")) << endl;
+    }
+}
+
+// ==================== Due-Time Heap ====================
+void ReservationBook::heapPlace(int position, int id) {
+    heap[position] = id;
+    bookings[id].heapPosition = position;
+}
+
+void ReservationBook::siftUp(int position) {
+    int id = heap[position];
+    while (position > 0) {
+        int parent = (position - 1) / 2;
+        if (bookings[heap[parent]].dueAt <= bookings[id].dueAt) {
+            break;
+        }
+        heapPlace(position, heap[parent]);
+        position = parent;
+    }
+    heapPlace(position, id);
+}
+
+void ReservationBook::siftDown(int position) {
+    int id = heap[position];
+    while (true) {
+        int child = 2 * position + 1;
+        if (child >= heapSize) {
+            break;
+        }
+        if (child + 1 < heapSize && bookings[heap[child + 1]].dueAt < bookings[heap[child]].dueAt) {
+            child++;
+        }
+        if (bookings[heap[child]].dueAt >= bookings[id].dueAt) {
+            break;
+        }
+        heapPlace(position, heap[child]);
+        position = child;
+    }
+    heapPlace(position, id);
+}
+
+void ReservationBook::heapRemove(int position) {
+    int removed = heap[position];
+    heapSize--;
+    if (position < heapSize) {
+        // Move the last entry into the hole; it may belong above or below
+        int moved = heap[heapSize];
+        heapPlace(position, moved);
+        siftUp(position);
+        if (bookings[moved].heapPosition == position) {
+            siftDown(position);
+        }
+    }
+    bookings[removed].heapPosition = -1;
+}
+
+void ReservationBook::refreshNextDue() {
+    nextDue.store((heapSize > 0) ? bookings[heap[0]].dueAt : NO_DUE, memory_order_release);
+}
\ No newline at end of file
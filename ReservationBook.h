@@ -0,0 +1,132 @@
+#ifndef RESERVATIONBOOK_H
+#define RESERVATIONBOOK_H
+
+#include "IntervalTree.h"
+#include "Zone.h"
+#include "ParkingRequest.h"
+#include "HashIndex.h"
+#include <string>
+#include <mutex>
+#include <atomic>
+#include <ctime>
+using namespace std;
+
+// Time windows booked ahead on individual slots.
+// Each slot's windows live in its own IntervalTree, so checking or booking
+// a window on one slot is O(log n) in that slot's bookings. For zone-wide
+// queries, the free stretches between bookings (gaps) of every slot in a
+// (zone, slot class) group share one more IntervalTree; a window fits a
+// slot exactly when one of its gaps contains it, so finding a free slot in
+// a zone is O(log n) per class with no per-slot scan. Bookings whose window
+// has not opened yet also sit in a min-heap by their next due time. Walk-in
+// claims never look at the book, so holdLead seconds before a window opens
+// the book claims its slot for it; if a car is still parked there, the
+// booking waits and takes the slot when the owner hands it back through
+// holdFreedSlot(). At the start time the owner takes the booking as due and
+// allocates it. A window stays booked until release(), which the owner
+// calls when the request is released or cancelled.
+class ReservationBook {
+private:
+    struct Booking {
+        ParkingRequest* request;
+        ParkingSlot* slot;
+        time_t start;
+        time_t end;
+        int slotBook;     // Index into slotBooks
+        int heapPosition; // -1 once taken as due
+        time_t dueAt;     // Hold time, then start time once held
+        bool held;        // Past its hold time
+        bool holdsSlot;   // Its slot is claimed for it
+    };
+    
+    // A gap is named by what ends it: gap 2b is the one before booking b,
+    // gap 2s + 1 the open-ended one after the last booking of slot s
+    struct SlotBook {
+        ParkingSlot* slot;
+        IntervalTree windows; // Booking ids by window
+        int group;            // Index into groupGaps
+        int waitingHolds;     // Held bookings still waiting for the slot
+        
+        SlotBook(ParkingSlot* slot, int group);
+    };
+    
+    Booking* bookings;   // Slots reused through freeIds
+    int bookingCapacity;
+    int* freeIds;
+    int freeCount;
+    int usedCount;       // High-water mark of bookings
+    int liveCount;
+    
+    int* heap;           // Booking ids, earliest due first
+    int heapSize;
+    time_t holdLead;     // Seconds before the start that the slot is held
+    
+    SlotBook** slotBooks;        // One per slot added
+    int slotBookCount;
+    int slotBookCapacity;
+    HashIndex<int> slotBookOf;   // slotId -> index into slotBooks
+    IntervalTree** groupGaps;    // Gap ids per (zone, slot class)
+    int groupCount;
+    int groupCapacity;
+    HashIndex<int> groupsOfZone; // zoneId -> first of its SLOT_CLASS_COUNT groups
+    HashIndex<int> bookingOfRequest; // requestId -> booking id
+    
+    atomic<time_t> nextDue;        // Earliest hold or start, for a lock-free due check
+    atomic<int> waitingHoldCount;  // Lets holdFreedSlot skip the lock
+    mutable mutex bookLock;   // Leaf lock, held only inside these methods
+    
+public:
+    ReservationBook(int initialCapacity = 64, int holdLeadSeconds = 15 * 60);
+    ~ReservationBook();
+    
+    // Slots can be booked once added; adding one again is a no-op
+    void addSlot(ParkingSlot* slot);
+    
+    // Window queries, O(log n); the zone query is O(log n) per class
+    bool isSlotFree(ParkingSlot* slot, time_t start, time_t end) const;
+    ParkingSlot* findFreeSlot(Zone* zone, SlotClass fits, time_t start, time_t end) const;
+    
+    // Booking, O(log n). bookInZone takes a slot of zone that fits and is
+    // free for the window, smallest class first, as one step; within a
+    // class it picks the slot whose free stretch began earliest.
+    bool book(ParkingRequest* request, ParkingSlot* slot, time_t start, time_t end);
+    ParkingSlot* bookInZone(ParkingRequest* request, Zone* zone, SlotClass fits, time_t start, time_t end);
+    bool release(ParkingRequest* request); // Frees the window; false if none booked
+    
+    // Due bookings, earliest start first. takeDue first holds the slots of
+    // bookings within holdLead of their start; slot receives the booked
+    // slot and held whether it is already claimed for the request.
+    bool hasDue(time_t now) const; // Lock-free
+    ParkingRequest* takeDue(time_t now, ParkingSlot*& slot, bool& held);
+    
+    // Claims a freed slot for the earliest held booking still waiting on
+    // it; false leaves the slot free. Lock-free when nothing is waiting.
+    bool holdFreedSlot(ParkingSlot* slot);
+    
+    // Accessors
+    int getBookingCount() const;
+    int getUpcomingCount() const;
+    int getHoldLead() const;
+    
+    // Utility
+    void displayUpcoming(time_t now) const;
+    
+private:
+    int addSlotLocked(ParkingSlot* slot); // Index into slotBooks
+    int gapId(int slotBook, int nextBooking) const;
+    ParkingSlot* slotOfGap(int gap) const;
+    ParkingSlot* findFreeSlotLocked(Zone* zone, SlotClass fits, time_t start, time_t end) const;
+    bool bookLocked(ParkingRequest* request, int slotBook, time_t start, time_t end);
+    int nextWaitingHold(int slotBook) const; // Booking id, or -1
+    void heapPlace(int position, int id);
+    void siftUp(int position);
+    void siftDown(int position);
+    void heapRemove(int position);
+    void refreshNextDue();
+    
+    // Non-copyable: owns its trees and arrays
+    ReservationBook(const ReservationBook&);
+    ReservationBook& operator=(const ReservationBook&);
+};
+
+#endif
\ No newline at end of file
@@ -1,94 +1,72 @@
 #include "RollbackManager.h"
 #include "RequestManager.h"
 #include "AllocationEngine.h"
-#include "Zone.h"
-#include "ParkingArea.h"
 #include <iostream>
 #include <ctime>
 using namespace std;
 
 // ==================== RollbackOperation Implementation ====================
-RollbackOperation::RollbackOperation(RollbackType t, const string& reqId) 
-    : type(t), requestId(reqId), operationTime(time(0)) {}
+RollbackOperation::RollbackOperation() 
+    : type(RollbackType::STATE_CHANGE), previousState(RequestState::REQUESTED), operationTime(0) {}
 
-// ==================== StackNode Implementation ====================
-RollbackStack::StackNode::StackNode(RollbackOperation* op) 
-    : operation(op), next(nullptr) {}
+RollbackOperation::RollbackOperation(RollbackType t, const string& reqId) 
+    : type(t), requestId(reqId), previousState(RequestState::REQUESTED), operationTime(time(0)) {}
 
 // ==================== RollbackStack Implementation ====================
 RollbackStack::RollbackStack(int maxOperations) 
-    : top(nullptr), stackSize(0), maxSize(maxOperations) {}
+    : capacity(maxOperations > 0 ? maxOperations : 1), topIndex(0), stackSize(0) {
+    entries = new RollbackOperation[capacity];
+}
 
 RollbackStack::~RollbackStack() {
-    clearStack();
+    delete[] entries;
 }
 
-void RollbackStack::clearStack() {
-    while (!isEmpty()) {
-        StackNode* temp = top;
-        top = top->next;
-        delete temp->operation;
-        delete temp;
+bool RollbackStack::push(const RollbackOperation& operation) {
+    // Assigning into an existing record reuses its string buffers
+    entries[topIndex] = operation;
+    topIndex = (topIndex + 1 == capacity) ? 0 : topIndex + 1;
+    
+    if (stackSize < capacity) {
+        stackSize++;
     }
-    stackSize = 0;
+    // Otherwise the oldest record was just overwritten
+    return true;
 }
 
-bool RollbackStack::push(RollbackOperation* operation) {
-    if (stackSize >= maxSize) {
-        // Remove oldest operation (bottom of stack) if max size reached
-        if (top == nullptr) return false;
-        
-        // If only one node, clear it
-        if (top->next == nullptr) {
-            delete top->operation;
-            delete top;
-            top = nullptr;
-            stackSize = 0;
-        } else {
-            // Find second last node
-            StackNode* current = top;
-            while (current->next->next != nullptr) {
-                current = current->next;
-            }
-            
-            // Remove last node
-            delete current->next->operation;
-            delete current->next;
-            current->next = nullptr;
-            stackSize--;
-        }
+bool RollbackStack::pop(RollbackOperation& operation) {
+    if (isEmpty()) {
+        return false;
     }
     
-    StackNode* newNode = new StackNode(operation);
-    newNode->next = top;
-    top = newNode;
-    stackSize++;
+    topIndex = (topIndex == 0) ? capacity - 1 : topIndex - 1;
+    operation = entries[topIndex];
+    stackSize--;
     return true;
 }
 
-RollbackOperation* RollbackStack::pop() {
+const RollbackOperation* RollbackStack::peek() const {
     if (isEmpty()) {
         return nullptr;
     }
-    
-    StackNode* temp = top;
-    RollbackOperation* operation = temp->operation;
-    top = top->next;
-    delete temp;
-    stackSize--;
-    return operation;
+    return &entries[(topIndex == 0) ? capacity - 1 : topIndex - 1];
 }
 
 bool RollbackStack::isEmpty() const {
-    return top == nullptr;
+    return stackSize == 0;
 }
 
 int RollbackStack::getSize() const {
     return stackSize;
 }
 
+int RollbackStack::getCapacity() const {
+    return capacity;
+}
+
 void RollbackStack::clear() {
-    clearStack();
+    topIndex = 0;
+    stackSize = 0;
 }
 
 // ==================== RollbackManager Implementation ====================
@@ -102,40 +80,66 @@ RollbackManager::~RollbackManager() {
 }
 
 void RollbackManager::recordAllocation(const string& requestId, const string& slotId, const string& zoneId) {
-    RollbackOperation* op = new RollbackOperation(RollbackType::ALLOCATION, requestId);
-    op->slotId = slotId;
-    op->zoneId = zoneId;
-    operationStack->push(op);
+    RollbackOperation op(RollbackType::ALLOCATION, requestId);
+    op.slotId = slotId;
+    op.zoneId = zoneId;
+    {
+        lock_guard<mutex> guard(stackLock);
+        operationStack->push(op);
+    }
     cout << "Recorded allocation operation for request " << requestId << endl;
 }
 
+void RollbackManager::recordAllocationBatch(ParkingRequest** requests, int count) {
+    // Same records as recordAllocation, in order, under a single lock hold
+    RollbackOperation op(RollbackType::ALLOCATION, "");
+    {
+        lock_guard<mutex> guard(stackLock);
+        for (int i = 0; i < count; i++) {
+            ParkingSlot* slot = requests[i]->getAllocatedSlot();
+            op.requestId = requests[i]->getRequestId();
+            op.slotId = slot->getSlotId();
+            op.zoneId = slot->getZoneId();
+            operationStack->push(op);
+        }
+    }
+    cout << "Recorded " << count << " allocation operations" << endl;
+}
+
 void RollbackManager::recordCancellation(const string& requestId) {
-    RollbackOperation* op = new RollbackOperation(RollbackType::CANCELLATION, requestId);
-    operationStack->push(op);
+    RollbackOperation op(RollbackType::CANCELLATION, requestId);
+    {
+        lock_guard<mutex> guard(stackLock);
+        operationStack->push(op);
+    }
     cout << "Recorded cancellation operation for request " << requestId << endl;
 }
 
 void RollbackManager::recordStateChange(const string& requestId, RequestState previousState) {
-    RollbackOperation* op = new RollbackOperation(RollbackType::STATE_CHANGE, requestId);
-    op->previousState = previousState;
-    operationStack->push(op);
+    RollbackOperation op(RollbackType::STATE_CHANGE, requestId);
+    op.previousState = previousState;
+    {
+        lock_guard<mutex> guard(stackLock);
+        operationStack->push(op);
+    }
     cout << "Recorded state change operation for request " << requestId << endl;
 }
 
 bool RollbackManager::rollbackLastOperation(RequestManager* requestManager, AllocationEngine* engine) {
-    if (operationStack->isEmpty()) {
-        cout << "No operations to rollback." << endl;
-        return false;
+    RollbackOperation op;
+    bool popped;
+    {
+        lock_guard<mutex> guard(stackLock);
+        popped = operationStack->pop(op);
     }
-    
-    RollbackOperation* op = operationStack->pop();
-    if (op == nullptr) {
+    if (!popped) {
+        cout << "No operations to rollback." << endl;
         return false;
     }
     
     bool success = false;
     
-    switch (op->type) {
+    switch (op.type) {
         case RollbackType::ALLOCATION:
             success = undoAllocation(op, requestManager, engine);
             break;
@@ -147,7 +151,6 @@ bool RollbackManager::rollbackLastOperation(RequestManager* requestManager, Allo
             break;
     }
     
-    delete op;
     return success;
 }
 
@@ -157,7 +160,7 @@ bool RollbackManager::rollbackLastKOperations(int k, RequestManager* requestMana
         return false;
     }
     
-    int available = operationStack->getSize();
+    int available = getAvailableRollbacks();
     if (k > available) {
         cout << "Only " << available << " operations available for rollback." << endl;
         k = available;
@@ -176,83 +179,60 @@ bool RollbackManager::rollbackLastKOperations(int k, RequestManager* requestMana
     return allSuccess;
 }
 
-bool RollbackManager::undoAllocation(RollbackOperation* op, RequestManager* requestManager, AllocationEngine* engine) {
-    ParkingRequest* request = requestManager->findRequest(op->requestId);
+bool RollbackManager::undoAllocation(const RollbackOperation& op, RequestManager* requestManager, AllocationEngine* engine) {
+    ParkingRequest* request = requestManager->findRequest(op.requestId);
     if (request == nullptr) {
-        cout << "Error: Request " << op->requestId << " not found for rollback." << endl;
+        cout << "Error: Request " << op.requestId << " not found for rollback." << endl;
         return false;
     }
     
-    cout << "Undoing allocation for request " << op->requestId << "..." << endl;
+    cout << "Undoing allocation for request " << op.requestId << "..." << endl;
     
-    // Find the zone
-    Zone* zone = engine->findZone(op->zoneId);
-    if (zone == nullptr) {
-        cout << "Error: Zone " << op->zoneId << " not found." << endl;
+    // Resolve the slot through the engine's slot index
+    ParkingSlot* slotToFree = engine->findSlot(op.slotId);
+    if (slotToFree == nullptr) {
+        cout << "Error: Slot " << op.slotId << " not found in zone " << op.zoneId << endl;
         return false;
     }
     
-    // Try to find the slot in any area of the zone
-    bool slotFound = false;
-    ParkingSlot* slotToFree = nullptr;
-    
-    // Simple search through all areas
-    for (int i = 0; i < zone->getCurrentAreas(); i++) {
-        // This is simplified - we need actual area access methods
-        // For now, we'll just try to find area by index
-        string areaName;
-        if (zone->getZoneId() == "Z1") {
-            if (i == 0) areaName = "A1";
-            else if (i == 1) areaName = "A2";
-        } else if (zone->getZoneId() == "Z2") {
-            areaName = "B1";
-        } else if (zone->getZoneId() == "Z3") {
-            areaName = "C1";
-        }
-        
-        ParkingArea* area = zone->findArea(areaName);
-        if (area) {
-            ParkingSlot* slot = area->findSlot(op->slotId);
-            if (slot) {
-                slotToFree = slot;
-                slotFound = true;
-                break;
-            }
-        }
-    }
-    
-    if (!slotFound) {
-        cout << "Error: Slot " << op->slotId << " not found in zone " << op->zoneId << endl;
+    // Once released or cancelled, the slot may already belong to a waiter
+    // or a held reservation; only free it while this request still holds it
+    RequestState state = request->getCurrentState();
+    if ((state != RequestState::ALLOCATED && state != RequestState::OCCUPIED) ||
+        request->getAllocatedSlot() != slotToFree) {
+        cout << "Error: Request " << op.requestId << " no longer holds slot " << op.slotId
+             << "; allocation not undone." << endl;
         return false;
     }
     
-    // Restore slot availability
-    slotToFree->setAvailability(true);
-    slotToFree->setVehicleId("");
-    
-    // Reset request state to CANCELLED
+    // Cancelling frees an ALLOCATED request's slot; an OCCUPIED one is
+    // freed here
+    if (state == RequestState::OCCUPIED) {
+        slotToFree->setVehicleId("");
+        slotToFree->setAvailability(true);
+    }
     request->cancelRequest();
     
-    cout << "Successfully rolled back allocation for request " << op->requestId << endl;
-    cout << "Slot " << op->slotId << " is now available again." << endl;
+    cout << "Successfully rolled back allocation for request " << op.requestId << endl;
+    cout << "Slot " << op.slotId << " is now available again." << endl;
     return true;
 }
 
-bool RollbackManager::undoCancellation(RollbackOperation* op, RequestManager* requestManager, AllocationEngine* engine) {
-    ParkingRequest* request = requestManager->findRequest(op->requestId);
+bool RollbackManager::undoCancellation(const RollbackOperation& op, RequestManager* requestManager, AllocationEngine*) {
+    ParkingRequest* request = requestManager->findRequest(op.requestId);
     if (request == nullptr) {
-        cout << "Error: Request " << op->requestId << " not found for rollback." << endl;
+        cout << "Error: Request " << op.requestId << " not found for rollback." << endl;
         return false;
     }
     
-    cout << "Undoing cancellation for request " << op->requestId << "..." << endl;
+    cout << "Undoing cancellation for request " << op.requestId << "..." << endl;
     
     // Change state back to ALLOCATED (simplified)
     // In real implementation, we'd restore the exact previous state including slot
     if (request->getCurrentState() == RequestState::CANCELLED) {
         // We can't easily restore the exact state without more information
         // For now, just mark it as REQUESTED
-        cout << "Request " << op->requestId << " state changed from CANCELLED to REQUESTED" << endl;
+        cout << "Request " << op.requestId << " state changed from CANCELLED to REQUESTED" << endl;
         cout << "Note: Manual slot reallocation required." << endl;
         return true;
     }
@@ -260,18 +240,18 @@ bool RollbackManager::undoCancellation(RollbackOperation* op, RequestManager* re
     return false;
 }
 
-bool RollbackManager::undoStateChange(RollbackOperation* op, RequestManager* requestManager) {
-    ParkingRequest* request = requestManager->findRequest(op->requestId);
+bool RollbackManager::undoStateChange(const RollbackOperation& op, RequestManager* requestManager) {
+    ParkingRequest* request = requestManager->findRequest(op.requestId);
     if (request == nullptr) {
-        cout << "Error: Request " << op->requestId << " not found for rollback." << endl;
+        cout << "Error: Request " << op.requestId << " not found for rollback." << endl;
         return false;
     }
     
-    cout << "Undoing state change for request " << op->requestId << "..." << endl;
+    cout << "Undoing state change for request " << op.requestId << "..." << endl;
     
     // Log what we would do
     cout << "Would restore to state: ";
-    switch(op->previousState) {
+    switch(op.previousState) {
         case RequestState::REQUESTED: cout << "REQUESTED"; break;
         case RequestState::ALLOCATED: cout << "ALLOCATED"; break;
         case RequestState::OCCUPIED: cout << "OCCUPIED"; break;
@@ -285,6 +265,7 @@ bool RollbackManager::undoStateChange(RollbackOperation* op, RequestManager* req
 }
 
 void RollbackManager::displayRollbackStack() const {
+    lock_guard<mutex> guard(stackLock);
     cout << "\n=== ROLLBACK STACK ===" << endl;
     cout << "Available rollbacks: " << operationStack->getSize() << endl;
     cout << "Max rollbacks: " << maxRollbackOperations << endl;
@@ -292,12 +273,20 @@ void RollbackManager::displayRollbackStack() const {
     if (operationStack->isEmpty()) {
         cout << "Stack is empty." << endl;
     } else {
+        const RollbackOperation* top = operationStack->peek();
         cout << "\nTop operation in stack:" << endl;
-        // Can't traverse without popping, so just show count
+        cout << "  Request: " << top->requestId << ", Type: ";
+        switch (top->type) {
+            case RollbackType::ALLOCATION: cout << "ALLOCATION (slot " << top->slotId << ")"; break;
+            case RollbackType::CANCELLATION: cout << "CANCELLATION"; break;
+            case RollbackType::STATE_CHANGE: cout << "STATE_CHANGE"; break;
+        }
+        cout << endl;
         cout << operationStack->getSize() << " operations available for rollback." << endl;
     }
 }
 
 int RollbackManager::getAvailableRollbacks() const {
+    lock_guard<mutex> guard(stackLock);
     return operationStack->getSize();
 }
\ No newline at end of file
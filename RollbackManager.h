@@ -4,6 +4,7 @@
 #include "ParkingRequest.h"
 #include <string>
 #include <ctime>
+#include <mutex>
 using namespace std;
 
 // Forward declarations
@@ -26,48 +27,53 @@ struct RollbackOperation {
     RequestState previousState;
     time_t operationTime;
     
+    RollbackOperation();
     RollbackOperation(RollbackType t, const string& reqId);
 };
 
-// Stack implementation for rollback operations
+// Bounded stack of rollback operations.
+// Records live inline in a circular buffer; once full, a push overwrites the
+// oldest record, so push, pop and eviction are all O(1) with no allocation.
 class RollbackStack {
 private:
-    struct StackNode {
-        RollbackOperation* operation;
-        StackNode* next;
-        
-        StackNode(RollbackOperation* op);
-    };
-    
-    StackNode* top;
+    RollbackOperation* entries;
+    int capacity;
+    int topIndex;  // Slot the next push writes to
     int stackSize;
-    int maxSize;
     
 public:
-    RollbackStack(int maxOperations = 100);
+    RollbackStack(int maxOperations = 1024);
     ~RollbackStack();
     
-    bool push(RollbackOperation* operation);
-    RollbackOperation* pop();
+    bool push(const RollbackOperation& operation); // Evicts the oldest record when full
+    bool pop(RollbackOperation& operation);
+    const RollbackOperation* peek() const;
     bool isEmpty() const;
     int getSize() const;
+    int getCapacity() const;
     void clear();
     
 private:
-    void clearStack();
+    // Non-copyable: owns its buffer
+    RollbackStack(const RollbackStack&);
+    RollbackStack& operator=(const RollbackStack&);
 };
 
+// Recording is safe from any thread. Undo itself expects the caller to
+// have stopped other activity (ParkingSystem holds its topology lock).
 class RollbackManager {
 private:
     RollbackStack* operationStack;
     int maxRollbackOperations;
+    mutable mutex stackLock; // Guards operationStack
     
 public:
-    RollbackManager(int maxOperations = 10);
+    RollbackManager(int maxOperations = 1024);
     ~RollbackManager();
     
     // Record operations
     void recordAllocation(const string& requestId, const string& slotId, const string& zoneId);
+    void recordAllocationBatch(ParkingRequest** requests, int count); // One push per request, one lock
     void recordCancellation(const string& requestId);
     void recordStateChange(const string& requestId, RequestState previousState);
     
@@ -80,9 +86,9 @@ public:
     int getAvailableRollbacks() const;
     
 private:
-    bool undoAllocation(RollbackOperation* op, RequestManager* requestManager, AllocationEngine* engine);
-    bool undoCancellation(RollbackOperation* op, RequestManager* requestManager, AllocationEngine* engine);
-    bool undoStateChange(RollbackOperation* op, RequestManager* requestManager);
+    bool undoAllocation(const RollbackOperation& op, RequestManager* requestManager, AllocationEngine* engine);
+    bool undoCancellation(const RollbackOperation& op, RequestManager* requestManager, AllocationEngine* engine);
+    bool undoStateChange(const RollbackOperation& op, RequestManager* requestManager);
 };
 
 #endif
\ No newline at end of file
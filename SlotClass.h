@@ -0,0 +1,57 @@
+#ifndef SLOTCLASS_H
+#define SLOTCLASS_H
+
+#include <string>
+using namespace std;
+
+// Size class of a parking slot, smallest first. A vehicle fits any slot of
+// its own class or a larger one, so comparing classes decides compatibility.
+enum class SlotClass {
+    MOTORCYCLE,
+    COMPACT,
+    STANDARD,
+    LARGE       // SUVs, vans and trucks; also the default, which fits every vehicle
+};
+
+const int SLOT_CLASS_COUNT = 4;
+
+inline const char* slotClassName(SlotClass slotClass) {
+    switch (slotClass) {
+        case SlotClass::MOTORCYCLE:
+            return "motorcycle";
+        case SlotClass::COMPACT:
+            return "compact";
+        case SlotClass::STANDARD:
+            return "standard";
+        default:
+            return "large";
+    }
+}
+
+inline bool slotClassFits(SlotClass vehicleClass, SlotClass slotClass) {
+    return (int)slotClass >= (int)vehicleClass;
+}
+
+// Smallest slot class a vehicle of this type fits in; unrecognised types
+// (including "Unknown" for auto-registered vehicles) need a standard slot
+inline SlotClass slotClassForVehicle(const string& vehicleType) {
+    string type = vehicleType;
+    for (size_t i = 0; i < type.size(); i++) {
+        if (type[i] >= 'A' && type[i] <= 'Z') {
+            type[i] = type[i] - 'A' + 'a';
+        }
+    }
+    
+    if (type == "motorcycle" || type == "motorbike" || type == "scooter" || type == "bike") {
+        return SlotClass::MOTORCYCLE;
+    }
+    if (type == "compact" || type == "hatchback" || type == "mini") {
+        return SlotClass::COMPACT;
+    }
+    if (type == "suv" || type == "van" || type == "truck" || type == "pickup" || type == "bus") {
+        return SlotClass::LARGE;
+    }
+    return SlotClass::STANDARD;
+}
+
+#endif
\ No newline at end of file
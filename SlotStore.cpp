@@ -0,0 +1,345 @@
+#include "SlotStore.h"
+#include "SymbolTable.h"
+using namespace std;
+
+SlotStore::SlotStore(const string& zoneId)
+    : freeBits(nullptr), occupant(nullptr), slotName(nullptr), wordOwner(nullptr),
+      classBits(nullptr), classSummary(nullptr), reservedSlots(0), capacity(0) {
+    zoneHandle = SymbolTable::zones().intern(zoneId);
+}
+
+SlotStore::~SlotStore() {
+    delete[] freeBits;
+    delete[] occupant;
+    delete[] slotName;
+    delete[] wordOwner;
+    delete[] classBits;
+    delete[] classSummary;
+}
+
+void SlotStore::grow(int minCapacity) {
+    int newCapacity = (capacity > 0) ? capacity : 64;
+    while (newCapacity < minCapacity) {
+        newCapacity *= 2;
+    }
+    
+    int oldWords = capacity / 64;
+    int newWords = newCapacity / 64;
+    
+    atomic<uint64_t>* newFreeBits = new atomic<uint64_t>[newWords];
+    int* newWordOwner = new int[newWords];
+    uint64_t* newClassBits = new uint64_t[newWords * SLOT_CLASS_COUNT];
+    atomic<int>* newOccupant = new atomic<int>[newCapacity];
+    int* newSlotName = new int[newCapacity];
+    int oldSummaries = (oldWords + 63) / 64;
+    int newSummaries = (newWords + 63) / 64;
+    atomic<uint64_t>* newClassSummary = new atomic<uint64_t>[newSummaries * SLOT_CLASS_COUNT];
+    
+    for (int k = 0; k < newSummaries * SLOT_CLASS_COUNT; k++) {
+        newClassSummary[k].store((k < oldSummaries * SLOT_CLASS_COUNT) ? classSummary[k].load() : 0);
+    }
+    for (int w = 0; w < newWords; w++) {
+        newFreeBits[w].store((w < oldWords) ? freeBits[w].load() : 0);
+        newWordOwner[w] = (w < oldWords) ? wordOwner[w] : -1;
+        for (int c = 0; c < SLOT_CLASS_COUNT; c++) {
+            int k = w * SLOT_CLASS_COUNT + c;
+            newClassBits[k] = (w < oldWords) ? classBits[k] : 0;
+        }
+    }
+    for (int i = 0; i < newCapacity; i++) {
+        newOccupant[i].store((i < capacity) ? occupant[i].load() : SymbolTable::NONE);
+        newSlotName[i] = (i < capacity) ? slotName[i] : SymbolTable::NONE;
+    }
+    
+    delete[] freeBits;
+    delete[] wordOwner;
+    delete[] classBits;
+    delete[] classSummary;
+    delete[] occupant;
+    delete[] slotName;
+    
+    freeBits = newFreeBits;
+    wordOwner = newWordOwner;
+    classBits = newClassBits;
+    classSummary = newClassSummary;
+    occupant = newOccupant;
+    slotName = newSlotName;
+    capacity = newCapacity;
+}
+
+int SlotStore::reserveBlock(int slotCount, int ownerTag) {
+    int base = reservedSlots;
+    int words = (slotCount + 63) / 64;
+    if (words == 0) {
+        words = 1;
+    }
+    
+    if (base + words * 64 > capacity) {
+        grow(base + words * 64);
+    }
+    
+    for (int w = 0; w < words; w++) {
+        wordOwner[base / 64 + w] = ownerTag;
+    }
+    reservedSlots += words * 64;
+    return base;
+}
+
+void SlotStore::initSlot(int index, const string& slotId, SlotClass slotClass) {
+    uint64_t mask = uint64_t(1) << (index % 64);
+    for (int c = 0; c < SLOT_CLASS_COUNT; c++) {
+        classBits[(index / 64) * SLOT_CLASS_COUNT + c] &= ~mask;
+    }
+    classBits[(index / 64) * SLOT_CLASS_COUNT + (int)slotClass] |= mask;
+    
+    slotName[index] = SymbolTable::slots().intern(slotId);
+    occupant[index].store(SymbolTable::NONE, memory_order_relaxed);
+    freeBits[index / 64].fetch_or(uint64_t(1) << (index % 64));
+    markWordFree(index / 64, uint64_t(1) << (index % 64));
+}
+
+bool SlotStore::isFree(int index) const {
+    return (freeBits[index / 64].load(memory_order_acquire) >> (index % 64)) & 1;
+}
+
+bool SlotStore::setFree(int index, bool free) {
+    uint64_t mask = uint64_t(1) << (index % 64);
+    if (!free) {
+        return tryClaim(index);
+    }
+    // fetch_or reports whether this call is the one that freed the slot
+    if ((freeBits[index / 64].fetch_or(mask, memory_order_acq_rel) & mask) != 0) {
+        return false;
+    }
+    markWordFree(index / 64, mask);
+    return true;
+}
+
+bool SlotStore::tryClaim(int index) {
+    uint64_t mask = uint64_t(1) << (index % 64);
+    atomic<uint64_t>& word = freeBits[index / 64];
+    uint64_t bits = word.load(memory_order_relaxed);
+    
+    // Retry only while the bit is still free; a failed CAS reloads bits
+    while (bits & mask) {
+        if (word.compare_exchange_weak(bits, bits & ~mask, memory_order_acq_rel, memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int SlotStore::getOccupant(int index) const {
+    return occupant[index].load(memory_order_relaxed);
+}
+
+void SlotStore::setOccupant(int index, int vehicleHandle) {
+    occupant[index].store(vehicleHandle, memory_order_relaxed);
+}
+
+int SlotStore::getSlotName(int index) const {
+    return slotName[index];
+}
+
+SlotClass SlotStore::getSlotClass(int index) const {
+    uint64_t mask = uint64_t(1) << (index % 64);
+    for (int c = 0; c < SLOT_CLASS_COUNT; c++) {
+        if (classBits[(index / 64) * SLOT_CLASS_COUNT + c] & mask) {
+            return (SlotClass)c;
+        }
+    }
+    return SlotClass::LARGE;
+}
+
+int SlotStore::getZoneHandle() const {
+    return zoneHandle;
+}
+
+int SlotStore::findFirstFree(int from, int to) const {
+    if (from >= to) {
+        return -1;
+    }
+    
+    int firstWord = from / 64;
+    int lastWord = (to - 1) / 64;
+    
+    for (int w = firstWord; w <= lastWord; w++) {
+        uint64_t bits = freeBits[w].load(memory_order_acquire);
+        if (w == firstWord) {
+            bits &= ~uint64_t(0) << (from % 64);
+        }
+        if (w == lastWord && to % 64 != 0) {
+            bits &= ~uint64_t(0) >> (64 - to % 64);
+        }
+        if (bits != 0) {
+            return w * 64 + __builtin_ctzll(bits);
+        }
+    }
+    return -1;
+}
+
+int SlotStore::claimFirstFree(int from, int to, int slotClass) {
+    if (from >= to) {
+        return -1;
+    }
+    
+    int firstWord = from / 64;
+    int lastWord = (to - 1) / 64;
+    
+    for (int w = firstWord; w <= lastWord; w++) {
+        uint64_t range = ~uint64_t(0);
+        if (w == firstWord) {
+            range &= ~uint64_t(0) << (from % 64);
+        }
+        if (w == lastWord && to % 64 != 0) {
+            range &= ~uint64_t(0) >> (64 - to % 64);
+        }
+        if (slotClass != ANY_CLASS) {
+            range &= classBits[w * SLOT_CLASS_COUNT + slotClass];
+        }
+        
+        // Lowest free bit of the word; a losing CAS reloads the word and
+        // moves on to the next free bit without ever blocking
+        uint64_t bits = freeBits[w].load(memory_order_relaxed);
+        while ((bits & range) != 0) {
+            uint64_t lowest = (bits & range) & (~(bits & range) + 1);
+            if (freeBits[w].compare_exchange_weak(bits, bits & ~lowest, memory_order_acq_rel, memory_order_relaxed)) {
+                return w * 64 + __builtin_ctzll(lowest);
+            }
+        }
+    }
+    return -1;
+}
+
+int SlotStore::claimFree(int from, int to, int* claimed, int maxCount, int slotClass) {
+    int count = 0;
+    if (from >= to) {
+        return 0;
+    }
+    
+    int firstWord = from / 64;
+    int lastWord = (to - 1) / 64;
+    
+    for (int w = firstWord; w <= lastWord && count < maxCount; w++) {
+        uint64_t range = ~uint64_t(0);
+        if (w == firstWord) {
+            range &= ~uint64_t(0) << (from % 64);
+        }
+        if (w == lastWord && to % 64 != 0) {
+            range &= ~uint64_t(0) >> (64 - to % 64);
+        }
+        if (slotClass != ANY_CLASS) {
+            range &= classBits[w * SLOT_CLASS_COUNT + slotClass];
+        }
+        
+        // Take as many of the word's free bits as still needed with one CAS;
+        // a losing CAS recomputes the mask from the reloaded word
+        uint64_t bits = freeBits[w].load(memory_order_relaxed);
+        while ((bits & range) != 0) {
+            uint64_t available = bits & range;
+            uint64_t taken = 0;
+            for (int n = count; n < maxCount && available != 0; n++) {
+                uint64_t lowest = available & (~available + 1);
+                taken |= lowest;
+                available &= ~lowest;
+            }
+            if (freeBits[w].compare_exchange_weak(bits, bits & ~taken, memory_order_acq_rel, memory_order_relaxed)) {
+                while (taken != 0) {
+                    claimed[count++] = w * 64 + __builtin_ctzll(taken);
+                    taken &= taken - 1;
+                }
+                break;
+            }
+        }
+    }
+    return count;
+}
+
+int SlotStore::countFree(int from, int to, int slotClass) const {
+    int count = 0;
+    int i = from;
+    
+    // Partial leading word, whole words via popcount, partial trailing word
+    while (i < to && i % 64 != 0) {
+        count += isFree(i) && (slotClass == ANY_CLASS || getSlotClass(i) == (SlotClass)slotClass);
+        i++;
+    }
+    while (i + 64 <= to) {
+        uint64_t bits = freeBits[i / 64].load(memory_order_acquire);
+        if (slotClass != ANY_CLASS) {
+            bits &= classBits[(i / 64) * SLOT_CLASS_COUNT + slotClass];
+        }
+        count += __builtin_popcountll(bits);
+        i += 64;
+    }
+    while (i < to) {
+        count += isFree(i) && (slotClass == ANY_CLASS || getSlotClass(i) == (SlotClass)slotClass);
+        i++;
+    }
+    return count;
+}
+
+int SlotStore::claimFreeOfClass(int slotClass) {
+    int words = reservedSlots / 64;
+    for (int s = 0; s * 64 < words; s++) {
+        uint64_t pending = classSummary[s * SLOT_CLASS_COUNT + slotClass].load(memory_order_acquire);
+        while (pending != 0) {
+            int w = s * 64 + __builtin_ctzll(pending);
+            int index = claimFirstFree(w * 64, w * 64 + 64, slotClass);
+            if (index >= 0) {
+                return index;
+            }
+            // Stale bit: drop it and move on, unless a slot came back meanwhile
+            if (!retireWord(w, slotClass)) {
+                pending &= pending - 1;
+            }
+        }
+    }
+    return -1;
+}
+
+int SlotStore::claimFreeOfClass(int slotClass, int* claimed, int maxCount) {
+    int count = 0;
+    int words = reservedSlots / 64;
+    for (int s = 0; s * 64 < words && count < maxCount; s++) {
+        uint64_t pending = classSummary[s * SLOT_CLASS_COUNT + slotClass].load(memory_order_acquire);
+        while (pending != 0 && count < maxCount) {
+            int w = s * 64 + __builtin_ctzll(pending);
+            count += claimFree(w * 64, w * 64 + 64, claimed + count, maxCount - count, slotClass);
+            if (count < maxCount && !retireWord(w, slotClass)) {
+                pending &= pending - 1; // Drained
+            }
+        }
+    }
+    return count;
+}
+
+void SlotStore::markWordFree(int word, uint64_t freed) {
+    // After the free bits, so a claim that clears the summary bit and then
+    // rereads the word either sees the slot or is followed by this set
+    uint64_t bit = uint64_t(1) << (word % 64);
+    for (int c = 0; c < SLOT_CLASS_COUNT; c++) {
+        if (classBits[word * SLOT_CLASS_COUNT + c] & freed) {
+            classSummary[(word / 64) * SLOT_CLASS_COUNT + c].fetch_or(bit, memory_order_acq_rel);
+        }
+    }
+}
+
+bool SlotStore::retireWord(int word, int slotClass) {
+    uint64_t bit = uint64_t(1) << (word % 64);
+    atomic<uint64_t>& summary = classSummary[(word / 64) * SLOT_CLASS_COUNT + slotClass];
+    summary.fetch_and(~bit, memory_order_acq_rel);
+    if (freeBits[word].load(memory_order_acquire) & classBits[word * SLOT_CLASS_COUNT + slotClass]) {
+        summary.fetch_or(bit, memory_order_acq_rel);
+        return true;
+    }
+    return false;
+}
+
+int SlotStore::getOwnerTag(int index) const {
+    return wordOwner[index / 64];
+}
+
+int SlotStore::getReservedSlots() const {
+    return reservedSlots;
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#ifndef SLOTSTORE_H
+#define SLOTSTORE_H
+
+#include <string>
+#include <cstdint>
+#include <atomic>
+#include "SlotClass.h"
+using namespace std;
+
+// Structure-of-arrays storage for every slot in one zone.
+// Slot state lives in parallel arrays indexed by slot position:
+//   freeBits  - availability, one bit per slot (set = free)
+//   occupant  - vehicle handle from SymbolTable::vehicles(), or NONE
+//   slotName  - slot id handle from SymbolTable::slots()
+//   classBits - per 64-slot word, one mask per SlotClass of the slots in it
+//   classSummary - per SlotClass, one bit per freeBits word that may hold a
+//                  free slot of that class
+// Areas reserve 64-aligned blocks, so an area's slots are whole words of
+// freeBits and a zone-wide availability scan touches only that one array.
+// Free bits are atomic words: a slot is claimed by a CAS that clears its
+// bit, so concurrent allocators can never both win the same slot.
+// Reserving blocks reallocates the arrays and must not race with claims.
+// Freeing a slot sets its word's summary bit; a class claim that finds the
+// word empty clears it. Class claims therefore go straight to words with
+// something to take instead of scanning the zone: one summary word covers
+// 4096 slots.
+class SlotStore {
+private:
+    int zoneHandle;     // Zone id handle from SymbolTable::zones()
+    atomic<uint64_t>* freeBits;
+    atomic<int>* occupant;
+    int* slotName;
+    int* wordOwner;     // Owner tag (area index) of each 64-slot word
+    uint64_t* classBits; // SLOT_CLASS_COUNT masks per word, set once per slot
+    atomic<uint64_t>* classSummary; // SLOT_CLASS_COUNT masks per 64 words
+    int reservedSlots;  // Always a multiple of 64
+    int capacity;       // Allocated slots, grows by doubling
+    
+public:
+    static const int ANY_CLASS = -1; // Class filter matching every slot
+    
+    SlotStore(const string& zoneId);
+    ~SlotStore();
+    
+    // Block management
+    int reserveBlock(int slotCount, int ownerTag); // Returns the block's base index
+    void initSlot(int index, const string& slotId, SlotClass slotClass = SlotClass::LARGE);
+    
+    // Per-slot state
+    bool isFree(int index) const;
+    bool setFree(int index, bool free); // False if the bit already had that value
+    bool tryClaim(int index);            // CAS the bit from free to taken
+    int getOccupant(int index) const;
+    void setOccupant(int index, int vehicleHandle);
+    int getSlotName(int index) const;
+    SlotClass getSlotClass(int index) const;
+    int getZoneHandle() const;
+    
+    // Scans over the availability bits. Claims and counts can be limited
+    // to one slot class (a SlotClass value cast to int) or take ANY_CLASS.
+    int findFirstFree(int from, int to) const; // -1 if none in [from, to)
+    int claimFirstFree(int from, int to, int slotClass = ANY_CLASS); // Find and claim; -1 if none left
+    int claimFree(int from, int to, int* claimed, int maxCount, int slotClass = ANY_CLASS); // Up to maxCount in one pass
+    int countFree(int from, int to, int slotClass = ANY_CLASS) const;
+    
+    // Zone-wide claims of one class through the summary, lowest index first
+    int claimFreeOfClass(int slotClass); // -1 if none left
+    int claimFreeOfClass(int slotClass, int* claimed, int maxCount); // Returns count taken
+    int getOwnerTag(int index) const;
+    int getReservedSlots() const;
+    
+private:
+    void grow(int minCapacity);
+    void markWordFree(int word, uint64_t freed); // Summary bits for the classes in freed
+    bool retireWord(int word, int slotClass);    // Clear its summary bit; true if a slot came back
+    SlotStore(const SlotStore&);
+    SlotStore& operator=(const SlotStore&);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "SymbolTable.h"
+using namespace std;
+
+SymbolTable::SymbolTable() : handles(FIRST_SEGMENT * 2), symbolCount(0) {
+    for (int i = 0; i < SEGMENT_COUNT; i++) {
+        segments[i] = nullptr;
+    }
+}
+
+SymbolTable::~SymbolTable() {
+    for (int i = 0; i < SEGMENT_COUNT; i++) {
+        delete[] segments[i];
+    }
+}
+
+string& SymbolTable::slotFor(int handle) const {
+    // Offsetting by the first segment size makes the segment number the
+    // position of the highest set bit
+    unsigned int position = (unsigned int)handle + FIRST_SEGMENT;
+    int segment = (31 - __builtin_clz(position)) - 6;
+    return segments[segment][position - ((unsigned int)FIRST_SEGMENT << segment)];
+}
+
+int SymbolTable::intern(const string& name) {
+    lock_guard<mutex> guard(internLock);
+    
+    const int* existing = handles.find(name);
+    if (existing != nullptr) {
+        return *existing;
+    }
+    
+    int handle = symbolCount.load(memory_order_relaxed);
+    unsigned int position = (unsigned int)handle + FIRST_SEGMENT;
+    int segment = (31 - __builtin_clz(position)) - 6;
+    if (segment >= SEGMENT_COUNT) {
+        return NONE;
+    }
+    if (segments[segment] == nullptr) {
+        segments[segment] = new string[FIRST_SEGMENT << segment];
+    }
+    
+    slotFor(handle) = name;
+    handles.insert(name, handle);
+    symbolCount.store(handle + 1, memory_order_release);
+    return handle;
+}
+
+int SymbolTable::find(const string& name) const {
+    lock_guard<mutex> guard(internLock);
+    const int* existing = handles.find(name);
+    return (existing != nullptr) ? *existing : NONE;
+}
+
+const string& SymbolTable::nameOf(int handle) const {
+    static const string empty;
+    if (handle < 0 || handle >= symbolCount.load(memory_order_acquire)) {
+        return empty;
+    }
+    return slotFor(handle);
+}
+
+int SymbolTable::size() const {
+    return symbolCount.load(memory_order_acquire);
+}
+
+SymbolTable& SymbolTable::slots() {
+    static SymbolTable table;
+    return table;
+}
+
+SymbolTable& SymbolTable::zones() {
+    static SymbolTable table;
+    return table;
+}
+
+SymbolTable& SymbolTable::vehicles() {
+    static SymbolTable table;
+    return table;
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#ifndef SYMBOLTABLE_H
+#define SYMBOLTABLE_H
+
+#include "HashIndex.h"
+#include <string>
+#include <atomic>
+#include <mutex>
+using namespace std;
+
+// Interns identifiers into dense integer handles (0, 1, 2, ...).
+// Handles are stable for the lifetime of the process and map back to
+// their original string in O(1). Names live in segments that double in
+// size and never move, so nameOf() needs no lock; interning is serialized.
+class SymbolTable {
+private:
+    static const int FIRST_SEGMENT = 64;  // Segment k holds FIRST_SEGMENT << k names
+    static const int SEGMENT_COUNT = 25;  // Room for over 2 billion handles
+    
+    HashIndex<int> handles;
+    string* segments[SEGMENT_COUNT];
+    atomic<int> symbolCount; // Published after the name is stored
+    mutable mutex internLock;
+    
+public:
+    static const int NONE = -1;
+    
+    SymbolTable();
+    ~SymbolTable();
+    
+    int intern(const string& name);     // Returns existing handle or assigns a new one
+    int find(const string& name) const; // Returns NONE if never interned
+    const string& nameOf(int handle) const;
+    int size() const;
+    
+    // Process-wide tables, one per identifier kind so handles stay dense
+    static SymbolTable& slots();
+    static SymbolTable& zones();
+    static SymbolTable& vehicles();
+    
+private:
+    string& slotFor(int handle) const;
+    
+    SymbolTable(const SymbolTable&);
+    SymbolTable& operator=(const SymbolTable&);
+};
+
+#endif
\ No newline at end of file
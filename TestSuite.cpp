@@ -1,9 +1,27 @@
 #include "TestSuite.h"
+#include "RequestQueue.h"
+#include "ConcurrentRequestQueue.h"
+#include "RequestDispatcher.h"
+#include "RequestScheduler.h"
+#include "Waitlist.h"
+#include "TimerWheel.h"
+#include "ReservationBook.h"
+#include "SymbolTable.h"
+#include "SlotStore.h"
+#include "ParkingArea.h"
+#include "Zone.h"
+#include "RequestManager.h"
+#include "DurationStats.h"
+#include "VehicleBST.h"
+#include "RollbackManager.h"
 #include <iostream>
 #include <cassert>
+#include <thread>
+#include <atomic>
+#include <chrono>
 using namespace std;
 
-TestSuite::TestSuite() : testsPassed(0), totalTests(10) {
+TestSuite::TestSuite() : testsPassed(0), totalTests(45) {
     system = new ParkingSystem();
 }
 
@@ -17,7 +35,7 @@ void TestSuite::printTestResult(const string& testName, bool passed) {
 }
 
 void TestSuite::runAllTests() {
-    cout << "\n=== RUNNING TEST SUITE (10 Tests) ===\n" << endl;
+    cout << "\n=== RUNNING TEST SUITE (45 Tests) ===\n" << endl;
     
     testsPassed = 0;
     
@@ -31,6 +49,41 @@ void TestSuite::runAllTests() {
     test8_BSTOperations();
     test9_InvalidTransitions();
     test10_AnalyticsAfterRollback();
+    test11_CapacityCounters();
+    test12_RollbackCustomTopology();
+    test13_QueueBeyondOldLimit();
+    test14_ConcurrentQueueIntegrity();
+    test15_ZoneWorkersPreserveOrder();
+    test16_ConcurrentClaimsNeverDoubleBook();
+    test17_PrioritySchedulingWithAging();
+    test18_WaitlistHandoffOnRelease();
+    test19_NearestZoneFallback();
+    test20_CapacityTreeFindsFreeZones();
+    test21_BatchAllocationByZone();
+    test22_MinCostBatchAssignment();
+    test23_AllocationPolicies();
+    test24_SlotClassPools();
+    test25_ReservationWindows();
+    test26_AllocationExpiry();
+    test27_LanesGrowPastRing();
+    test28_HandoffSkipsZonesWithoutWaiters();
+    test29_FixedPolicyThroughBasePointer();
+    test30_ZoneWindowIndex();
+    test31_BookedSlotsHeld();
+    test32_ClockDrivenExpiry();
+    test33_ClockOpensReservations();
+    test34_SlotStoreAndSymbols();
+    test35_ZoneRegistryGrowth();
+    test36_RequestIndex();
+    test37_StateCounters();
+    test38_DurationPercentiles();
+    test39_BalancedVehicleIndex();
+    test40_RollbackRingEviction();
+    test41_UndoAfterHandoff();
+    test42_ConcurrentLifecycles();
+    test43_AreaFreeBitmap();
+    test44_ClassSummaryClaims();
+    test45_MinCostClassCapacity();
     
     cout << "\n=== TEST SUITE COMPLETE ===" << endl;
     cout << "Tests Passed: " << testsPassed << "/" << totalTests << endl;
@@ -254,4 +307,1716 @@ void TestSuite::test10_AnalyticsAfterRollback() {
                   (requestsAfterRollback == initialRequests);
     
     printTestResult("Analytics Correctness After Rollback", passed);
+}
+
+void TestSuite::test11_CapacityCounters() {
+    cout << "\nTest 11: Capacity Counters Match Full Recount" << endl;
+    
+    // Counters must survive the allocations, releases, cancellations and
+    // rollbacks performed by the earlier tests
+    bool consistentBefore = system->verifyCapacityCounters();
+    
+    // Drain requests left in the queue by earlier tests
+    while (system->getPendingRequestCount() > 0) {
+        system->processNextRequest();
+    }
+    
+    string reqId = system->createParkingRequest("COUNTER-CAR", "Z1");
+    int availableBefore = system->getAvailableSlots();
+    system->processNextRequest();
+    int availableDuring = system->getAvailableSlots();
+    system->cancelRequest(reqId);
+    int availableAfter = system->getAvailableSlots();
+    
+    bool consistentAfter = system->verifyCapacityCounters();
+    
+    bool passed = consistentBefore && consistentAfter &&
+                  (system->getTotalSlots() == 10) &&
+                  (availableDuring == availableBefore - 1) &&
+                  (availableAfter == availableBefore);
+    
+    printTestResult("Capacity Counters Match Full Recount", passed);
+}
+
+void TestSuite::test12_RollbackCustomTopology() {
+    cout << "\nTest 12: Rollback and Slot Lookup Outside Default Layout" << endl;
+    
+    // Zone and area names that don't follow the default A1/A2/B1/C1 layout
+    system->addZone("Z4", "Harbor", 2);
+    system->addAreaToZone("Z4", "H7", 2);
+    system->addSlotToArea("Z4", "H7", "Z4-H7-S1");
+    bool duplicateRejected = !system->addSlotToArea("Z4", "H7", "Z4-H7-S1");
+    
+    ParkingSlot* slot = system->findSlot("Z4-H7-S1");
+    
+    string reqId = system->createParkingRequest("HARBOR-CAR", "Z4");
+    system->processNextRequest();
+    bool occupiedAfterAllocation = (slot != nullptr) && !slot->getAvailability();
+    
+    bool rollbackSuccess = system->rollbackLastOperation();
+    bool freedAfterRollback = (slot != nullptr) && slot->getAvailability();
+    
+    bool passed = duplicateRejected && (slot != nullptr) &&
+                  occupiedAfterAllocation && rollbackSuccess && freedAfterRollback &&
+                  system->verifyCapacityCounters();
+    
+    printTestResult("Rollback and Slot Lookup Outside Default Layout", passed);
+}
+
+void TestSuite::test13_QueueBeyondOldLimit() {
+    cout << "\nTest 13: Queue Growth Beyond 100 Pending Requests" << endl;
+    
+    const int requestCount = 250;
+    Vehicle vehicle("QUEUE-BURST", "Sedan", "Z1");
+    ParkingRequest** requests = new ParkingRequest*[requestCount];
+    for (int i = 0; i < requestCount; i++) {
+        requests[i] = new ParkingRequest("QB" + to_string(i), &vehicle, "Z1");
+    }
+    
+    // Start small and move the head first so growth has to unwrap the ring
+    RequestQueue queue(4);
+    queue.enqueue(requests[0]);
+    queue.enqueue(requests[1]);
+    bool orderKept = (queue.dequeue() == requests[0]);
+    for (int i = 2; i < requestCount; i++) {
+        queue.enqueue(requests[i]);
+    }
+    bool allQueued = (queue.getSize() == requestCount - 1);
+    
+    for (int i = 1; i < requestCount; i++) {
+        if (queue.dequeue() != requests[i]) {
+            orderKept = false;
+        }
+    }
+    bool drained = queue.isEmpty() && (queue.dequeue() == nullptr);
+    
+    // An explicit bound still rejects requests once reached
+    RequestQueue bounded(4, 3);
+    bool boundRespected = bounded.enqueue(requests[0]) && bounded.enqueue(requests[1]) &&
+                          bounded.enqueue(requests[2]) && !bounded.enqueue(requests[3]);
+    
+    for (int i = 0; i < requestCount; i++) {
+        delete requests[i];
+    }
+    delete[] requests;
+    
+    bool passed = orderKept && allQueued && drained && boundRespected;
+    
+    printTestResult("Queue Growth Beyond 100 Pending Requests", passed);
+}
+
+void TestSuite::test14_ConcurrentQueueIntegrity() {
+    cout << "\nTest 14: Concurrent Queue Delivers Each Request Exactly Once" << endl;
+    
+    const int producerCount = 2;
+    const int consumerCount = 2;
+    const int perProducer = 20000;
+    const int requestCount = producerCount * perProducer;
+    
+    ParkingRequest* requests = new ParkingRequest[requestCount];
+    int* deliveries = new int[requestCount];
+    for (int i = 0; i < requestCount; i++) {
+        deliveries[i] = 0;
+    }
+    
+    // Small capacity so producers regularly find the queue full
+    ConcurrentRequestQueue queue(64);
+    atomic<int> consumed(0);
+    atomic<bool> orderBroken(false);
+    int* consumerSeen[consumerCount];
+    
+    thread producers[producerCount];
+    thread consumers[consumerCount];
+    
+    for (int c = 0; c < consumerCount; c++) {
+        consumerSeen[c] = new int[requestCount + 1];
+        consumers[c] = thread([&, c]() {
+            int count = 0;
+            int lastFromProducer[producerCount];
+            for (int p = 0; p < producerCount; p++) {
+                lastFromProducer[p] = -1;
+            }
+            while (consumed.load() < requestCount) {
+                ParkingRequest* request = queue.dequeue();
+                if (request == nullptr) {
+                    this_thread::yield();
+                    continue;
+                }
+                int index = (int)(request - requests);
+                // Each producer's requests must come out in the order it pushed them
+                int producer = index / perProducer;
+                if (index <= lastFromProducer[producer]) {
+                    orderBroken.store(true);
+                }
+                lastFromProducer[producer] = index;
+                consumerSeen[c][count++] = index;
+                consumed.fetch_add(1);
+            }
+            consumerSeen[c][count] = -1;
+        });
+    }
+    
+    for (int p = 0; p < producerCount; p++) {
+        producers[p] = thread([&, p]() {
+            for (int i = p * perProducer; i < (p + 1) * perProducer; i++) {
+                while (!queue.enqueue(&requests[i])) {
+                    this_thread::yield();
+                }
+            }
+        });
+    }
+    
+    for (int p = 0; p < producerCount; p++) {
+        producers[p].join();
+    }
+    for (int c = 0; c < consumerCount; c++) {
+        consumers[c].join();
+    }
+    
+    for (int c = 0; c < consumerCount; c++) {
+        for (int i = 0; consumerSeen[c][i] >= 0; i++) {
+            deliveries[consumerSeen[c][i]]++;
+        }
+        delete[] consumerSeen[c];
+    }
+    
+    bool exactlyOnce = true;
+    for (int i = 0; i < requestCount; i++) {
+        if (deliveries[i] != 1) {
+            exactlyOnce = false;
+        }
+    }
+    
+    bool passed = exactlyOnce && !orderBroken.load() && queue.isEmpty() &&
+                  (queue.dequeue() == nullptr);
+    
+    delete[] deliveries;
+    delete[] requests;
+    
+    printTestResult("Concurrent Queue Delivers Each Request Exactly Once", passed);
+}
+
+void TestSuite::test15_ZoneWorkersPreserveOrder() {
+    cout << "\nTest 15: Allocation Workers Preserve Per-Zone Order" << endl;
+    
+    // Separate system so the shared one keeps its default occupancy
+    ParkingSystem workerSystem;
+    const int perZone = 24;
+    const string zoneIds[] = {"Z8", "Z9"};
+    
+    for (int z = 0; z < 2; z++) {
+        workerSystem.addZone(zoneIds[z], "Workers", 1);
+        workerSystem.addAreaToZone(zoneIds[z], "P", perZone);
+        for (int i = 0; i < perZone; i++) {
+            workerSystem.addSlotToArea(zoneIds[z], "P", zoneIds[z] + "-P-S" + to_string(i));
+        }
+    }
+    
+    // Requests arrive while the workers are already running
+    bool started = workerSystem.startAllocationWorkers(2);
+    for (int i = 0; i < perZone; i++) {
+        for (int z = 0; z < 2; z++) {
+            workerSystem.createParkingRequest(zoneIds[z] + "-CAR-" + to_string(i), zoneIds[z]);
+        }
+    }
+    
+    for (int waited = 0; waited < 10000 && workerSystem.getTotalRequests() < 2 * perZone; waited++) {
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    workerSystem.stopAllocationWorkers();
+    
+    // First-fit within a zone means the i-th request must hold the i-th slot
+    bool orderKept = true;
+    for (int z = 0; z < 2; z++) {
+        for (int i = 0; i < perZone; i++) {
+            ParkingSlot* slot = workerSystem.findSlot(zoneIds[z] + "-P-S" + to_string(i));
+            if (slot == nullptr || slot->getVehicleId() != zoneIds[z] + "-CAR-" + to_string(i)) {
+                orderKept = false;
+            }
+        }
+    }
+    
+    bool passed = started && orderKept &&
+                  (workerSystem.getTotalRequests() == 2 * perZone) &&
+                  (workerSystem.getPendingRequestCount() == 0) &&
+                  !workerSystem.areAllocationWorkersRunning() &&
+                  workerSystem.verifyCapacityCounters();
+    
+    printTestResult("Allocation Workers Preserve Per-Zone Order", passed);
+}
+
+void TestSuite::test16_ConcurrentClaimsNeverDoubleBook() {
+    cout << "\nTest 16: Concurrent Slot Claims Never Double-Book" << endl;
+    
+    // Two areas so claims cross word and area boundaries
+    Zone zone("Z10", "Claims", 2);
+    zone.addArea("A", 100);
+    zone.addArea("B", 40);
+    for (int i = 0; i < 100; i++) {
+        zone.findArea("A")->addSlot("Z10-A-S" + to_string(i));
+    }
+    for (int i = 0; i < 40; i++) {
+        zone.findArea("B")->addSlot("Z10-B-S" + to_string(i));
+    }
+    
+    // Every thread claims until the zone runs dry
+    const int threadCount = 4;
+    atomic<int> claims(0);
+    atomic<int> duplicates(0);
+    atomic<int> owners[140];
+    for (int i = 0; i < 140; i++) {
+        owners[i] = 0;
+    }
+    
+    thread claimers[threadCount];
+    for (int t = 0; t < threadCount; t++) {
+        claimers[t] = thread([&zone, &claims, &duplicates, &owners]() {
+            ParkingSlot* slot;
+            while ((slot = zone.claimAvailableSlotInZone()) != nullptr) {
+                ParkingArea* area = slot->getParentArea();
+                int index = (area->getAreaId() == "A" ? 0 : 100) + (int)(slot - area->getSlotAt(0));
+                if (owners[index].fetch_add(1) != 0) {
+                    duplicates++;
+                }
+                claims++;
+            }
+        });
+    }
+    for (int t = 0; t < threadCount; t++) {
+        claimers[t].join();
+    }
+    
+    // Free one slot and let every thread race for it
+    ParkingSlot* last = zone.findArea("B")->getSlotAt(39);
+    last->setAvailability(true);
+    atomic<int> lastWinners(0);
+    for (int t = 0; t < threadCount; t++) {
+        claimers[t] = thread([last, &lastWinners]() {
+            if (last->tryClaim()) {
+                lastWinners++;
+            }
+        });
+    }
+    for (int t = 0; t < threadCount; t++) {
+        claimers[t].join();
+    }
+    
+    bool passed = (claims == 140) && (duplicates == 0) && (lastWinners == 1) &&
+                  (zone.getAvailableSlots() == 0) &&
+                  (zone.claimAvailableSlotInZone() == nullptr) &&
+                  zone.verifyCounters();
+    
+    printTestResult("Concurrent Slot Claims Never Double-Book", passed);
+}
+
+void TestSuite::test17_PrioritySchedulingWithAging() {
+    cout << "\nTest 17: Priority Scheduling with Aging" << endl;
+    
+    Vehicle vehicle("V-SCHED", "Car", "Z1");
+    ParkingRequest oldWalkIn("S-OLD", &vehicle, "Z1");
+    ParkingRequest permit("S-PERMIT", &vehicle, "Z1");
+    ParkingRequest lateWalkIn("S-LATE", &vehicle, "Z1");
+    ParkingRequest accessible("S-ACCESS", &vehicle, "Z1");
+    permit.setPriorityClass(PriorityClass::PERMIT);
+    accessible.setPriorityClass(PriorityClass::ACCESSIBLE);
+    
+    // Default head starts: permit 5 min, accessible 15 min. The walk-in has
+    // waited 6.6 min longer than the permit holder, so it is served first.
+    RequestScheduler scheduler(2);
+    scheduler.enqueue(&oldWalkIn, 0);
+    scheduler.enqueue(&permit, 400000);
+    scheduler.enqueue(&lateWalkIn, 500000);
+    scheduler.enqueue(&accessible, 500000);
+    
+    // Promoted in place; ties with the other accessible request on key and
+    // wins on arrival order
+    bool updated = scheduler.updatePriority("S-LATE", PriorityClass::ACCESSIBLE);
+    bool unknownRejected = !scheduler.updatePriority("S-NONE", PriorityClass::PERMIT);
+    
+    const ParkingRequest* expected[] = {&lateWalkIn, &accessible, &oldWalkIn, &permit};
+    bool orderCorrect = true;
+    for (int i = 0; i < 4; i++) {
+        if (scheduler.dequeue() != expected[i]) {
+            orderCorrect = false;
+        }
+    }
+    
+    // Through the system: an accessible request overtakes an earlier walk-in
+    ParkingSystem prioritySystem;
+    bool switched = prioritySystem.setSchedulingPolicy(SchedulingPolicy::PRIORITY);
+    string walkInId = prioritySystem.createParkingRequest("V-WALK", "Z1");
+    string accessibleId = prioritySystem.createParkingRequest("V-ACCESS", "Z1", PriorityClass::ACCESSIBLE);
+    prioritySystem.processNextRequest();
+    bool systemOrder = !prioritySystem.updateRequestPriority(accessibleId, PriorityClass::STANDARD) &&
+                       prioritySystem.updateRequestPriority(walkInId, PriorityClass::PERMIT) &&
+                       (prioritySystem.getPendingRequestCount() == 1);
+    bool workersRefused = !prioritySystem.startAllocationWorkers(1);
+    prioritySystem.processNextRequest();
+    
+    bool passed = updated && unknownRejected && orderCorrect && scheduler.isEmpty() &&
+                  (scheduler.getCapacity() >= 4) && (oldWalkIn.getSchedulerPosition() == -1) &&
+                  switched && systemOrder && workersRefused &&
+                  (prioritySystem.getPendingRequestCount() == 0);
+    
+    printTestResult("Priority Scheduling with Aging", passed);
+}
+
+void TestSuite::test18_WaitlistHandoffOnRelease() {
+    cout << "\nTest 18: Waitlist Handoff on Release" << endl;
+    
+    // Fill every slot; the first two requests land in Z1-A1-S1 and S2
+    ParkingSystem waitSystem;
+    string first;
+    string second;
+    for (int i = 0; waitSystem.getAvailableSlots() > 0 && i < 100; i++) {
+        string reqId = waitSystem.createParkingRequest("FILL-" + to_string(i), "Z1");
+        waitSystem.processNextRequest();
+        if (i == 0) {
+            first = reqId;
+        } else if (i == 1) {
+            second = reqId;
+        }
+    }
+    
+    string waiting = waitSystem.createParkingRequest("WAIT-1", "Z1");
+    waitSystem.processNextRequest();
+    string abandoned = waitSystem.createParkingRequest("WAIT-2", "Z1");
+    waitSystem.processNextRequest();
+    bool bothWaiting = (waitSystem.getWaitlistedCount() == 2);
+    bool abandonedCancelled = waitSystem.cancelRequest(abandoned) &&
+                              (waitSystem.getWaitlistedCount() == 1);
+    
+    // Releasing a Z1 slot hands it straight to the oldest Z1 waiter
+    waitSystem.markAsOccupied(first);
+    waitSystem.markAsReleased(first);
+    ParkingSlot* freed = waitSystem.findSlot("Z1-A1-S1");
+    bool handedOff = (freed != nullptr) && (freed->getVehicleId() == "WAIT-1") &&
+                     (waitSystem.getAvailableSlots() == 0) &&
+                     waitSystem.markAsOccupied(waiting);
+    
+    // The cancelled waiter left the Z1 waitlist, so the next Z1 slot goes
+    // to the Z2 waiter instead
+    string neighbour = waitSystem.createParkingRequest("WAIT-3", "Z2");
+    waitSystem.processNextRequest();
+    waitSystem.cancelRequest(second);
+    ParkingSlot* freedAgain = waitSystem.findSlot("Z1-A1-S2");
+    bool crossZoneHandoff = (freedAgain != nullptr) && (freedAgain->getVehicleId() == "WAIT-3") &&
+                            waitSystem.markAsOccupied(neighbour);
+    
+    bool passed = bothWaiting && abandonedCancelled && handedOff && crossZoneHandoff &&
+                  (waitSystem.getWaitlistedCount() == 0) &&
+                  waitSystem.verifyCapacityCounters();
+    
+    printTestResult("Waitlist Handoff on Release", passed);
+}
+
+void TestSuite::test19_NearestZoneFallback() {
+    cout << "\nTest 19: Nearest Zone Fallback" << endl;
+    
+    // Z4, Z5 and Z6 (one slot each) form their own component: Z6 is
+    // nearest to Z4, and Z5 is closer through Z6 than by its direct edge
+    ParkingSystem graphSystem;
+    const char* zoneIds[] = {"Z4", "Z5", "Z6"};
+    for (const char* zoneId : zoneIds) {
+        string id = zoneId;
+        graphSystem.addZone(id, "Outer " + id, 1);
+        graphSystem.addAreaToZone(id, "R1", 1);
+        graphSystem.addSlotToArea(id, "R1", id + "-R1-S1");
+    }
+    bool edgesAdded = graphSystem.addZoneAdjacency("Z4", "Z5", 5) &&
+                      graphSystem.addZoneAdjacency("Z4", "Z6", 1) &&
+                      graphSystem.addZoneAdjacency("Z6", "Z5", 2) &&
+                      !graphSystem.addZoneAdjacency("Z4", "Z9", 1) &&
+                      !graphSystem.addZoneAdjacency("Z4", "Z4", 1);
+    
+    string reqIds[4];
+    for (int i = 0; i < 4; i++) {
+        reqIds[i] = graphSystem.createParkingRequest("NEAR-" + to_string(i), "Z4");
+        graphSystem.processNextRequest();
+    }
+    
+    // Registry order would have tried Z5 before Z6; the unconnected
+    // default zones only take the overflow
+    bool nearestFirst = (graphSystem.findSlot("Z4-R1-S1")->getVehicleId() == "NEAR-0") &&
+                        (graphSystem.findSlot("Z6-R1-S1")->getVehicleId() == "NEAR-1") &&
+                        (graphSystem.findSlot("Z5-R1-S1")->getVehicleId() == "NEAR-2") &&
+                        (graphSystem.findSlot("Z1-A1-S1")->getVehicleId() == "NEAR-3");
+    
+    // A shorter Z4-Z5 edge drops the cached order; Z5 now ties with Z6 and
+    // wins on registry order
+    graphSystem.cancelRequest(reqIds[1]);
+    graphSystem.cancelRequest(reqIds[2]);
+    graphSystem.addZoneAdjacency("Z4", "Z5", 1);
+    graphSystem.createParkingRequest("NEAR-4", "Z4");
+    graphSystem.processNextRequest();
+    bool reordered = (graphSystem.findSlot("Z5-R1-S1")->getVehicleId() == "NEAR-4") &&
+                     graphSystem.findSlot("Z6-R1-S1")->getAvailability();
+    
+    bool passed = edgesAdded && nearestFirst && reordered && graphSystem.verifyCapacityCounters();
+    
+    printTestResult("Nearest Zone Fallback", passed);
+}
+
+void TestSuite::test20_CapacityTreeFindsFreeZones() {
+    cout << "\nTest 20: Capacity Tree Finds Free Zones" << endl;
+    
+    // 40 one-slot zones grow the tree past its initial 16 entries; even
+    // zones get their slot before registration, odd ones after
+    const int zoneCount = 40;
+    ZoneRegistry registry(4);
+    for (int z = 0; z < zoneCount; z++) {
+        string zoneId = "CT" + to_string(z);
+        Zone* zone = new Zone(zoneId, "Tree", 1);
+        zone->addArea("A", 1);
+        if (z % 2 == 0) {
+            zone->findArea("A")->addSlot(zoneId + "-S1");
+        }
+        registry.addZone(zone);
+        if (z % 2 == 1) {
+            zone->findArea("A")->addSlot(zoneId + "-S1");
+        }
+    }
+    
+    // Fill everything but zones 5 and 33
+    for (int z = 0; z < zoneCount; z++) {
+        if (z != 5 && z != 33) {
+            registry.getZoneAt(z)->claimAvailableSlotInZone();
+        }
+    }
+    bool foundAndWrapped = (registry.findZoneWithCapacity(0) == 5) &&
+                           (registry.findZoneWithCapacity(6) == 33) &&
+                           (registry.findZoneWithCapacity(34) == 5) &&
+                           (registry.getAvailableSlotsInRange(0, zoneCount) == 2) &&
+                           (registry.getAvailableSlotsInRange(6, 33) == 0);
+    
+    // Releases and claims move the answers
+    registry.getZoneAt(20)->findArea("A")->getSlotAt(0)->setAvailability(true);
+    registry.getZoneAt(5)->claimAvailableSlotInZone();
+    registry.getZoneAt(33)->claimAvailableSlotInZone();
+    bool followsTransitions = (registry.findZoneWithCapacity(6) == 20) &&
+                              (registry.findZoneWithCapacity(21) == 20) &&
+                              (registry.getAvailableSlotsInRange(0, 20) == 0) &&
+                              (registry.getAvailableSlotsInRange(20, 21) == 1);
+    
+    registry.getZoneAt(20)->claimAvailableSlotInZone();
+    bool allFull = (registry.findZoneWithCapacity(0) == -1) &&
+                   (registry.getAvailableSlots() == 0);
+    
+    bool passed = foundAndWrapped && followsTransitions && allFull;
+    
+    printTestResult("Capacity Tree Finds Free Zones", passed);
+}
+
+void TestSuite::test21_BatchAllocationByZone() {
+    cout << "\nTest 21: Batch Allocation by Zone" << endl;
+    
+    // 11 requests for 10 slots, zones interleaved: Z1 x6 (5 slots),
+    // Z2 x3 (2 slots), Z3 x2 (3 slots)
+    ParkingSystem batchSystem;
+    const char* zones[] = {"Z1", "Z2", "Z1", "Z3", "Z2", "Z1", "Z1", "Z2", "Z1", "Z3", "Z1"};
+    const int requestCount = 11;
+    for (int i = 0; i < requestCount; i++) {
+        batchSystem.createParkingRequest("BATCH-" + to_string(i), zones[i]);
+    }
+    
+    bool rejectsEmptyBatch = (batchSystem.processPendingBatch(0) == 0) &&
+                             (batchSystem.getPendingRequestCount() == requestCount);
+    int allocated = batchSystem.processPendingBatch(50);
+    
+    // Each zone serves its own requests in arrival order; the third Z2
+    // request overflows into Z3's last slot, the sixth Z1 request waits
+    bool groupedInOrder = (batchSystem.findSlot("Z1-A1-S1")->getVehicleId() == "BATCH-0") &&
+                          (batchSystem.findSlot("Z1-A2-S2")->getVehicleId() == "BATCH-8") &&
+                          (batchSystem.findSlot("Z2-B1-S2")->getVehicleId() == "BATCH-4") &&
+                          (batchSystem.findSlot("Z3-C1-S3")->getVehicleId() == "BATCH-7");
+    bool drained = (allocated == 10) && (batchSystem.getPendingRequestCount() == 0) &&
+                   (batchSystem.getWaitlistedCount() == 1) && (batchSystem.getAvailableSlots() == 0);
+    
+    // Records were pushed in arrival order, so the last one undone is the
+    // second Z3 request
+    bool rolledBack = batchSystem.rollbackLastOperation() &&
+                      batchSystem.findSlot("Z3-C1-S2")->getAvailability() &&
+                      (batchSystem.getAvailableSlots() == 1);
+    
+    bool passed = rejectsEmptyBatch && groupedInOrder && drained && rolledBack &&
+                  batchSystem.verifyCapacityCounters();
+    
+    printTestResult("Batch Allocation by Zone", passed);
+}
+
+void TestSuite::test22_MinCostBatchAssignment() {
+    cout << "\nTest 22: Min-Cost Batch Assignment" << endl;
+    
+    // One slot each in X, Y, M and F; X-M and Y-M at distance 1, X-F at 5.
+    // X and Y get one request too many. Greedily X's overflow takes M and
+    // Y's is pushed out to F (distance 7); matched together X's goes to F
+    // and Y's to M, 6 in total instead of 8
+    const char* zones[] = {"X", "Y", "M", "F"};
+    string inM[2];
+    string inF[2];
+    bool consistent = true;
+    
+    for (int mode = 0; mode < 2; mode++) {
+        ParkingSystem matchSystem;
+        for (int z = 0; z < 4; z++) {
+            string zoneId = zones[z];
+            matchSystem.addZone(zoneId, "Zone " + zoneId, 1);
+            matchSystem.addAreaToZone(zoneId, zoneId + "-A", 1);
+            matchSystem.addSlotToArea(zoneId, zoneId + "-A", zoneId + "-S1");
+        }
+        matchSystem.addZoneAdjacency("X", "M", 1);
+        matchSystem.addZoneAdjacency("Y", "M", 1);
+        matchSystem.addZoneAdjacency("X", "F", 5);
+        
+        matchSystem.createParkingRequest("MC-X1", "X");
+        matchSystem.createParkingRequest("MC-X2", "X");
+        matchSystem.createParkingRequest("MC-Y1", "Y");
+        matchSystem.createParkingRequest("MC-Y2", "Y");
+        
+        BatchAssignment assignment = (mode == 0) ? BatchAssignment::GREEDY : BatchAssignment::MIN_COST;
+        int allocated = matchSystem.processPendingBatch(10, assignment);
+        
+        inM[mode] = matchSystem.findSlot("M-S1")->getVehicleId();
+        inF[mode] = matchSystem.findSlot("F-S1")->getVehicleId();
+        consistent = consistent && (allocated == 4) &&
+                     (matchSystem.findSlot("X-S1")->getVehicleId() == "MC-X1") &&
+                     (matchSystem.findSlot("Y-S1")->getVehicleId() == "MC-Y1") &&
+                     matchSystem.verifyCapacityCounters();
+        
+        // Cross-zone slots are recorded like any other allocation
+        consistent = consistent && matchSystem.rollbackLastOperation() &&
+                     (matchSystem.getAvailableSlots() == matchSystem.getTotalSlots() - 3);
+    }
+    
+    bool greedyNearestFirst = (inM[0] == "MC-X2") && (inF[0] == "MC-Y2");
+    bool matchedCheaper = (inM[1] == "MC-Y2") && (inF[1] == "MC-X2");
+    bool passed = consistent && greedyNearestFirst && matchedCheaper;
+    
+    printTestResult("Min-Cost Batch Assignment", passed);
+}
+
+void TestSuite::test23_AllocationPolicies() {
+    cout << "\nTest 23: Allocation Policies" << endl;
+    
+    // PP has areas A (3 slots) and B (2). LO's one slot is taken; its
+    // neighbours N1 (3 of 4 taken) and N2 (empty) are both at distance 1
+    ZoneRegistry registry(4);
+    Zone* packed = new Zone("PP", "Policy", 2);
+    packed->addArea("A", 3);
+    packed->addArea("B", 2);
+    for (int i = 1; i <= 3; i++) {
+        packed->findArea("A")->addSlot("PP-A-S" + to_string(i));
+    }
+    for (int i = 1; i <= 2; i++) {
+        packed->findArea("B")->addSlot("PP-B-S" + to_string(i));
+    }
+    registry.addZone(packed);
+    const char* ringZones[] = {"LO", "N1", "N2"};
+    const int ringSlots[] = {1, 4, 4};
+    for (int z = 0; z < 3; z++) {
+        string zoneId = ringZones[z];
+        Zone* zone = new Zone(zoneId, "Policy", 1);
+        zone->addArea("A", ringSlots[z]);
+        for (int i = 1; i <= ringSlots[z]; i++) {
+            zone->findArea("A")->addSlot(zoneId + "-A-S" + to_string(i));
+        }
+        registry.addZone(zone);
+    }
+    registry.findZone("LO")->claimAvailableSlotInZone();
+    for (int i = 0; i < 3; i++) {
+        registry.findZone("N1")->claimAvailableSlotInZone();
+    }
+    
+    PolicyAllocationEngine<FirstFitPolicy> firstFit(&registry);
+    PolicyAllocationEngine<BestFitAreaPolicy> bestFit(&registry);
+    PolicyAllocationEngine<LeastLoadedZonePolicy> leastLoaded(&registry);
+    PolicyAllocationEngine<RoundRobinAreaPolicy> roundRobin(&registry);
+    AllocationEngine runtime(&registry);
+    AllocationEngine* graphs[] = {&firstFit, &leastLoaded};
+    for (AllocationEngine* engine : graphs) {
+        engine->addZoneAdjacency("LO", "N1");
+        engine->addZoneAdjacency("LO", "N2");
+    }
+    
+    // Each claim gets a fresh request and its slot is handed back after
+    Vehicle vehicle("V-POLICY", "Car", "PP");
+    ParkingRequest* requests[8];
+    for (int i = 0; i < 8; i++) {
+        requests[i] = new ParkingRequest("POL" + to_string(i), &vehicle, (i < 6) ? "PP" : "LO");
+    }
+    string claimed[8];
+    ParkingSlot* slot = nullptr;
+    
+    slot = firstFit.claimSlot(requests[0]);
+    claimed[0] = slot->getSlotId();
+    slot->setAvailability(true);
+    slot = bestFit.claimSlot(requests[1]);
+    claimed[1] = slot->getSlotId();
+    slot->setAvailability(true);
+    for (int i = 2; i < 4; i++) {
+        slot = roundRobin.claimSlot(requests[i]);
+        claimed[i] = slot->getSlotId();
+        slot->setAvailability(true);
+    }
+    
+    // The runtime switch runs whichever policy is set
+    runtime.setPolicy(AllocationPolicy::BEST_FIT_AREA);
+    slot = runtime.claimSlot(requests[4]);
+    claimed[4] = slot->getSlotId();
+    slot->setAvailability(true);
+    runtime.setPolicy(AllocationPolicy::FIRST_FIT);
+    slot = runtime.claimSlot(requests[5]);
+    claimed[5] = slot->getSlotId();
+    slot->setAvailability(true);
+    
+    // LO is full: first-fit takes the first neighbour in fallback order,
+    // least-loaded the emptier one
+    slot = firstFit.claimSlot(requests[6]);
+    claimed[6] = slot->getSlotId();
+    slot->setAvailability(true);
+    slot = leastLoaded.claimSlot(requests[7]);
+    claimed[7] = slot->getSlotId();
+    slot->setAvailability(true);
+    
+    bool slotChoice = (claimed[0] == "PP-A-S1") && (claimed[1] == "PP-B-S1") &&
+                      (claimed[2] == "PP-A-S1") && (claimed[3] == "PP-A-S2");
+    bool runtimeSwitch = (claimed[4] == "PP-B-S1") && (claimed[5] == "PP-A-S1");
+    bool overflowChoice = (claimed[6] == "N1-A-S4") && (claimed[7] == "N2-A-S1") &&
+                          requests[7]->isCrossZoneAllocation();
+    
+    ParkingSystem policySystem;
+    policySystem.setAllocationPolicy(AllocationPolicy::ROUND_ROBIN_AREA);
+    bool systemPolicy = (policySystem.getAllocationPolicy() == AllocationPolicy::ROUND_ROBIN_AREA);
+    
+    bool countersIntact = (registry.getAvailableSlots() == 10);
+    for (int z = 0; z < registry.getZoneCount(); z++) {
+        countersIntact = countersIntact && registry.getZoneAt(z)->verifyCounters();
+    }
+    
+    bool passed = slotChoice && runtimeSwitch && overflowChoice && systemPolicy && countersIntact &&
+                  (leastLoaded.getPolicy() == AllocationPolicy::LEAST_LOADED_ZONE);
+    
+    for (int i = 0; i < 8; i++) {
+        delete requests[i];
+    }
+    
+    printTestResult("Allocation Policies", passed);
+}
+
+void TestSuite::test24_SlotClassPools() {
+    cout << "\nTest 24: Slot Class Pools" << endl;
+    
+    // VC's area has one slot of each class; its neighbour VO one large slot
+    ZoneRegistry registry(2);
+    Zone* classed = new Zone("VC", "Classes", 1);
+    classed->addArea("A", 4);
+    const SlotClass classes[] = {SlotClass::MOTORCYCLE, SlotClass::COMPACT, SlotClass::STANDARD, SlotClass::LARGE};
+    for (int i = 0; i < 4; i++) {
+        classed->findArea("A")->addSlot("VC-A-S" + to_string(i + 1), classes[i]);
+    }
+    registry.addZone(classed);
+    Zone* neighbour = new Zone("VO", "Classes", 1);
+    neighbour->addArea("A", 1);
+    neighbour->findArea("A")->addSlot("VO-A-S1", SlotClass::LARGE);
+    registry.addZone(neighbour);
+    
+    AllocationEngine engine(&registry);
+    engine.addZoneAdjacency("VC", "VO");
+    
+    bool classification = (slotClassForVehicle("Motorcycle") == SlotClass::MOTORCYCLE) &&
+                          (slotClassForVehicle("suv") == SlotClass::LARGE) &&
+                          (slotClassForVehicle("Sedan") == SlotClass::STANDARD) &&
+                          (slotClassForVehicle("Unknown") == SlotClass::STANDARD);
+    
+    // Two motorcycles, two trucks, then a sedan
+    Vehicle motorcycle("V-MOTO", "Motorcycle", "VC");
+    Vehicle truck("V-TRUCK", "Truck", "VC");
+    Vehicle sedan("V-SEDAN", "Sedan", "VC");
+    Vehicle* vehicles[] = {&motorcycle, &motorcycle, &truck, &truck, &sedan};
+    ParkingRequest* requests[5];
+    string claimed[5];
+    for (int i = 0; i < 5; i++) {
+        requests[i] = new ParkingRequest("CLS" + to_string(i), vehicles[i], "VC");
+    }
+    
+    // The second motorcycle falls back to the compact slot; the second truck
+    // leaves VC for VO although VC's standard slot is still free
+    for (int i = 0; i < 4; i++) {
+        ParkingSlot* slot = engine.claimSlot(requests[i]);
+        claimed[i] = (slot != nullptr) ? slot->getSlotId() : "";
+    }
+    bool truckSkipsSmall = (classed->getAvailableSlotsFor(SlotClass::LARGE) == 0) &&
+                           (classed->getAvailableSlotsFor(SlotClass::STANDARD) == 1);
+    ParkingSlot* sedanSlot = engine.claimSlot(requests[4]);
+    claimed[4] = (sedanSlot != nullptr) ? sedanSlot->getSlotId() : "";
+    
+    bool placement = (claimed[0] == "VC-A-S1") && (claimed[1] == "VC-A-S2") &&
+                     (claimed[2] == "VC-A-S4") && (claimed[3] == "VO-A-S1") &&
+                     requests[3]->isCrossZoneAllocation() && (claimed[4] == "VC-A-S3");
+    
+    // Releasing the first truck's slot shows up in the large-class counters
+    bool classCounters = (registry.getAvailableSlots(SlotClass::LARGE) == 0);
+    requests[2]->getAllocatedSlot()->setAvailability(true);
+    classCounters = classCounters && (registry.getAvailableSlots(SlotClass::LARGE) == 1) &&
+                    (registry.getTotalSlots(SlotClass::LARGE) == 2) &&
+                    (registry.getTotalSlots(SlotClass::MOTORCYCLE) == 1) &&
+                    (classed->getAvailableSlots(SlotClass::LARGE) == 1) &&
+                    classed->verifyCounters() && neighbour->verifyCounters();
+    
+    // A small freed slot goes to the oldest waiter that fits it, past a truck
+    Waitlist waitlist;
+    waitlist.addZone("VC");
+    ParkingRequest waitingTruck("CLS-WT", &truck, "VC");
+    ParkingRequest waitingMotorcycle("CLS-WM", &motorcycle, "VC");
+    waitlist.add(&waitingTruck);
+    waitlist.add(&waitingMotorcycle);
+    bool waitlistFits = (waitlist.takeOldest("VC", SlotClass::COMPACT) == &waitingMotorcycle) &&
+                        (waitlist.takeOldest("VC", SlotClass::COMPACT) == nullptr) &&
+                        (waitlist.takeOldest("VC") == &waitingTruck);
+    
+    bool passed = classification && truckSkipsSmall && placement && classCounters && waitlistFits;
+    
+    for (int i = 0; i < 5; i++) {
+        delete requests[i];
+    }
+    
+    printTestResult("Slot Class Pools", passed);
+}
+
+void TestSuite::test25_ReservationWindows() {
+    cout << "\nTest 25: Reservation Windows" << endl;
+    
+    // Z2 has two slots, B1-S1 and B1-S2; vehicles are V1000..V1002
+    ParkingSystem bookSystem;
+    for (int i = 0; i < 3; i++) {
+        bookSystem.addVehicle("Sedan", "Z2");
+    }
+    time_t base = time(0) + 3600;
+    
+    // Overlapping windows land on different slots; a third has no room
+    string first = bookSystem.reserveSlot("V1000", "Z2", base, base + 3600);
+    string second = bookSystem.reserveSlot("V1001", "Z2", base + 1800, base + 5400);
+    string third = bookSystem.reserveSlot("V1002", "Z2", base + 2000, base + 2600);
+    bool booking = !first.empty() && !second.empty() && third.empty() &&
+                   bookSystem.reserveSlot("V1002", "Z2", time(0) - 60, base).empty() &&
+                   !bookSystem.isWindowFree("Z2", SlotClass::STANDARD, base + 2000, base + 2600) &&
+                   bookSystem.isWindowFree("Z2", SlotClass::STANDARD, base + 3600, base + 3700);
+    
+    // Nothing opens early; at its start the first gets its booked slot
+    bool notEarly = (bookSystem.activateDueReservations(base - 1) == 0) &&
+                    !bookSystem.markAsOccupied(first);
+    bool opened = (bookSystem.activateDueReservations(base) == 1) &&
+                  (bookSystem.findSlot("Z2-B1-S1")->getVehicleId() == "V1000") &&
+                  bookSystem.markAsOccupied(first);
+    
+    // A walk-in parks in the second's booked slot before its window, so the
+    // second is allocated elsewhere when the window opens
+    bookSystem.createParkingRequest("WALK-IN", "Z2");
+    bookSystem.processNextRequest();
+    bool displaced = (bookSystem.findSlot("Z2-B1-S2")->getVehicleId() == "WALK-IN") &&
+                     (bookSystem.activateDueReservations(base + 1800) == 1) &&
+                     bookSystem.markAsOccupied(second);
+    
+    // Releasing the first frees the rest of its window for new bookings,
+    // and cancelling a reservation drops its booking
+    bookSystem.markAsReleased(first);
+    string rebooked = bookSystem.reserveSlot("V1002", "Z2", base + 2000, base + 2600);
+    bool released = !rebooked.empty() && (bookSystem.getReservationCount() == 2) &&
+                    bookSystem.cancelRequest(rebooked) && (bookSystem.getReservationCount() == 1);
+    
+    // Rolling back an opened reservation's allocation drops its booking too
+    string undone = bookSystem.reserveSlot("V1002", "Z3", base + 7200, base + 9000);
+    bool rolledBack = !undone.empty() && (bookSystem.activateDueReservations(base + 7200) == 1) &&
+                      bookSystem.rollbackLastOperation() &&
+                      (bookSystem.getReservationCount() == 1) &&
+                      bookSystem.isWindowFree("Z3", SlotClass::STANDARD, base + 7200, base + 9000);
+    
+    bool passed = booking && notEarly && opened && displaced && released && rolledBack &&
+                  bookSystem.verifyCapacityCounters();
+    
+    printTestResult("Reservation Windows", passed);
+}
+
+void TestSuite::test26_AllocationExpiry() {
+    cout << "\nTest 26: Unclaimed Allocations Expire" << endl;
+    
+    ParkingSystem expirySystem;
+    expirySystem.setAllocationHold(60);
+    time_t now = time(0);
+    
+    // Both Z2 slots are allocated; only the second driver arrives
+    string noShow = expirySystem.createParkingRequest("EXP-A", "Z2");
+    expirySystem.processNextRequest();
+    string arrived = expirySystem.createParkingRequest("EXP-B", "Z2");
+    expirySystem.processNextRequest();
+    expirySystem.markAsOccupied(arrived);
+    bool armed = (expirySystem.getExpiryTimerCount() == 1);
+    
+    // Nothing expires within the hold; after it the no-show is cancelled
+    // and its slot freed, while the parked vehicle stays
+    int available = expirySystem.getAvailableSlots();
+    bool held = (expirySystem.expireUnclaimedAllocations(now + 30) == 0) &&
+                (expirySystem.findSlot("Z2-B1-S1")->getVehicleId() == "EXP-A");
+    bool expired = (expirySystem.expireUnclaimedAllocations(now + 120) == 1) &&
+                   (expirySystem.getAvailableSlots() == available + 1) &&
+                   (expirySystem.findSlot("Z2-B1-S1")->getVehicleId() == "") &&
+                   !expirySystem.markAsOccupied(noShow) &&
+                   expirySystem.markAsReleased(arrived) &&
+                   (expirySystem.getExpiryTimerCount() == 0);
+    
+    // Rolling an allocation back clears its timer; with no hold set,
+    // allocations get none
+    expirySystem.createParkingRequest("EXP-C", "Z3");
+    expirySystem.processNextRequest();
+    bool rolledBack = (expirySystem.getExpiryTimerCount() == 1) &&
+                      expirySystem.rollbackLastOperation() &&
+                      (expirySystem.getExpiryTimerCount() == 0);
+    expirySystem.setAllocationHold(0);
+    string untimed = expirySystem.createParkingRequest("EXP-D", "Z2");
+    expirySystem.processNextRequest();
+    bool disabled = (expirySystem.getExpiryTimerCount() == 0) &&
+                    (expirySystem.expireUnclaimedAllocations(now + 86400) == 0) &&
+                    expirySystem.markAsOccupied(untimed);
+    
+    // The wheel itself: deadlines spread over three days cross several
+    // cascade levels; a third are cancelled, and none fires early or late
+    const int timerCount = 20000;
+    const time_t step = 997;
+    ParkingRequest* requests = new ParkingRequest[timerCount];
+    time_t* deadlines = new time_t[timerCount];
+    TimerWheel wheel(now);
+    unsigned int seed = 2024;
+    for (int i = 0; i < timerCount; i++) {
+        seed = seed * 1103515245 + 12345;
+        deadlines[i] = now + 1 + (seed >> 8) % (3 * 86400);
+        wheel.schedule(&requests[i], deadlines[i]);
+    }
+    for (int i = 0; i < timerCount; i += 3) {
+        wheel.cancel(&requests[i]);
+        deadlines[i] = 0;
+    }
+    
+    bool onTime = true;
+    int fired = 0;
+    time_t end = now + 3 * 86400 + 1;
+    for (time_t previous = now, t = now + step; previous < end; previous = t, t += step) {
+        if (t > end) {
+            t = end;
+        }
+        ParkingRequest* request;
+        while ((request = wheel.takeExpired(t)) != nullptr) {
+            int i = (int)(request - requests);
+            if (deadlines[i] <= previous || deadlines[i] > t) {
+                onTime = false; // Cancelled, fired twice, early or late
+            }
+            deadlines[i] = 0;
+            fired++;
+        }
+    }
+    onTime = onTime && (fired == timerCount - (timerCount + 2) / 3) && (wheel.getScheduledCount() == 0);
+    delete[] deadlines;
+    delete[] requests;
+    
+    bool passed = armed && held && expired && rolledBack && disabled && onTime &&
+                  expirySystem.verifyCapacityCounters();
+    
+    printTestResult("Unclaimed Allocations Expire", passed);
+}
+
+void TestSuite::test27_LanesGrowPastRing() {
+    cout << "\nTest 27: Zone Lanes Grow Past Their Ring" << endl;
+    
+    // A ring of 8 per lane; Z1 takes far more than that and Z2 a few
+    const int burst = 300;
+    RequestDispatcher dispatcher(8, 2);
+    dispatcher.addZone("Z1");
+    dispatcher.addZone("Z2");
+    ParkingRequest* requests[burst + 3];
+    for (int i = 0; i < burst + 3; i++) {
+        requests[i] = new ParkingRequest("LANE-" + to_string(i), nullptr, (i < burst) ? "Z1" : "Z2");
+        dispatcher.enqueue(requests[i]);
+    }
+    bool accepted = (dispatcher.getPendingCount() == burst + 3) &&
+                    (dispatcher.findLane("Z1")->getSize() == burst) &&
+                    (dispatcher.findLane("Z1")->peekAt(burst - 1) == requests[burst - 1]);
+    
+    // Served in arrival order across the ring and the spill, and the lane
+    // takes new requests on the fast path again once drained
+    bool ordered = true;
+    for (int i = 0; i < burst + 3; i++) {
+        if (dispatcher.dequeueOldest() != requests[i]) {
+            ordered = false;
+        }
+    }
+    ParkingRequest late("LANE-LATE", nullptr, "Z1");
+    dispatcher.enqueue(&late);
+    bool reused = (dispatcher.findLane("Z1")->spillCount.load() == 0) &&
+                  (dispatcher.dequeueOldest() == &late) &&
+                  (dispatcher.dequeueOldest() == nullptr);
+    for (int i = 0; i < burst + 3; i++) {
+        delete requests[i];
+    }
+    
+    bool passed = accepted && ordered && reused;
+    
+    printTestResult("Zone Lanes Grow Past Their Ring", passed);
+}
+
+void TestSuite::test28_HandoffSkipsZonesWithoutWaiters() {
+    cout << "\nTest 28: Handoff Skips Zones Without Waiters" << endl;
+    
+    // A chain of 50 one-slot zones C0 - C1 - ... - C49, each filled by
+    // its own request, then every default slot filled too
+    const int chainLength = 50;
+    ParkingSystem chainSystem;
+    string holders[chainLength];
+    for (int i = 0; i < chainLength; i++) {
+        string id = "C" + to_string(i);
+        chainSystem.addZone(id, "Chain " + id, 1);
+        chainSystem.addAreaToZone(id, "R1", 1);
+        chainSystem.addSlotToArea(id, "R1", id + "-R1-S1");
+        if (i > 0) {
+            chainSystem.addZoneAdjacency("C" + to_string(i - 1), id, 1);
+        }
+    }
+    for (int i = 0; i < chainLength; i++) {
+        holders[i] = chainSystem.createParkingRequest("CHAIN-" + to_string(i), "C" + to_string(i));
+        chainSystem.processNextRequest();
+    }
+    for (int i = 0; chainSystem.getAvailableSlots() > 0 && i < 100; i++) {
+        chainSystem.createParkingRequest("CFILL-" + to_string(i), "Z1");
+        chainSystem.processNextRequest();
+    }
+    
+    // Waiters in C3, C10 and C40; the C3 one gives up
+    string quitter = chainSystem.createParkingRequest("CWAIT-3", "C3");
+    chainSystem.processNextRequest();
+    chainSystem.createParkingRequest("CWAIT-10", "C10");
+    chainSystem.processNextRequest();
+    string far = chainSystem.createParkingRequest("CWAIT-40", "C40");
+    chainSystem.processNextRequest();
+    bool waiting = (chainSystem.getWaitlistedCount() == 3) &&
+                   chainSystem.cancelRequest(quitter) &&
+                   (chainSystem.getWaitlistedCount() == 2);
+    
+    // C20's slot frees up: C10 is ten zones away, C40 twenty, and the
+    // cancelled C3 waiter is not a candidate at all
+    chainSystem.markAsOccupied(holders[20]);
+    chainSystem.markAsReleased(holders[20]);
+    bool nearest = (chainSystem.findSlot("C20-R1-S1")->getVehicleId() == "CWAIT-10") &&
+                   (chainSystem.getWaitlistedCount() == 1);
+    
+    // The next one, two zones from C3, can only go to C40
+    chainSystem.markAsOccupied(holders[5]);
+    chainSystem.markAsReleased(holders[5]);
+    bool onlyOne = (chainSystem.findSlot("C5-R1-S1")->getVehicleId() == "CWAIT-40") &&
+                   (chainSystem.getWaitlistedCount() == 0) &&
+                   chainSystem.markAsOccupied(far);
+    
+    bool passed = waiting && nearest && onlyOne && chainSystem.verifyCapacityCounters();
+    
+    printTestResult("Handoff Skips Zones Without Waiters", passed);
+}
+
+void TestSuite::test29_FixedPolicyThroughBasePointer() {
+    cout << "\nTest 29: Fixed Policy Through a Base Pointer" << endl;
+    
+    // First-fit takes PP-A-S1, best-fit the tighter area B
+    ZoneRegistry registry;
+    Zone* packed = new Zone("PP", "Policy", 2);
+    packed->addArea("A", 3);
+    packed->addArea("B", 2);
+    for (int i = 1; i <= 3; i++) {
+        packed->findArea("A")->addSlot("PP-A-S" + to_string(i));
+    }
+    for (int i = 1; i <= 2; i++) {
+        packed->findArea("B")->addSlot("PP-B-S" + to_string(i));
+    }
+    registry.addZone(packed);
+    
+    PolicyAllocationEngine<BestFitAreaPolicy> bestFit(&registry);
+    AllocationEngine* viaBase = &bestFit;
+    Vehicle vehicle("V-FIXED", "Car", "PP");
+    ParkingRequest direct("FIX1", &vehicle, "PP");
+    ParkingRequest throughBase("FIX2", &vehicle, "PP");
+    ParkingRequest afterSwitch("FIX3", &vehicle, "PP");
+    
+    // The base pointer's runtime switch runs the same policy
+    ParkingSlot* slot = bestFit.claimSlot(&direct);
+    string directSlot = slot->getSlotId();
+    slot->setAvailability(true);
+    slot = viaBase->claimSlot(&throughBase);
+    string baseSlot = slot->getSlotId();
+    slot->setAvailability(true);
+    
+    // Switching through the base pointer is refused, so it still holds
+    bool refused = !viaBase->setPolicy(AllocationPolicy::FIRST_FIT) &&
+                   viaBase->setPolicy(AllocationPolicy::BEST_FIT_AREA) &&
+                   (viaBase->getPolicy() == AllocationPolicy::BEST_FIT_AREA);
+    slot = viaBase->claimSlot(&afterSwitch);
+    string switchedSlot = slot->getSlotId();
+    slot->setAvailability(true);
+    
+    bool passed = (directSlot == "PP-B-S1") && (baseSlot == directSlot) && refused &&
+                  (switchedSlot == directSlot) && (registry.getAvailableSlots() == 5);
+    
+    printTestResult("Fixed Policy Through a Base Pointer", passed);
+}
+
+void TestSuite::test30_ZoneWindowIndex() {
+    cout << "\nTest 30: Zone-Wide Window Search" << endl;
+    
+    // 16 slots over every class in one zone; random windows are booked and
+    // released, and every zone query is checked against each slot in turn
+    Zone zone("RZ", "Windows", 2);
+    const char* areaIds[] = {"A", "B"};
+    ParkingSlot* slots[16];
+    ReservationBook book(4);
+    for (int a = 0; a < 2; a++) {
+        zone.addArea(areaIds[a], 8);
+        ParkingArea* area = zone.findArea(areaIds[a]);
+        for (int i = 0; i < 8; i++) {
+            area->addSlot("RZ-" + string(areaIds[a]) + "-S" + to_string(i), (SlotClass)(i % SLOT_CLASS_COUNT));
+            slots[a * 8 + i] = area->getSlotAt(i);
+            book.addSlot(slots[a * 8 + i]);
+        }
+    }
+    
+    const int rounds = 20000;
+    ParkingRequest** live = new ParkingRequest*[rounds];
+    int liveCount = 0;
+    int mismatches = 0;
+    int booked = 0;
+    unsigned int seed = 99;
+    for (int round = 0; round < rounds; round++) {
+        seed = seed * 1103515245 + 12345;
+        unsigned int draw = seed >> 8;
+        if (draw % 3 == 0 && liveCount > 0) {
+            int victim = (int)(draw / 3 % liveCount);
+            mismatches += book.release(live[victim]) ? 0 : 1;
+            delete live[victim];
+            live[victim] = live[--liveCount];
+            continue;
+        }
+        
+        time_t start = draw % 2000;
+        time_t end = start + 1 + (draw >> 11) % 120;
+        SlotClass fits = (SlotClass)((draw >> 4) % SLOT_CLASS_COUNT);
+        bool anyFree = false;
+        for (int i = 0; i < 16; i++) {
+            if (slots[i]->getSlotClass() >= fits && book.isSlotFree(slots[i], start, end)) {
+                anyFree = true;
+            }
+        }
+        ParkingSlot* found = book.findFreeSlot(&zone, fits, start, end);
+        if ((found != nullptr) != anyFree ||
+            (found != nullptr && (found->getSlotClass() < fits || !book.isSlotFree(found, start, end)))) {
+            mismatches++;
+        }
+        if (found != nullptr) {
+            live[liveCount] = new ParkingRequest("RW" + to_string(round), nullptr, "RZ");
+            mismatches += (book.bookInZone(live[liveCount], &zone, fits, start, end) == found) ? 0 : 1;
+            liveCount++;
+            booked++;
+        }
+    }
+    bool counted = (book.getBookingCount() == liveCount);
+    for (int i = 0; i < liveCount; i++) {
+        delete live[i];
+    }
+    delete[] live;
+    
+    bool passed = (mismatches == 0) && counted && (booked > rounds / 4);
+    
+    printTestResult("Zone-Wide Window Search", passed);
+}
+
+void TestSuite::test31_BookedSlotsHeld() {
+    cout << "\nTest 31: Booked Slots Held From Walk-Ins" << endl;
+    
+    // Z2 has two slots, B1-S1 and B1-S2; vehicles are V1000 and V1001
+    ParkingSystem holdSystem;
+    for (int i = 0; i < 2; i++) {
+        holdSystem.addVehicle("Sedan", "Z2");
+    }
+    time_t base = time(0) + 3600;
+    ParkingSlot* first = holdSystem.findSlot("Z2-B1-S1");
+    ParkingSlot* second = holdSystem.findSlot("Z2-B1-S2");
+    
+    // Shortly before the window the booked slot is held: one walk-in takes
+    // the other slot and the next overflows rather than park in it
+    string early = holdSystem.reserveSlot("V1000", "Z2", base, base + 3600);
+    bool held = !early.empty() && (holdSystem.activateDueReservations(base - 60) == 0) &&
+                !first->getAvailability();
+    string walkIn = holdSystem.createParkingRequest("WALK-A", "Z2");
+    holdSystem.processNextRequest();
+    holdSystem.createParkingRequest("WALK-B", "Z2");
+    holdSystem.processNextRequest();
+    bool skipped = (second->getVehicleId() == "WALK-A") && first->getVehicleId().empty();
+    bool opened = (holdSystem.activateDueReservations(base) == 1) &&
+                  (first->getVehicleId() == "V1000") && holdSystem.markAsOccupied(early);
+    
+    // The next booking lands on the walk-in's slot. When the walk-in leaves
+    // during the lead, the slot goes to the booking ahead of a waiter
+    string late = holdSystem.reserveSlot("V1001", "Z2", base + 7200, base + 9000);
+    holdSystem.markAsOccupied(walkIn);
+    bool waiting = !late.empty() && (holdSystem.activateDueReservations(base + 6600) == 0);
+    for (int i = 0; holdSystem.getAvailableSlots() > 0; i++) {
+        holdSystem.createParkingRequest("FILL-" + to_string(i), "Z1");
+        holdSystem.processNextRequest();
+    }
+    holdSystem.createParkingRequest("WAITER", "Z2");
+    holdSystem.processNextRequest();
+    holdSystem.markAsReleased(walkIn);
+    bool handedToBooking = (holdSystem.getWaitlistedCount() == 1) && !second->getAvailability() &&
+                           (holdSystem.activateDueReservations(base + 7200) == 1) &&
+                           (second->getVehicleId() == "V1001");
+    
+    bool passed = held && skipped && opened && waiting && handedToBooking &&
+                  holdSystem.verifyCapacityCounters();
+    
+    printTestResult("Booked Slots Held From Walk-Ins", passed);
+}
+
+void TestSuite::test32_ClockDrivenExpiry() {
+    cout << "\nTest 32: Expiry Without Further Processing" << endl;
+    
+    ParkingSystem clockSystem;
+    clockSystem.setAllocationHold(1);
+    int available = clockSystem.getAvailableSlots();
+    string noShow = clockSystem.createParkingRequest("CLOCK-A", "Z2");
+    clockSystem.processNextRequest();
+    bool armed = (clockSystem.getExpiryTimerCount() == 1) &&
+                 (clockSystem.getAvailableSlots() == available - 1);
+    
+    // Nothing else is processed; the clock thread alone expires the
+    // allocation within a few seconds of its deadline
+    for (int i = 0; i < 50 && clockSystem.getExpiryTimerCount() > 0; i++) {
+        this_thread::sleep_for(chrono::milliseconds(100));
+    }
+    bool expired = (clockSystem.getExpiryTimerCount() == 0) &&
+                   (clockSystem.getAvailableSlots() == available) &&
+                   clockSystem.findSlot("Z2-B1-S1")->getVehicleId().empty() &&
+                   !clockSystem.markAsOccupied(noShow);
+    
+    bool passed = armed && expired && clockSystem.verifyCapacityCounters();
+    
+    printTestResult("Expiry Without Further Processing", passed);
+}
+
+void TestSuite::test33_ClockOpensReservations() {
+    cout << "\nTest 33: Reservations Open on the Clock" << endl;
+    
+    // Z2-B1-S1 is booked from two seconds out; nothing is processed
+    ParkingSystem clockSystem;
+    clockSystem.addVehicle("Sedan", "Z2");
+    time_t start = time(0) + 2;
+    string reservation = clockSystem.reserveSlot("V1000", "Z2", start, start + 3600);
+    ParkingSlot* booked = clockSystem.findSlot("Z2-B1-S1");
+    
+    // The clock thread holds the slot within its lead, then opens the
+    // window at its start
+    for (int i = 0; i < 50 && booked->getVehicleId() != "V1000"; i++) {
+        this_thread::sleep_for(chrono::milliseconds(100));
+    }
+    bool opened = !reservation.empty() && (booked->getVehicleId() == "V1000") &&
+                  (time(0) >= start) && clockSystem.markAsOccupied(reservation);
+    
+    bool passed = opened && clockSystem.verifyCapacityCounters();
+    
+    printTestResult("Reservations Open on the Clock", passed);
+}
+
+void TestSuite::test34_SlotStoreAndSymbols() {
+    cout << "\nTest 34: Slot Store and Interned IDs" << endl;
+    
+    // Handles are dense, stable, and survive the table growing past its
+    // first segment
+    SymbolTable symbols;
+    bool interned = (symbols.intern("ALPHA") == 0) && (symbols.intern("BETA") == 1) &&
+                    (symbols.intern("ALPHA") == 0) && (symbols.find("GAMMA") == SymbolTable::NONE);
+    for (int i = 0; i < 200; i++) {
+        symbols.intern("SYM-" + to_string(i));
+    }
+    interned = interned && (symbols.size() == 202) && (symbols.nameOf(1) == "BETA") &&
+               (symbols.nameOf(symbols.find("SYM-199")) == "SYM-199");
+    
+    // Blocks are 64-aligned; the first spans two words of free bits
+    SlotStore store("T34-Z");
+    int first = store.reserveBlock(70, 0);
+    int second = store.reserveBlock(3, 1);
+    for (int i = 0; i < 70; i++) {
+        store.initSlot(first + i, "T34-A-S" + to_string(i), (i % 2 == 0) ? SlotClass::LARGE : SlotClass::COMPACT);
+    }
+    for (int i = 0; i < 3; i++) {
+        store.initSlot(second + i, "T34-B-S" + to_string(i));
+    }
+    bool blocks = (first == 0) && (second == 128) && (store.getReservedSlots() == 192) &&
+                  (store.getOwnerTag(65) == 0) && (store.getOwnerTag(second) == 1) &&
+                  (SymbolTable::slots().nameOf(store.getSlotName(first + 5)) == "T34-A-S5");
+    
+    // Claims are per class and never hand out the same slot twice
+    bool claims = (store.countFree(first, first + 70) == 70) &&
+                  (store.countFree(first, first + 70, (int)SlotClass::COMPACT) == 35) &&
+                  (store.claimFirstFree(first, first + 70, (int)SlotClass::COMPACT) == 1) &&
+                  (store.claimFirstFree(first, first + 70) == 0) && !store.tryClaim(0) &&
+                  (store.countFree(first, first + 70) == 68) &&
+                  store.setFree(0, true) && !store.setFree(0, true) &&
+                  (store.claimFirstFree(second, second + 3) == second);
+    
+    bool passed = interned && blocks && claims;
+    
+    printTestResult("Slot Store and Interned IDs", passed);
+}
+
+void TestSuite::test35_ZoneRegistryGrowth() {
+    cout << "\nTest 35: Zone Registry Lookup and Growth" << endl;
+    
+    // Room for two zones at first; the defaults alone outgrow it
+    ParkingSystem registrySystem(2);
+    bool added = true;
+    for (int i = 0; i < 40; i++) {
+        added = registrySystem.addZone("G" + to_string(i), "Grown", 1) && added;
+    }
+    bool duplicate = !registrySystem.addZone("Z1", "Again", 1) && !registrySystem.addZone("G7", "Again", 1);
+    
+    bool found = (registrySystem.findZone("Z2") != nullptr) && (registrySystem.findZone("G40") == nullptr);
+    for (int i = 0; i < 40; i++) {
+        Zone* zone = registrySystem.findZone("G" + to_string(i));
+        found = found && (zone != nullptr) && (zone->getZoneId() == "G" + to_string(i));
+    }
+    
+    // The engine shares the registry, so it allocates in a zone added later
+    registrySystem.addAreaToZone("G39", "A", 1);
+    registrySystem.addSlotToArea("G39", "A", "G39-A-S1");
+    registrySystem.createParkingRequest("ZR-CAR", "G39");
+    registrySystem.processNextRequest();
+    bool shared = (registrySystem.findSlot("G39-A-S1")->getVehicleId() == "ZR-CAR");
+    
+    bool passed = added && duplicate && found && shared && (registrySystem.getTotalSlots() == 11);
+    
+    printTestResult("Zone Registry Lookup and Growth", passed);
+}
+
+void TestSuite::test36_RequestIndex() {
+    cout << "\nTest 36: Request Lookup by ID" << endl;
+    
+    // The manager owns the requests; the vehicle outlives them
+    Vehicle vehicle("IDX-CAR", "Sedan", "Z1");
+    RequestManager manager;
+    const int count = 2000;
+    bool added = true;
+    for (int i = 0; i < count; i++) {
+        added = manager.addRequest(new ParkingRequest("IDX" + to_string(i), &vehicle, "Z1")) && added;
+    }
+    
+    // A duplicate ID is refused and left with the caller
+    ParkingRequest duplicate("IDX7", &vehicle, "Z2");
+    bool refused = !manager.addRequest(&duplicate) && (manager.getRequestCount() == count) &&
+                   (manager.findRequest("IDX7")->getRequestedZoneId() == "Z1");
+    
+    bool found = (manager.findRequest("IDX" + to_string(count)) == nullptr);
+    for (int i = 0; i < count; i++) {
+        ParkingRequest* request = manager.findRequest("IDX" + to_string(i));
+        found = found && (request != nullptr) && (request->getRequestId() == "IDX" + to_string(i));
+    }
+    
+    // Removal drops the entry from the index as well as the list
+    bool removed = manager.removeRequest("IDX100") && !manager.removeRequest("IDX100") &&
+                   (manager.findRequest("IDX100") == nullptr) &&
+                   (manager.findRequest("IDX101") != nullptr) &&
+                   (manager.getRequestCount() == count - 1);
+    
+    bool passed = added && refused && found && removed;
+    
+    printTestResult("Request Lookup by ID", passed);
+}
+
+void TestSuite::test37_StateCounters() {
+    cout << "\nTest 37: Per-State Request Counters" << endl;
+    
+    // Slots come from a system of their own; the requests live in a bare manager
+    ParkingSystem slotHost;
+    Vehicle vehicle("CNT-CAR", "Sedan", "Z1");
+    RequestManager manager;
+    ParkingRequest* requests[6];
+    for (int i = 0; i < 6; i++) {
+        requests[i] = new ParkingRequest("CNT" + to_string(i), &vehicle, "Z1");
+        manager.addRequest(requests[i]);
+    }
+    
+    // One allocated, one through to released, one cancelled, three waiting
+    requests[0]->allocateSlot(slotHost.findSlot("Z1-A1-S1"));
+    requests[1]->allocateSlot(slotHost.findSlot("Z1-A1-S2"));
+    requests[1]->markAsOccupied();
+    requests[1]->markAsReleased();
+    requests[2]->cancelRequest();
+    bool counted = (manager.countByState(RequestState::REQUESTED) == 3) &&
+                   (manager.countByState(RequestState::ALLOCATED) == 1) &&
+                   (manager.countByState(RequestState::OCCUPIED) == 0) &&
+                   (manager.countByState(RequestState::RELEASED) == 1) &&
+                   (manager.countByState(RequestState::CANCELLED) == 1);
+    
+    // Each state's list holds exactly the requests its counter counts
+    bool listed = true;
+    for (int s = 0; s < REQUEST_STATE_COUNT; s++) {
+        int length = 0;
+        for (RequestNode* node = manager.getFirstInState((RequestState)s); node != nullptr; node = node->nextInState) {
+            listed = listed && (node->request->getCurrentState() == (RequestState)s);
+            length++;
+        }
+        listed = listed && (length == manager.countByState((RequestState)s));
+    }
+    
+    // Removal leaves its state's list and counter
+    bool removed = manager.removeRequest("CNT4") &&
+                   (manager.countByState(RequestState::REQUESTED) == 2) &&
+                   (manager.getFirstInState(RequestState::REQUESTED)->request == requests[3]);
+    
+    bool passed = counted && listed && removed;
+    
+    printTestResult("Per-State Request Counters", passed);
+}
+
+void TestSuite::test38_DurationPercentiles() {
+    cout << "\nTest 38: Streaming Duration Statistics" << endl;
+    
+    // 1..1000 minutes, added out of order
+    DurationStats stats;
+    for (int i = 0; i < 1000; i++) {
+        stats.add((i * 7919) % 1000 + 1);
+    }
+    double mean = stats.getMean();
+    double variance = stats.getVariance();
+    bool moments = (stats.getCount() == 1000) && (mean > 500.49) && (mean < 500.51) &&
+                   (variance > 83416.0) && (variance < 83417.5) &&
+                   (stats.getMin() == 1.0) && (stats.getMax() == 1000.0);
+    
+    // Histogram percentiles stay within the sketch's ~9% relative error
+    double p50 = stats.getPercentile(50);
+    double p90 = stats.getPercentile(90);
+    double p99 = stats.getPercentile(99);
+    bool percentiles = (p50 > 500 * 0.9) && (p50 < 500 * 1.1) &&
+                       (p90 > 900 * 0.9) && (p90 < 900 * 1.1) &&
+                       (p99 > 990 * 0.9) && (p99 <= 1000.0) &&
+                       (stats.getPercentile(0) >= 1.0) && (stats.getPercentile(100) > 1000 * 0.9);
+    
+    stats.reset();
+    bool cleared = (stats.getCount() == 0) && (stats.getPercentile(50) == 0.0);
+    
+    bool passed = moments && percentiles && cleared;
+    
+    printTestResult("Streaming Duration Statistics", passed);
+}
+
+void TestSuite::test39_BalancedVehicleIndex() {
+    cout << "\nTest 39: Vehicle Index Stays Balanced" << endl;
+    
+    // Sequential IDs, the pattern that turned the old BST into a list
+    const int count = 10000;
+    Vehicle** vehicles = new Vehicle*[count];
+    VehicleBST index;
+    bool inserted = true;
+    for (int i = 0; i < count; i++) {
+        vehicles[i] = new Vehicle("V" + to_string(100000 + i), "Sedan", "Z1");
+        inserted = index.insert(vehicles[i]) && inserted;
+    }
+    
+    // AVL bound: height < 1.45 * log2(n + 2), under 20 for 10000 vehicles
+    bool balanced = (index.getCount() == count) && (index.getHeight() < 20);
+    
+    Vehicle duplicate("V100042", "SUV", "Z2");
+    bool refused = !index.insert(&duplicate) && !index.insert(nullptr) && (index.getCount() == count);
+    
+    bool found = (index.search("V099999") == nullptr) && (index.search("V110000") == nullptr);
+    for (int i = 0; i < count; i += 97) {
+        found = found && (index.search("V" + to_string(100000 + i)) == vehicles[i]);
+    }
+    
+    // The index does not own its vehicles
+    index.clear();
+    for (int i = 0; i < count; i++) {
+        delete vehicles[i];
+    }
+    delete[] vehicles;
+    
+    bool passed = inserted && balanced && refused && found && (index.getCount() == 0);
+    
+    printTestResult("Vehicle Index Stays Balanced", passed);
+}
+
+void TestSuite::test40_RollbackRingEviction() {
+    cout << "\nTest 40: Rollback Ring Eviction" << endl;
+    
+    // Ten pushes through a four-record ring keep only the newest four
+    RollbackStack stack(4);
+    for (int i = 0; i < 10; i++) {
+        stack.push(RollbackOperation(RollbackType::ALLOCATION, "RB" + to_string(i)));
+    }
+    bool bounded = (stack.getSize() == 4) && (stack.getCapacity() == 4) &&
+                   (stack.peek() != nullptr) && (stack.peek()->requestId == "RB9");
+    
+    // Newest first, then nothing older than the evicted boundary
+    RollbackOperation operation;
+    bool ordered = true;
+    for (int i = 9; i >= 6; i--) {
+        ordered = ordered && stack.pop(operation) && (operation.requestId == "RB" + to_string(i));
+    }
+    ordered = ordered && stack.isEmpty() && !stack.pop(operation) && (stack.peek() == nullptr);
+    
+    // The ring keeps working after wrapping, and clear empties it
+    stack.push(RollbackOperation(RollbackType::CANCELLATION, "RB10"));
+    stack.push(RollbackOperation(RollbackType::STATE_CHANGE, "RB11"));
+    bool reused = (stack.getSize() == 2) && stack.pop(operation) && (operation.requestId == "RB11") &&
+                  (operation.type == RollbackType::STATE_CHANGE);
+    stack.clear();
+    reused = reused && stack.isEmpty() && (stack.getSize() == 0);
+    
+    bool passed = bounded && ordered && reused;
+    
+    printTestResult("Rollback Ring Eviction", passed);
+}
+
+void TestSuite::test41_UndoAfterHandoff() {
+    cout << "\nTest 41: Undo After the Slot Was Handed On" << endl;
+    
+    // Z2 has two slots, B1-S1 and B1-S2; the reservation's vehicle is V1000
+    ParkingSystem undoSystem;
+    undoSystem.addVehicle("Sedan", "Z2");
+    time_t base = time(0) + 3600;
+    ParkingSlot* first = undoSystem.findSlot("Z2-B1-S1");
+    ParkingSlot* second = undoSystem.findSlot("Z2-B1-S2");
+    
+    // A walk-in parks on the booked slot, so the booking's hold waits for it
+    string walkIn = undoSystem.createParkingRequest("UNDO-A", "Z2");
+    undoSystem.processNextRequest();
+    undoSystem.markAsOccupied(walkIn);
+    string reservation = undoSystem.reserveSlot("V1000", "Z2", base, base + 3600);
+    bool waiting = !reservation.empty() && (undoSystem.activateDueReservations(base - 60) == 0) &&
+                   (first->getVehicleId() == "UNDO-A") && second->getAvailability();
+    
+    // Release hands the slot to the booking; undoing the walk-in's
+    // allocation afterwards must not free it again
+    undoSystem.markAsReleased(walkIn);
+    bool handedOff = !first->getAvailability();
+    undoSystem.rollbackLastKOperations(3);
+    bool kept = !first->getAvailability() && undoSystem.verifyCapacityCounters();
+    
+    // So the next walk-ins go elsewhere and the reservation gets its slot
+    undoSystem.createParkingRequest("UNDO-B", "Z2");
+    undoSystem.processNextRequest();
+    undoSystem.createParkingRequest("UNDO-C", "Z2");
+    undoSystem.processNextRequest();
+    bool notDoubled = (second->getVehicleId() == "UNDO-B") && first->getVehicleId().empty() &&
+                      (undoSystem.activateDueReservations(base) == 1) &&
+                      (first->getVehicleId() == "V1000");
+    
+    bool passed = waiting && handedOff && kept && notDoubled && undoSystem.verifyCapacityCounters();
+    
+    printTestResult("Undo After the Slot Was Handed On", passed);
+}
+
+void TestSuite::test42_ConcurrentLifecycles() {
+    cout << "\nTest 42: Concurrent Request Lifecycles" << endl;
+    
+    // Two extra zones on top of the defaults; every thread creates,
+    // allocates, parks, releases and cancels against all of them at once
+    ParkingSystem sharedSystem;
+    const char* zoneIds[] = {"Z1", "Z2", "Z3", "M1", "M2"};
+    for (int z = 3; z < 5; z++) {
+        sharedSystem.addZone(zoneIds[z], "Shared", 1);
+        sharedSystem.addAreaToZone(zoneIds[z], "A", 4);
+        for (int i = 1; i <= 4; i++) {
+            sharedSystem.addSlotToArea(zoneIds[z], "A", string(zoneIds[z]) + "-A-S" + to_string(i));
+        }
+    }
+    
+    const int threadCount = 4;
+    const int perThread = 200;
+    thread workers[threadCount];
+    for (int t = 0; t < threadCount; t++) {
+        workers[t] = thread([&sharedSystem, &zoneIds, t, perThread]() {
+            string parked;
+            for (int i = 0; i < perThread; i++) {
+                string requestId = sharedSystem.createParkingRequest(
+                    "MT" + to_string(t) + "-" + to_string(i), zoneIds[(t + i) % 5]);
+                sharedSystem.processNextRequest();
+                switch (i % 4) {
+                    case 0:
+                        // Release the car parked four rounds ago, park this one
+                        if (!parked.empty()) {
+                            sharedSystem.markAsReleased(parked);
+                        }
+                        parked = sharedSystem.markAsOccupied(requestId) ? requestId : "";
+                        break;
+                    case 1:
+                        sharedSystem.markAsOccupied(requestId);
+                        sharedSystem.markAsReleased(requestId);
+                        break;
+                    case 2:
+                        sharedSystem.cancelRequest(requestId);
+                        break;
+                    default:
+                        break; // Left allocated, or waiting
+                }
+            }
+        });
+    }
+    for (int t = 0; t < threadCount; t++) {
+        workers[t].join();
+    }
+    
+    // Every taken slot names one vehicle, no vehicle holds two slots, and
+    // taken slots match the requests that hold one
+    const char* defaultSlots[] = {"Z1-A1-S1", "Z1-A1-S2", "Z1-A1-S3", "Z1-A2-S1", "Z1-A2-S2",
+                                  "Z2-B1-S1", "Z2-B1-S2", "Z3-C1-S1", "Z3-C1-S2", "Z3-C1-S3"};
+    string holders[18];
+    int taken = 0;
+    bool consistent = true;
+    for (int s = 0; s < 18; s++) {
+        string slotId = (s < 10) ? string(defaultSlots[s])
+                                 : string(zoneIds[3 + (s - 10) / 4]) + "-A-S" + to_string((s - 10) % 4 + 1);
+        ParkingSlot* slot = sharedSystem.findSlot(slotId);
+        if (slot->getAvailability()) {
+            consistent = consistent && slot->getVehicleId().empty();
+            continue;
+        }
+        consistent = consistent && !slot->getVehicleId().empty();
+        for (int h = 0; h < taken; h++) {
+            consistent = consistent && (holders[h] != slot->getVehicleId());
+        }
+        holders[taken++] = slot->getVehicleId();
+    }
+    
+    bool passed = consistent && (taken == sharedSystem.getActiveRequests()) &&
+                  (taken == sharedSystem.getTotalSlots() - sharedSystem.getAvailableSlots()) &&
+                  sharedSystem.verifyCapacityCounters();
+    
+    printTestResult("Concurrent Request Lifecycles", passed);
+}
+
+void TestSuite::test43_AreaFreeBitmap() {
+    cout << "\nTest 43: Area Free-Slot Bitmap Across Words" << endl;
+    
+    // 130 slots span three 64-bit words of free bits
+    ParkingArea area("BM", "T43", 130);
+    for (int i = 0; i < 130; i++) {
+        area.addSlot("T43-BM-S" + to_string(i));
+    }
+    
+    // Taking the first 66 leaves the first free bit in the second word
+    for (int i = 0; i < 66; i++) {
+        area.getSlotAt(i)->setAvailability(false);
+    }
+    bool secondWord = (area.getFirstAvailableSlot() == area.getSlotAt(66)) &&
+                      (area.countAvailableSlots() == 64);
+    
+    // Bits just either side of the word boundary
+    area.getSlotAt(63)->setAvailability(true);
+    bool lastBitOfFirst = (area.getFirstAvailableSlot() == area.getSlotAt(63)) &&
+                          (area.countAvailableSlots() == 65);
+    area.getSlotAt(63)->setAvailability(false);
+    area.getSlotAt(64)->setAvailability(true);
+    bool firstBitOfSecond = (area.getFirstAvailableSlot() == area.getSlotAt(64)) &&
+                            (area.countAvailableSlots() == 65);
+    
+    // Only slot 128, alone in the partial third word, left free
+    for (int i = 64; i < 130; i++) {
+        if (i != 128) {
+            area.getSlotAt(i)->setAvailability(false);
+        }
+    }
+    bool thirdWord = (area.getFirstAvailableSlot() == area.getSlotAt(128)) &&
+                     (area.countAvailableSlots() == 1) && (area.claimFirstAvailableSlot() == area.getSlotAt(128)) &&
+                     (area.getFirstAvailableSlot() == nullptr) && (area.countAvailableSlots() == 0);
+    
+    bool passed = secondWord && lastBitOfFirst && firstBitOfSecond && thirdWord && area.verifyCounters();
+    
+    printTestResult("Area Free-Slot Bitmap Across Words", passed);
+}
+
+void TestSuite::test44_ClassSummaryClaims() {
+    cout << "\nTest 44: Class Claims Through the Free Summary" << endl;
+    
+    // 4200 large slots with a compact one every 1000, so the compact slots
+    // sit in words far apart, one of them past the first summary word
+    Zone zone("T44", "Summary", 1);
+    zone.addArea("A", 4200);
+    ParkingArea* area = zone.findArea("A");
+    for (int i = 0; i < 4200; i++) {
+        area->addSlot("T44-A-S" + to_string(i), (i % 1000 == 0) ? SlotClass::COMPACT : SlotClass::LARGE);
+    }
+    
+    // Compact claims come in index order, then fall through to large slots
+    bool inOrder = true;
+    for (int i = 0; i < 5; i++) {
+        inOrder = inOrder && (zone.claimAvailableSlotInZone(SlotClass::COMPACT) == area->getSlotAt(i * 1000));
+    }
+    bool fellThrough = (zone.claimAvailableSlotInZone(SlotClass::COMPACT) == area->getSlotAt(1));
+    
+    // A slot freed in a word the summary had dropped is found again
+    area->getSlotAt(4000)->setAvailability(true);
+    bool refound = (zone.claimAvailableSlotInZone(SlotClass::COMPACT) == area->getSlotAt(4000));
+    
+    // Batches take the freed compact slots first, then large ones
+    area->getSlotAt(1000)->setAvailability(true);
+    area->getSlotAt(3000)->setAvailability(true);
+    ParkingSlot* batch[3];
+    bool batched = (zone.claimAvailableSlotsInZone(batch, 3, SlotClass::COMPACT) == 3) &&
+                   (batch[0] == area->getSlotAt(1000)) && (batch[1] == area->getSlotAt(3000)) &&
+                   (batch[2] == area->getSlotAt(2)) &&
+                   (zone.getAvailableSlots(SlotClass::COMPACT) == 0) &&
+                   (zone.claimAvailableSlotInZone(SlotClass::COMPACT) == area->getSlotAt(3));
+    
+    bool passed = inOrder && fellThrough && refound && batched && zone.verifyCounters();
+    
+    printTestResult("Class Claims Through the Free Summary", passed);
+}
+
+void TestSuite::test45_MinCostClassCapacity() {
+    cout << "\nTest 45: Min-Cost Class Capacity" << endl;
+    
+    // MA is full. MB (distance 1) has a motorcycle and a large slot free, MD
+    // (2) a compact one, ME (3) a large one. A compact car and a truck
+    // overflow MA: only one of them can have MB's large slot, so the car
+    // goes to MD and the truck to MB rather than pushing the truck to ME
+    ZoneRegistry registry(4);
+    const char* zoneIds[] = {"MA", "MB", "MD", "ME"};
+    Zone* zones[4];
+    for (int z = 0; z < 4; z++) {
+        zones[z] = new Zone(zoneIds[z], "Class Capacity", 1);
+        zones[z]->addArea("A", 2);
+        registry.addZone(zones[z]);
+    }
+    zones[1]->findArea("A")->addSlot("MB-A-S1", SlotClass::MOTORCYCLE);
+    zones[1]->findArea("A")->addSlot("MB-A-S2", SlotClass::LARGE);
+    zones[2]->findArea("A")->addSlot("MD-A-S1", SlotClass::COMPACT);
+    zones[3]->findArea("A")->addSlot("ME-A-S1", SlotClass::LARGE);
+    
+    AllocationEngine engine(&registry);
+    engine.addZoneAdjacency("MA", "MB", 1);
+    engine.addZoneAdjacency("MA", "MD", 2);
+    engine.addZoneAdjacency("MA", "ME", 3);
+    
+    Vehicle car("V-CAR", "Compact", "MA");
+    Vehicle truck("V-TRUCK", "Truck", "MA");
+    ParkingRequest* requests[2];
+    requests[0] = new ParkingRequest("MCC0", &car, "MA");
+    requests[1] = new ParkingRequest("MCC1", &truck, "MA");
+    ParkingSlot* slots[2];
+    bool budgetExceeded = false;
+    int claimed = engine.claimSlotsMinCost(requests, 2, slots, 0, budgetExceeded);
+    
+    bool passed = (claimed == 2) && !budgetExceeded &&
+                  (slots[0] == zones[2]->findArea("A")->getSlotAt(0)) &&
+                  (slots[1] == zones[1]->findArea("A")->getSlotAt(1)) &&
+                  (zones[3]->getAvailableSlots() == 1) &&
+                  (zones[1]->getAvailableSlots(SlotClass::MOTORCYCLE) == 1) &&
+                  zones[1]->verifyCounters() && zones[2]->verifyCounters();
+    
+    for (int i = 0; i < 2; i++) {
+        delete requests[i];
+    }
+    
+    printTestResult("Min-Cost Class Capacity", passed);
 }
\ No newline at end of file
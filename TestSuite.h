@@ -27,6 +27,41 @@ private:
     void test8_BSTOperations();
     void test9_InvalidTransitions();
     void test10_AnalyticsAfterRollback();
+    void test11_CapacityCounters();
+    void test12_RollbackCustomTopology();
+    void test13_QueueBeyondOldLimit();
+    void test14_ConcurrentQueueIntegrity();
+    void test15_ZoneWorkersPreserveOrder();
+    void test16_ConcurrentClaimsNeverDoubleBook();
+    void test17_PrioritySchedulingWithAging();
+    void test18_WaitlistHandoffOnRelease();
+    void test19_NearestZoneFallback();
+    void test20_CapacityTreeFindsFreeZones();
+    void test21_BatchAllocationByZone();
+    void test22_MinCostBatchAssignment();
+    void test23_AllocationPolicies();
+    void test24_SlotClassPools();
+    void test25_ReservationWindows();
+    void test26_AllocationExpiry();
+    void test27_LanesGrowPastRing();
+    void test28_HandoffSkipsZonesWithoutWaiters();
+    void test29_FixedPolicyThroughBasePointer();
+    void test30_ZoneWindowIndex();
+    void test31_BookedSlotsHeld();
+    void test32_ClockDrivenExpiry();
+    void test33_ClockOpensReservations();
+    void test34_SlotStoreAndSymbols();
+    void test35_ZoneRegistryGrowth();
+    void test36_RequestIndex();
+    void test37_StateCounters();
+    void test38_DurationPercentiles();
+    void test39_BalancedVehicleIndex();
+    void test40_RollbackRingEviction();
+    void test41_UndoAfterHandoff();
+    void test42_ConcurrentLifecycles();
+    void test43_AreaFreeBitmap();
+    void test44_ClassSummaryClaims();
+    void test45_MinCostClassCapacity();
     
     // Helper
     void printTestResult(const string& testName, bool passed);
@@ -0,0 +1,213 @@
+#include "TimerWheel.h"
+using namespace std;
+
+TimerWheel::TimerWheel(time_t now, int initialCapacity)
+    : usedCount(0), freeHead(-1), dueCount(0), currentTick(now),
+      scheduledCount(0), processedUpTo(now) {
+    nodeCapacity = (initialCapacity > 0) ? initialCapacity : 1024;
+    nodes = new TimerNode[nodeCapacity];
+    for (int i = 0; i <= DUE_LIST; i++) {
+        buckets[i] = -1;
+    }
+    for (int level = 0; level < LEVELS; level++) {
+        levelCounts[level] = 0;
+    }
+}
+
+TimerWheel::~TimerWheel() {
+    // Requests are owned by the RequestManager
+    delete[] nodes;
+}
+
+void TimerWheel::schedule(ParkingRequest* request, time_t deadline) {
+    lock_guard<mutex> guard(wheelLock);
+    int node = request->getExpiryTimer();
+    if (node != -1) {
+        unlink(node);
+    } else {
+        node = allocateNode();
+        nodes[node].request = request;
+        request->setExpiryTimer(node);
+        scheduledCount++;
+    }
+    nodes[node].deadline = deadline;
+    place(node);
+}
+
+bool TimerWheel::cancel(ParkingRequest* request) {
+    lock_guard<mutex> guard(wheelLock);
+    int node = request->getExpiryTimer();
+    if (node == -1) {
+        return false;
+    }
+    unlink(node);
+    freeNode(node);
+    return true;
+}
+
+bool TimerWheel::hasDue(time_t now) const {
+    return dueCount.load(memory_order_acquire) > 0 ||
+           (scheduledCount.load(memory_order_acquire) > 0 && now > processedUpTo.load(memory_order_acquire));
+}
+
+ParkingRequest* TimerWheel::takeExpired(time_t now) {
+    lock_guard<mutex> guard(wheelLock);
+    if (now > currentTick) {
+        advance(now);
+    }
+    
+    int node = buckets[DUE_LIST];
+    if (node == -1) {
+        return nullptr;
+    }
+    ParkingRequest* request = nodes[node].request;
+    unlink(node);
+    freeNode(node);
+    return request;
+}
+
+int TimerWheel::getScheduledCount() const {
+    return scheduledCount.load(memory_order_acquire);
+}
+
+time_t TimerWheel::getCurrentTick() const {
+    return processedUpTo.load(memory_order_acquire);
+}
+
+// ==================== Buckets ====================
+int TimerWheel::allocateNode() {
+    if (freeHead != -1) {
+        int node = freeHead;
+        freeHead = nodes[node].next;
+        return node;
+    }
+    if (usedCount == nodeCapacity) {
+        // Indices stay valid across growth; only the array moves
+        int newCapacity = nodeCapacity * 2;
+        TimerNode* newNodes = new TimerNode[newCapacity];
+        for (int i = 0; i < usedCount; i++) {
+            newNodes[i] = nodes[i];
+        }
+        delete[] nodes;
+        nodes = newNodes;
+        nodeCapacity = newCapacity;
+    }
+    return usedCount++;
+}
+
+void TimerWheel::freeNode(int node) {
+    nodes[node].request->setExpiryTimer(-1);
+    nodes[node].request = nullptr;
+    nodes[node].next = freeHead;
+    freeHead = node;
+    scheduledCount--;
+}
+
+void TimerWheel::place(int node) {
+    if (nodes[node].deadline <= currentTick) {
+        link(node, DUE_LIST);
+        return;
+    }
+    
+    // Levels are chosen by distance from the first second not yet
+    // processed, so a cascaded timer always lands on a lower level
+    time_t next = currentTick + 1;
+    time_t target = nodes[node].deadline;
+    time_t span = (time_t)1 << (LEVELS * LEVEL_BITS);
+    if (target - next >= span) {
+        target = next + span - 1; // Re-placed from its real deadline when cascaded
+    }
+    
+    int level = 0;
+    while (level < LEVELS - 1 && target - next >= ((time_t)1 << ((level + 1) * LEVEL_BITS))) {
+        level++;
+    }
+    int slot = (int)((target >> (level * LEVEL_BITS)) & (SLOTS - 1));
+    link(node, level * SLOTS + slot);
+}
+
+void TimerWheel::link(int node, int bucket) {
+    nodes[node].bucket = bucket;
+    nodes[node].prev = -1;
+    nodes[node].next = buckets[bucket];
+    if (buckets[bucket] != -1) {
+        nodes[buckets[bucket]].prev = node;
+    }
+    buckets[bucket] = node;
+    
+    if (bucket == DUE_LIST) {
+        dueCount++;
+    } else {
+        levelCounts[bucket / SLOTS]++;
+    }
+}
+
+void TimerWheel::unlink(int node) {
+    int bucket = nodes[node].bucket;
+    if (nodes[node].prev != -1) {
+        nodes[nodes[node].prev].next = nodes[node].next;
+    } else {
+        buckets[bucket] = nodes[node].next;
+    }
+    if (nodes[node].next != -1) {
+        nodes[nodes[node].next].prev = nodes[node].prev;
+    }
+    
+    if (bucket == DUE_LIST) {
+        dueCount--;
+    } else {
+        levelCounts[bucket / SLOTS]--;
+    }
+}
+
+void TimerWheel::cascade(int level, int slot) {
+    int bucket = level * SLOTS + slot;
+    while (buckets[bucket] != -1) {
+        int node = buckets[bucket];
+        unlink(node);
+        place(node);
+    }
+}
+
+void TimerWheel::advance(time_t now) {
+    while (currentTick < now) {
+        // With the lowest levels empty, nothing happens until the next
+        // second the first non-empty level cascades, so jump there
+        int empty = 0;
+        while (empty < LEVELS && levelCounts[empty] == 0) {
+            empty++;
+        }
+        if (empty == LEVELS) {
+            currentTick = now;
+            break;
+        }
+        if (empty > 0) {
+            time_t span = (time_t)1 << (empty * LEVEL_BITS);
+            time_t next = currentTick + 1;
+            time_t aligned = (next + span - 1) & ~(span - 1);
+            if (aligned > next) {
+                currentTick = (aligned - 1 < now) ? aligned - 1 : now;
+                continue;
+            }
+        }
+        
+        // Each level cascades when the one below it wraps, before the
+        // second's own bucket fires
+        time_t tick = currentTick + 1;
+        for (int level = 1; level < LEVELS; level++) {
+            if ((tick & (((time_t)1 << (level * LEVEL_BITS)) - 1)) != 0) {
+                break;
+            }
+            cascade(level, (int)((tick >> (level * LEVEL_BITS)) & (SLOTS - 1)));
+        }
+        
+        int bucket = (int)(tick & (SLOTS - 1));
+        while (buckets[bucket] != -1) {
+            int node = buckets[bucket];
+            unlink(node);
+            link(node, DUE_LIST);
+        }
+        currentTick = tick;
+    }
+    processedUpTo.store(currentTick, memory_order_release);
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include "ParkingRequest.h"
+#include <mutex>
+#include <atomic>
+#include <ctime>
+using namespace std;
+
+// Deadlines for requests, one timer per request, at one-second resolution.
+// A hierarchical timing wheel: LEVELS wheels of SLOTS buckets, where a
+// bucket on level L spans SLOTS^L seconds. A timer goes into the bucket of
+// the lowest level that still reaches its deadline and moves down a level
+// each time the wheel below wraps, so it is touched at most LEVELS times.
+// Buckets are intrusive doubly linked lists of pooled nodes; each request
+// keeps its node index, so scheduling and cancelling are O(1) with no
+// search, however many timers are outstanding.
+class TimerWheel {
+private:
+    static const int LEVEL_BITS = 6;
+    static const int SLOTS = 1 << LEVEL_BITS;  // 64 buckets per level
+    static const int LEVELS = 5;               // 2^30 s (34 years); later deadlines wait at the top
+    static const int DUE_LIST = LEVELS * SLOTS; // Expired, not yet taken
+    
+    struct TimerNode {
+        ParkingRequest* request;
+        time_t deadline;
+        int prev;
+        int next;   // Also links the free list
+        int bucket;
+    };
+    
+    TimerNode* nodes;
+    int nodeCapacity;
+    int usedCount;       // High-water mark of nodes
+    int freeHead;        // Released nodes, linked through next
+    int buckets[DUE_LIST + 1]; // Head node per bucket, -1 if empty
+    int levelCounts[LEVELS];
+    atomic<int> dueCount;
+    time_t currentTick;  // Last second processed
+    
+    atomic<int> scheduledCount;     // Includes the due list
+    atomic<time_t> processedUpTo;   // currentTick, for a lock-free due check
+    mutable mutex wheelLock;        // Leaf lock, held only inside these methods
+    
+public:
+    TimerWheel(time_t now, int initialCapacity = 1024);
+    ~TimerWheel();
+    
+    // One timer per request; scheduling again moves it. A deadline the
+    // wheel has already passed is due at once.
+    void schedule(ParkingRequest* request, time_t deadline);
+    bool cancel(ParkingRequest* request); // False if none was scheduled
+    
+    // Expired timers, in no particular order within one second. takeExpired
+    // first advances the wheel to now; it never moves backwards.
+    bool hasDue(time_t now) const; // Lock-free
+    ParkingRequest* takeExpired(time_t now);
+    
+    // Accessors
+    int getScheduledCount() const;
+    time_t getCurrentTick() const;
+    
+private:
+    int allocateNode();
+    void place(int node);              // Into the bucket for its deadline, or the due list
+    void link(int node, int bucket);
+    void unlink(int node);
+    void freeNode(int node);
+    void cascade(int level, int slot); // Re-place a bucket's timers a level or more down
+    void advance(time_t now);
+    
+    // Non-copyable: owns its node pool
+    TimerWheel(const TimerWheel&);
+    TimerWheel& operator=(const TimerWheel&);
+};
+
+#endif
\ No newline at end of file
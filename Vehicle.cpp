@@ -2,10 +2,11 @@
 #include <iostream>
 using namespace std;
 
-Vehicle::Vehicle() : vehicleId(""), vehicleType(""), preferredZone("") {}
+Vehicle::Vehicle() : vehicleId(""), vehicleType(""), preferredZone(""), slotClass(SlotClass::STANDARD) {}
 
 Vehicle::Vehicle(const string& vehicleId, const string& vehicleType, const string& preferredZone)
-    : vehicleId(vehicleId), vehicleType(vehicleType), preferredZone(preferredZone) {}
+    : vehicleId(vehicleId), vehicleType(vehicleType), preferredZone(preferredZone),
+      slotClass(slotClassForVehicle(vehicleType)) {}
 
 string Vehicle::getVehicleId() const {
     return vehicleId;
@@ -19,6 +20,10 @@ string Vehicle::getPreferredZone() const {
     return preferredZone;
 }
 
+SlotClass Vehicle::getSlotClass() const {
+    return slotClass;
+}
+
 void Vehicle::setPreferredZone(const string& zone) {
     preferredZone = zone;
 }
@@ -26,5 +31,6 @@ void Vehicle::setPreferredZone(const string& zone) {
 void Vehicle::displayVehicleInfo() const {
     cout << "Vehicle ID: " << vehicleId 
          << ", Type: " << vehicleType 
+         << ", Slot Class: " << slotClassName(slotClass)
          << ", Preferred Zone: " << preferredZone << endl;
 }
\ No newline at end of file
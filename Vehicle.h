@@ -2,6 +2,7 @@
 #define VEHICLE_H
 
 #include <string>
+#include "SlotClass.h"
 using namespace std;
 
 class Vehicle {
@@ -9,6 +10,7 @@ private:
     string vehicleId;
     string vehicleType;
     string preferredZone;
+    SlotClass slotClass; // Smallest slot class the vehicle fits, from its type
     
 public:
     Vehicle();
@@ -18,6 +20,7 @@ public:
     string getVehicleId() const;
     string getVehicleType() const;
     string getPreferredZone() const;
+    SlotClass getSlotClass() const;
     
     // Setters
     void setPreferredZone(const string& zone);
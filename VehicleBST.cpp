@@ -8,27 +8,53 @@ VehicleBST::~VehicleBST() {
     clear();
 }
 
-void VehicleBST::clearRec(BSTNode* node) {
-    if (node == nullptr) return;
-    
-    clearRec(node->left);
-    clearRec(node->right);
-    // Note: Vehicle objects are managed elsewhere
-    delete node;
+int VehicleBST::heightOf(BSTNode* node) {
+    return (node != nullptr) ? node->height : 0;
+}
+
+void VehicleBST::updateHeight(BSTNode* node) {
+    int leftHeight = heightOf(node->left);
+    int rightHeight = heightOf(node->right);
+    node->height = 1 + (leftHeight > rightHeight ? leftHeight : rightHeight);
+}
+
+VehicleBST::BSTNode* VehicleBST::rotateLeft(BSTNode* node) {
+    BSTNode* pivot = node->right;
+    node->right = pivot->left;
+    pivot->left = node;
+    updateHeight(node);
+    updateHeight(pivot);
+    return pivot;
+}
+
+VehicleBST::BSTNode* VehicleBST::rotateRight(BSTNode* node) {
+    BSTNode* pivot = node->left;
+    node->left = pivot->right;
+    pivot->right = node;
+    updateHeight(node);
+    updateHeight(pivot);
+    return pivot;
 }
 
-VehicleBST::BSTNode* VehicleBST::insertRec(BSTNode* node, Vehicle* vehicle) {
-    if (node == nullptr) {
-        nodeCount++;
-        return new BSTNode(vehicle);
+VehicleBST::BSTNode* VehicleBST::rebalance(BSTNode* node) {
+    updateHeight(node);
+    int balance = heightOf(node->left) - heightOf(node->right);
+    
+    if (balance > 1) {
+        // Left-heavy; left-right case needs a first rotation
+        if (heightOf(node->left->left) < heightOf(node->left->right)) {
+            node->left = rotateLeft(node->left);
+        }
+        return rotateRight(node);
     }
     
-    if (vehicle->getVehicleId() < node->vehicle->getVehicleId()) {
-        node->left = insertRec(node->left, vehicle);
-    } else if (vehicle->getVehicleId() > node->vehicle->getVehicleId()) {
-        node->right = insertRec(node->right, vehicle);
+    if (balance < -1) {
+        // Right-heavy; right-left case needs a first rotation
+        if (heightOf(node->right->right) < heightOf(node->right->left)) {
+            node->right = rotateRight(node->right);
+        }
+        return rotateLeft(node);
     }
-    // If equal, do nothing (vehicle IDs should be unique)
     
     return node;
 }
@@ -38,34 +64,64 @@ bool VehicleBST::insert(Vehicle* vehicle) {
         return false;
     }
     
-    root = insertRec(root, vehicle);
-    return true;
-}
-
-Vehicle* VehicleBST::searchRec(BSTNode* node, const string& vehicleId) const {
-    if (node == nullptr) {
-        return nullptr;
+    const string& vehicleId = vehicle->getVehicleId();
+    
+    // Walk down, remembering the path for the rebalancing pass
+    BSTNode* path[MAX_DEPTH];
+    int depth = 0;
+    BSTNode* current = root;
+    
+    while (current != nullptr) {
+        path[depth++] = current;
+        const string& currentId = current->vehicle->getVehicleId();
+        if (vehicleId < currentId) {
+            current = current->left;
+        } else if (vehicleId > currentId) {
+            current = current->right;
+        } else {
+            return false; // Vehicle IDs must be unique
+        }
     }
     
-    if (vehicleId == node->vehicle->getVehicleId()) {
-        return node->vehicle;
-    } else if (vehicleId < node->vehicle->getVehicleId()) {
-        return searchRec(node->left, vehicleId);
-    } else {
-        return searchRec(node->right, vehicleId);
+    BSTNode* child = new BSTNode(vehicle);
+    nodeCount++;
+    
+    // Walk back up, reattaching each rebalanced subtree to its parent
+    for (int i = depth - 1; i >= 0; i--) {
+        BSTNode* parent = path[i];
+        if (vehicleId < parent->vehicle->getVehicleId()) {
+            parent->left = child;
+        } else {
+            parent->right = child;
+        }
+        
+        int oldHeight = parent->height;
+        child = rebalance(parent);
+        
+        // Once a subtree's height is unchanged the ancestors are unaffected
+        if (child == parent && child->height == oldHeight) {
+            return true;
+        }
     }
+    
+    root = child;
+    return true;
 }
 
 Vehicle* VehicleBST::search(const string& vehicleId) const {
-    return searchRec(root, vehicleId);
-}
-
-void VehicleBST::inorderRec(BSTNode* node) const {
-    if (node == nullptr) return;
+    BSTNode* current = root;
     
-    inorderRec(node->left);
-    node->vehicle->displayVehicleInfo();
-    inorderRec(node->right);
+    while (current != nullptr) {
+        const string& currentId = current->vehicle->getVehicleId();
+        if (vehicleId == currentId) {
+            return current->vehicle;
+        } else if (vehicleId < currentId) {
+            current = current->left;
+        } else {
+            current = current->right;
+        }
+    }
+    return nullptr;
 }
 
 void VehicleBST::displayInorder() const {
@@ -77,15 +133,45 @@ void VehicleBST::displayInorder() const {
         return;
     }
     
-    inorderRec(root);
+    // Explicit stack bounded by the tree height
+    BSTNode* stack[MAX_DEPTH];
+    int top = 0;
+    BSTNode* current = root;
+    
+    while (current != nullptr || top > 0) {
+        while (current != nullptr) {
+            stack[top++] = current;
+            current = current->left;
+        }
+        current = stack[--top];
+        current->vehicle->displayVehicleInfo();
+        current = current->right;
+    }
 }
 
 void VehicleBST::clear() {
-    clearRec(root);
-    root = nullptr;
+    // Rotate left children up until the root has none, then delete it.
+    // Linear time, constant extra space.
+    while (root != nullptr) {
+        if (root->left != nullptr) {
+            BSTNode* pivot = root->left;
+            root->left = pivot->right;
+            pivot->right = root;
+            root = pivot;
+        } else {
+            BSTNode* next = root->right;
+            // Note: Vehicle objects are managed elsewhere
+            delete root;
+            root = next;
+        }
+    }
     nodeCount = 0;
 }
 
 int VehicleBST::getCount() const {
     return nodeCount;
+}
+
+int VehicleBST::getHeight() const {
+    return heightOf(root);
 }
\ No newline at end of file
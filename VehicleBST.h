@@ -5,35 +5,44 @@
 #include <string>
 using namespace std;
 
+// Ordered vehicle index keyed by vehicle ID.
+// Kept height-balanced (AVL) so sequential IDs such as V1000, V1001, ...
+// don't degrade it into a list; all operations are iterative.
 class VehicleBST {
 private:
     struct BSTNode {
         Vehicle* vehicle;
         BSTNode* left;
         BSTNode* right;
+        int height;
         
-        BSTNode(Vehicle* v) : vehicle(v), left(nullptr), right(nullptr) {}
+        BSTNode(Vehicle* v) : vehicle(v), left(nullptr), right(nullptr), height(1) {}
     };
     
+    // AVL height is below 1.45 * log2(n + 2), so 96 levels covers any count
+    static const int MAX_DEPTH = 96;
+    
     BSTNode* root;
     int nodeCount;
     
     // Helper methods
-    BSTNode* insertRec(BSTNode* node, Vehicle* vehicle);
-    Vehicle* searchRec(BSTNode* node, const string& vehicleId) const;
-    void inorderRec(BSTNode* node) const;
-    void clearRec(BSTNode* node);
+    static int heightOf(BSTNode* node);
+    static void updateHeight(BSTNode* node);
+    static BSTNode* rotateLeft(BSTNode* node);
+    static BSTNode* rotateRight(BSTNode* node);
+    static BSTNode* rebalance(BSTNode* node);
     
 public:
     VehicleBST();
     ~VehicleBST();
     
     // BST operations
-    bool insert(Vehicle* vehicle);
+    bool insert(Vehicle* vehicle); // Returns false for null or duplicate IDs
     Vehicle* search(const string& vehicleId) const;
     void displayInorder() const;
     void clear();
     int getCount() const;
+    int getHeight() const;
 };
 
 #endif
\ No newline at end of file
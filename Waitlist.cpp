@@ -0,0 +1,222 @@
+#include "Waitlist.h"
+#include <iostream>
+using namespace std;
+
+// ==================== WaitQueue Implementation ====================
+Waitlist::WaitQueue::WaitQueue() : head(nullptr), tail(nullptr), size(0) {}
+
+// ==================== ZoneWaiters Implementation ====================
+Waitlist::ZoneWaiters::ZoneWaiters(const string& zoneId, int index)
+    : zoneId(zoneId), index(index) {}
+
+// ==================== Waitlist Implementation ====================
+Waitlist::Waitlist(int initialZones) : zoneCount(0), waitingCount(0), nextSequence(0) {
+    maxZones = (initialZones > 0) ? initialZones : 16;
+    zones = new ZoneWaiters*[maxZones];
+}
+
+Waitlist::~Waitlist() {
+    // Requests are owned by the RequestManager
+    for (int i = 0; i < zoneCount; i++) {
+        delete zones[i];
+    }
+    delete[] zones;
+}
+
+bool Waitlist::addZone(const string& zoneId) {
+    lock_guard<mutex> guard(waitLock);
+    if (zoneIndex.find(zoneId) != nullptr) {
+        return false;
+    }
+    
+    if (zoneCount == maxZones) {
+        maxZones *= 2;
+        ZoneWaiters** newZones = new ZoneWaiters*[maxZones];
+        for (int i = 0; i < zoneCount; i++) {
+            newZones[i] = zones[i];
+        }
+        delete[] zones;
+        zones = newZones;
+    }
+    
+    zones[zoneCount] = new ZoneWaiters(zoneId, zoneCount);
+    zoneIndex.insert(zoneId, zoneCount);
+    for (int c = 0; c < SLOT_CLASS_COUNT; c++) {
+        fitting[c].append(0);
+    }
+    zoneCount++;
+    return true;
+}
+
+Waitlist::ZoneWaiters* Waitlist::findZone(const string& zoneId) const {
+    const int* index = zoneIndex.find(zoneId);
+    return (index != nullptr) ? zones[*index] : nullptr;
+}
+
+void Waitlist::pushBack(WaitQueue& queue, ParkingRequest* request) {
+    request->setWaitLinks(queue.tail, nullptr);
+    if (queue.tail != nullptr) {
+        queue.tail->setWaitLinks(queue.tail->getWaitPrev(), request);
+    } else {
+        queue.head = request;
+    }
+    queue.tail = request;
+    queue.size++;
+}
+
+void Waitlist::pushFront(WaitQueue& queue, ParkingRequest* request) {
+    request->setWaitLinks(nullptr, queue.head);
+    if (queue.head != nullptr) {
+        queue.head->setWaitLinks(request, queue.head->getWaitNext());
+    } else {
+        queue.tail = request;
+    }
+    queue.head = request;
+    queue.size++;
+}
+
+void Waitlist::unlink(WaitQueue& queue, ParkingRequest* request) {
+    ParkingRequest* prev = request->getWaitPrev();
+    ParkingRequest* next = request->getWaitNext();
+    if (prev != nullptr) {
+        prev->setWaitLinks(prev->getWaitPrev(), next);
+    } else {
+        queue.head = next;
+    }
+    if (next != nullptr) {
+        next->setWaitLinks(prev, next->getWaitNext());
+    } else {
+        queue.tail = prev;
+    }
+    request->setWaitLinks(nullptr, nullptr);
+    queue.size--;
+}
+
+void Waitlist::countWaiter(ZoneWaiters* waiters, SlotClass slotClass, int delta) {
+    // A waiter fits its own class and every larger one
+    for (int c = (int)slotClass; c < SLOT_CLASS_COUNT; c++) {
+        fitting[c].add(waiters->index, delta);
+    }
+    waitingCount += delta;
+}
+
+bool Waitlist::add(ParkingRequest* request) {
+    lock_guard<mutex> guard(waitLock);
+    ZoneWaiters* waiters = findZone(request->getRequestedZoneId());
+    if (waiters == nullptr || request->isWaitlisted()) {
+        return false;
+    }
+    
+    pushBack(waiters->queues[(int)request->getSlotClass()], request);
+    countWaiter(waiters, request->getSlotClass(), 1);
+    request->setWaitSequence(nextSequence++);
+    request->setWaitlisted(true);
+    return true;
+}
+
+ParkingRequest* Waitlist::takeOldest(const string& zoneId, SlotClass fitsIn) {
+    lock_guard<mutex> guard(waitLock);
+    ZoneWaiters* waiters = findZone(zoneId);
+    if (waiters == nullptr) {
+        return nullptr;
+    }
+    
+    // Oldest head among the classes that fit; each queue is FIFO already
+    WaitQueue* oldest = nullptr;
+    for (int c = 0; c <= (int)fitsIn; c++) {
+        ParkingRequest* head = waiters->queues[c].head;
+        if (head != nullptr && (oldest == nullptr || head->getWaitSequence() < oldest->head->getWaitSequence())) {
+            oldest = &waiters->queues[c];
+        }
+    }
+    if (oldest == nullptr) {
+        return nullptr;
+    }
+    
+    ParkingRequest* request = oldest->head;
+    unlink(*oldest, request);
+    countWaiter(waiters, request->getSlotClass(), -1);
+    request->setWaitlisted(false);
+    return request;
+}
+
+bool Waitlist::putBack(ParkingRequest* request) {
+    lock_guard<mutex> guard(waitLock);
+    ZoneWaiters* waiters = findZone(request->getRequestedZoneId());
+    if (waiters == nullptr || request->isWaitlisted()) {
+        return false;
+    }
+    
+    // Keeps its arrival stamp, so it is again the oldest of its class
+    pushFront(waiters->queues[(int)request->getSlotClass()], request);
+    countWaiter(waiters, request->getSlotClass(), 1);
+    request->setWaitlisted(true);
+    return true;
+}
+
+bool Waitlist::remove(ParkingRequest* request) {
+    lock_guard<mutex> guard(waitLock);
+    ZoneWaiters* waiters = findZone(request->getRequestedZoneId());
+    if (waiters == nullptr || !request->isWaitlisted()) {
+        return false;
+    }
+    
+    unlink(waiters->queues[(int)request->getSlotClass()], request);
+    countWaiter(waiters, request->getSlotClass(), -1);
+    request->setWaitlisted(false);
+    return true;
+}
+
+int Waitlist::findZoneWithWaiters(int fromIndex, SlotClass fitsIn) const {
+    lock_guard<mutex> guard(waitLock);
+    if (zoneCount == 0 || fromIndex < 0) {
+        return -1;
+    }
+    return fitting[(int)fitsIn].findFirstWithCapacity(fromIndex % zoneCount);
+}
+
+int Waitlist::getWaitingCount(const string& zoneId) const {
+    lock_guard<mutex> guard(waitLock);
+    ZoneWaiters* waiters = findZone(zoneId);
+    if (waiters == nullptr) {
+        return 0;
+    }
+    
+    int count = 0;
+    for (int c = 0; c < SLOT_CLASS_COUNT; c++) {
+        count += waiters->queues[c].size;
+    }
+    return count;
+}
+
+int Waitlist::getTotalWaiting() const {
+    lock_guard<mutex> guard(waitLock);
+    return waitingCount;
+}
+
+void Waitlist::displayWaitlists() const {
+    lock_guard<mutex> guard(waitLock);
+    cout << "\n=== WAITLISTS (no free slot yet) ===" << endl;
+    cout << "Waiting: " << waitingCount << endl;
+    
+    for (int i = 0; i < zoneCount; i++) {
+        int size = 0;
+        for (int c = 0; c < SLOT_CLASS_COUNT; c++) {
+            size += zones[i]->queues[c].size;
+        }
+        if (size == 0) {
+            continue;
+        }
+        
+        cout << "Zone " << zones[i]->zoneId << ": " << size << " waiting (";
+        bool first = true;
+        for (int c = 0; c < SLOT_CLASS_COUNT; c++) {
+            int classSize = zones[i]->queues[c].size;
+            if (classSize > 0) {
+                cout << (first ? "" : ", ") << classSize << " " << slotClassName((SlotClass)c);
+                first = false;
+            }
+        }
+        cout << ")" << endl;
+    }
+}
\ No newline at end of file
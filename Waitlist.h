@@ -0,0 +1,84 @@
+#ifndef WAITLIST_H
+#define WAITLIST_H
+
+#include "ParkingRequest.h"
+#include "HashIndex.h"
+#include "CapacityTree.h"
+#include <string>
+#include <mutex>
+using namespace std;
+
+// Per-zone FIFO of admitted requests that found no free slot.
+// A waiting request stays REQUESTED; when a slot in its zone frees up, the
+// owner takes the oldest waiter that fits it and hands the slot straight to
+// it. Each zone keeps one queue per slot class, so a freed small slot skips
+// a waiting truck without searching past it; arrival order across the
+// queues comes from a stamp taken when the request joins. The queues are
+// intrusive lists threaded through the requests, so a request cancelled
+// while waiting is unlinked in O(1). Zones are indexed in the order they
+// are added (the ZoneRegistry's order), and a Fenwick tree per slot class
+// counts the waiters by zone, so the zones that could take a freed slot are
+// found without visiting the others.
+class Waitlist {
+private:
+    struct WaitQueue {
+        ParkingRequest* head;
+        ParkingRequest* tail;
+        int size;
+        
+        WaitQueue();
+    };
+    
+    struct ZoneWaiters {
+        string zoneId;
+        int index;
+        WaitQueue queues[SLOT_CLASS_COUNT]; // By the vehicle's slot class
+        
+        ZoneWaiters(const string& zoneId, int index);
+    };
+    
+    ZoneWaiters** zones;
+    int zoneCount;
+    int maxZones;
+    HashIndex<int> zoneIndex; // zoneId -> position in zones
+    CapacityTree fitting[SLOT_CLASS_COUNT]; // Per zone, waiters that fit a slot of that class
+    int waitingCount;
+    unsigned long long nextSequence; // Arrival stamp for the next waiter
+    mutable mutex waitLock;   // Leaf lock, held only inside these methods
+    
+public:
+    Waitlist(int initialZones = 16);
+    ~Waitlist();
+    
+    bool addZone(const string& zoneId);
+    
+    // Queue operations, O(1)
+    bool add(ParkingRequest* request);        // False if the zone is unknown or already waiting
+    ParkingRequest* takeOldest(const string& zoneId, SlotClass fitsIn = SlotClass::LARGE); // Fits a slot of fitsIn
+    bool putBack(ParkingRequest* request);    // Return a taken request to the front
+    bool remove(ParkingRequest* request);     // Unlink a cancelled waiter; false if not waiting
+    
+    // Zone index at or after fromIndex, wrapping, with a waiter that fits a
+    // slot of fitsIn; -1 if none. O(log zones).
+    int findZoneWithWaiters(int fromIndex, SlotClass fitsIn) const;
+    
+    // Accessors
+    int getWaitingCount(const string& zoneId) const;
+    int getTotalWaiting() const;
+    
+    // Utility
+    void displayWaitlists() const;
+    
+private:
+    ZoneWaiters* findZone(const string& zoneId) const;
+    void pushBack(WaitQueue& queue, ParkingRequest* request);
+    void pushFront(WaitQueue& queue, ParkingRequest* request);
+    void unlink(WaitQueue& queue, ParkingRequest* request);
+    void countWaiter(ZoneWaiters* waiters, SlotClass slotClass, int delta);
+    
+    // Non-copyable: owns its zone lists
+    Waitlist(const Waitlist&);
+    Waitlist& operator=(const Waitlist&);
+};
+
+#endif
\ No newline at end of file
@@ -2,10 +2,26 @@
 #include <iostream>
 using namespace std;
 
-Zone::Zone() : maxAreas(0), currentAreas(0), areas(nullptr) {}
+// ==================== CapacityCounters Implementation ====================
+CapacityCounters::CapacityCounters() : totalSlots(0), availableSlots(0) {
+    for (int c = 0; c < SLOT_CLASS_COUNT; c++) {
+        totalByClass[c] = 0;
+        availableByClass[c] = 0;
+    }
+}
+
+// ==================== Zone Implementation ====================
+Zone::Zone() 
+    : areas(nullptr), maxAreas(0), currentAreas(0), store(nullptr),
+      totalSlots(0), availableSlots(0), systemCounters(nullptr), registryIndex(-1) {
+    resetClassCounters();
+}
 
 Zone::Zone(const string& zoneId, const string& zoneName, int maxAreas)
-    : zoneId(zoneId), zoneName(zoneName), maxAreas(maxAreas), currentAreas(0) {
+    : zoneId(zoneId), zoneName(zoneName), maxAreas(maxAreas), currentAreas(0),
+      totalSlots(0), availableSlots(0), systemCounters(nullptr), registryIndex(-1) {
+    resetClassCounters();
+    store = new SlotStore(zoneId);
     areas = new ParkingArea*[maxAreas];
     for (int i = 0; i < maxAreas; i++) {
         areas[i] = nullptr;
@@ -17,6 +33,7 @@ Zone::~Zone() {
         delete areas[i];
     }
     delete[] areas;
+    delete store;
 }
 
 string Zone::getZoneId() const {
@@ -35,13 +52,23 @@ int Zone::getCurrentAreas() const {
     return currentAreas;
 }
 
+ParkingArea* Zone::getAreaAt(int index) const {
+    if (index < 0 || index >= currentAreas) {
+        return nullptr;
+    }
+    return areas[index];
+}
+
 bool Zone::addArea(const string& areaId, int maxSlots) {
     if (currentAreas >= maxAreas) {
         cout << "Error: Cannot add more areas. Zone capacity reached!" << endl;
         return false;
     }
     
-    areas[currentAreas] = new ParkingArea(areaId, zoneId, maxSlots);
+    // Each area gets its own 64-aligned block of the zone's slot store
+    int baseIndex = store->reserveBlock(maxSlots, currentAreas);
+    areas[currentAreas] = new ParkingArea(areaId, store, baseIndex, maxSlots);
+    areas[currentAreas]->attachToZone(this);
     currentAreas++;
     return true;
 }
@@ -72,31 +99,232 @@ void Zone::displayAllAreas() const {
 }
 
 int Zone::getTotalSlots() const {
-    int total = 0;
-    for (int i = 0; i < currentAreas; i++) {
-        total += areas[i]->getCurrentSlots();
-    }
-    return total;
+    return totalSlots;
 }
 
 int Zone::getAvailableSlots() const {
+    return availableSlots;
+}
+
+int Zone::getTotalSlots(SlotClass slotClass) const {
+    return totalByClass[(int)slotClass];
+}
+
+int Zone::getAvailableSlots(SlotClass slotClass) const {
+    return availableByClass[(int)slotClass];
+}
+
+int Zone::getAvailableSlotsFor(SlotClass vehicleClass) const {
     int available = 0;
-    for (int i = 0; i < currentAreas; i++) {
-        available += areas[i]->countAvailableSlots();
+    for (int c = (int)vehicleClass; c < SLOT_CLASS_COUNT; c++) {
+        available += availableByClass[c];
     }
     return available;
 }
 
 ParkingSlot* Zone::findAvailableSlotInZone() {
-    for (int i = 0; i < currentAreas; i++) {
-        ParkingSlot* slot = areas[i]->getFirstAvailableSlot();
-        if (slot != nullptr) {
-            return slot;
+    if (availableSlots == 0) {
+        return nullptr;
+    }
+    
+    // One pass over the zone's contiguous free bits, then map back to the area
+    int index = store->findFirstFree(0, store->getReservedSlots());
+    if (index < 0) {
+        return nullptr;
+    }
+    
+    ParkingArea* area = areas[store->getOwnerTag(index)];
+    return area->getSlotAt(index - area->getBaseIndex());
+}
+
+ParkingSlot* Zone::claimAvailableSlotInZone(SlotClass fits) {
+    if (availableSlots <= 0) {
+        return nullptr;
+    }
+    
+    // The store's per-class summary leads straight to a word with a free
+    // slot of the class, and the bit is cleared by CAS; a caller that loses
+    // a slot to another thread just takes the next one. The class counters
+    // skip classes with nothing free without touching the bits.
+    for (int c = (int)fits; c < SLOT_CLASS_COUNT; c++) {
+        if (availableByClass[c] <= 0) {
+            continue;
+        }
+        int index = store->claimFreeOfClass(c);
+        if (index < 0) {
+            continue;
+        }
+        
+        ParkingArea* area = areas[store->getOwnerTag(index)];
+        area->onSlotClaimed((SlotClass)c);
+        return area->getSlotAt(index - area->getBaseIndex());
+    }
+    return nullptr;
+}
+
+ParkingSlot* Zone::claimBestFitSlot(SlotClass fits) {
+    // Fill the tightest area first, keeping emptier areas whole for later.
+    // An area that loses its last slot to another thread is passed over on
+    // the next look, so the retries are bounded by the area count.
+    for (int c = (int)fits; c < SLOT_CLASS_COUNT; c++) {
+        for (int attempt = 0; attempt < currentAreas && availableByClass[c] > 0; attempt++) {
+            ParkingArea* best = nullptr;
+            int bestFree = 0;
+            for (int i = 0; i < currentAreas; i++) {
+                int freeSlots = areas[i]->countAvailableSlots((SlotClass)c);
+                if (freeSlots > 0 && (best == nullptr || freeSlots < bestFree)) {
+                    best = areas[i];
+                    bestFree = freeSlots;
+                }
+            }
+            if (best == nullptr) {
+                break;
+            }
+            
+            ParkingSlot* slot = best->claimFirstAvailableSlot(c);
+            if (slot != nullptr) {
+                return slot;
+            }
+        }
+    }
+    return nullptr;
+}
+
+ParkingSlot* Zone::claimRoundRobinSlot(SlotClass fits) {
+    for (int c = (int)fits; c < SLOT_CLASS_COUNT; c++) {
+        for (int i = 0; i < currentAreas && availableByClass[c] > 0; i++) {
+            if (areas[i]->countAvailableSlots((SlotClass)c) == 0) {
+                continue;
+            }
+            ParkingSlot* slot = areas[i]->claimNextAvailableSlot(c);
+            if (slot != nullptr) {
+                return slot;
+            }
         }
     }
     return nullptr;
 }
 
+int Zone::claimAvailableSlotsInZone(ParkingSlot** slots, int maxCount, SlotClass fits) {
+    if (availableSlots <= 0 || maxCount <= 0) {
+        return 0;
+    }
+    
+    int count = 0;
+    for (int c = (int)fits; c < SLOT_CLASS_COUNT && count < maxCount; c++) {
+        count += claimSlotsOfClassInZone(slots + count, maxCount - count, (SlotClass)c);
+    }
+    return count;
+}
+
+int Zone::claimSlotsOfClassInZone(ParkingSlot** slots, int maxCount, SlotClass slotClass) {
+    int c = (int)slotClass;
+    if (availableByClass[c] <= 0 || maxCount <= 0) {
+        return 0;
+    }
+    
+    int* indices = new int[maxCount];
+    int got = store->claimFreeOfClass(c, indices, maxCount);
+    
+    // Indices come back ascending, so each area's claims form one run and
+    // the counters are adjusted once per area rather than once per slot
+    int runStart = 0;
+    for (int i = 0; i < got; i++) {
+        ParkingArea* area = areas[store->getOwnerTag(indices[i])];
+        slots[i] = area->getSlotAt(indices[i] - area->getBaseIndex());
+        if (i + 1 == got || store->getOwnerTag(indices[i + 1]) != store->getOwnerTag(indices[i])) {
+            area->onSlotsClaimed(slotClass, i + 1 - runStart);
+            runStart = i + 1;
+        }
+    }
+    
+    delete[] indices;
+    return got;
+}
+
+void Zone::attachCounters(CapacityCounters* counters, int registryIndex) {
+    systemCounters = counters;
+    this->registryIndex = registryIndex;
+    if (systemCounters != nullptr) {
+        // Slots added before attaching still count towards the aggregate
+        systemCounters->totalSlots += totalSlots;
+        systemCounters->availableSlots += availableSlots;
+        for (int c = 0; c < SLOT_CLASS_COUNT; c++) {
+            systemCounters->totalByClass[c] += totalByClass[c];
+            systemCounters->availableByClass[c] += availableByClass[c];
+        }
+        systemCounters->freeByZone.append(availableSlots);
+    }
+}
+
+bool Zone::verifyCounters() const {
+    bool consistent = true;
+    int total = 0;
+    int available = 0;
+    int totalOfClass[SLOT_CLASS_COUNT] = {0};
+    int availableOfClass[SLOT_CLASS_COUNT] = {0};
+    
+    for (int i = 0; i < currentAreas; i++) {
+        if (!areas[i]->verifyCounters()) {
+            consistent = false;
+        }
+        total += areas[i]->getCurrentSlots();
+        available += areas[i]->countAvailableSlots();
+        for (int c = 0; c < SLOT_CLASS_COUNT; c++) {
+            totalOfClass[c] += areas[i]->countSlots((SlotClass)c);
+            availableOfClass[c] += areas[i]->countAvailableSlots((SlotClass)c);
+        }
+    }
+    
+    for (int c = 0; c < SLOT_CLASS_COUNT; c++) {
+        if (totalOfClass[c] != totalByClass[c] || availableOfClass[c] != availableByClass[c]) {
+            cout << "Counter mismatch in zone " << zoneId << " for " << slotClassName((SlotClass)c)
+                 << " slots: counters=" << availableByClass[c] << "/" << totalByClass[c]
+                 << ", recount=" << availableOfClass[c] << "/" << totalOfClass[c] << endl;
+            consistent = false;
+        }
+    }
+    
+    if (total != totalSlots || available != availableSlots) {
+        cout << "Counter mismatch in zone " << zoneId << ": counters=" 
+             << availableSlots << "/" << totalSlots << ", recount=" 
+             << available << "/" << total << endl;
+        consistent = false;
+    }
+    return consistent;
+}
+
+void Zone::onSlotAdded(SlotClass slotClass) {
+    totalSlots++;
+    availableSlots++;
+    totalByClass[(int)slotClass]++;
+    availableByClass[(int)slotClass]++;
+    if (systemCounters != nullptr) {
+        systemCounters->totalSlots++;
+        systemCounters->availableSlots++;
+        systemCounters->totalByClass[(int)slotClass]++;
+        systemCounters->availableByClass[(int)slotClass]++;
+        systemCounters->freeByZone.add(registryIndex, 1);
+    }
+}
+
+void Zone::onAvailabilityChanged(int delta, SlotClass slotClass) {
+    availableSlots += delta;
+    availableByClass[(int)slotClass] += delta;
+    if (systemCounters != nullptr) {
+        systemCounters->availableSlots += delta;
+        systemCounters->availableByClass[(int)slotClass] += delta;
+        systemCounters->freeByZone.add(registryIndex, delta);
+    }
+}
+
+void Zone::resetClassCounters() {
+    for (int c = 0; c < SLOT_CLASS_COUNT; c++) {
+        totalByClass[c] = 0;
+        availableByClass[c] = 0;
+    }
+}
+
 void Zone::displayZoneInfo() const {
     cout << "\n=== Zone Information ===" << endl;
     cout << "Zone ID: " << zoneId << endl;
@@ -2,9 +2,24 @@
 #define ZONE_H
 
 #include <string>
+#include <atomic>
 #include "ParkingArea.h"
+#include "SlotStore.h"
+#include "CapacityTree.h"
 using namespace std;
 
+// Slot totals aggregated above the zone level (system-wide).
+// Atomic because allocators in different zones update them concurrently.
+struct CapacityCounters {
+    atomic<int> totalSlots;
+    atomic<int> availableSlots;
+    atomic<int> totalByClass[SLOT_CLASS_COUNT];
+    atomic<int> availableByClass[SLOT_CLASS_COUNT];
+    CapacityTree freeByZone; // Available slots by registry index
+    
+    CapacityCounters();
+};
+
 class Zone {
 private:
     string zoneId;
@@ -12,6 +27,17 @@ private:
     ParkingArea** areas; // Array of pointers to ParkingArea
     int maxAreas;
     int currentAreas;
+    SlotStore* store;    // State of every slot in the zone, areas own blocks of it
+    
+    // Maintained incrementally by the areas on every slot transition.
+    // Updated just after the slot's bit flips, so they are an allocation
+    // hint while claims are in flight and exact once they settle.
+    atomic<int> totalSlots;
+    atomic<int> availableSlots;
+    atomic<int> totalByClass[SLOT_CLASS_COUNT];
+    atomic<int> availableByClass[SLOT_CLASS_COUNT];
+    CapacityCounters* systemCounters; // Owner's aggregate, may be null
+    int registryIndex;                // This zone's entry in systemCounters->freeByZone
     
 public:
     Zone();
@@ -23,6 +49,7 @@ public:
     string getZoneName() const;
     int getMaxAreas() const;
     int getCurrentAreas() const;
+    ParkingArea* getAreaAt(int index) const;
     
     // Area management
     bool addArea(const string& areaId, int maxSlots);
@@ -32,10 +59,33 @@ public:
     // Slot availability
     int getTotalSlots() const;
     int getAvailableSlots() const;
+    int getTotalSlots(SlotClass slotClass) const;
+    int getAvailableSlots(SlotClass slotClass) const;
+    int getAvailableSlotsFor(SlotClass vehicleClass) const; // Free slots of that class or larger
     ParkingSlot* findAvailableSlotInZone();
     
+    // Claims for a vehicle of class fits: the smallest class with a free
+    // slot that fits is tried first, then each larger class in turn. The
+    // default, MOTORCYCLE, accepts any slot.
+    ParkingSlot* claimAvailableSlotInZone(SlotClass fits = SlotClass::MOTORCYCLE); // Lock-free; slot comes back already taken
+    ParkingSlot* claimBestFitSlot(SlotClass fits = SlotClass::MOTORCYCLE);    // Same, from the area with the fewest free slots
+    ParkingSlot* claimRoundRobinSlot(SlotClass fits = SlotClass::MOTORCYCLE); // Same, rotating through the first area with room
+    int claimAvailableSlotsInZone(ParkingSlot** slots, int maxCount,
+                                  SlotClass fits = SlotClass::MOTORCYCLE); // One pass per class; returns count taken
+    int claimSlotsOfClassInZone(ParkingSlot** slots, int maxCount, SlotClass slotClass); // That class only
+    
+    // Counter maintenance
+    void attachCounters(CapacityCounters* counters, int registryIndex);
+    bool verifyCounters() const; // Full recount, for consistency checks
+    
     // Utility
     void displayZoneInfo() const;
+    
+private:
+    friend class ParkingArea;
+    void onSlotAdded(SlotClass slotClass);
+    void onAvailabilityChanged(int delta, SlotClass slotClass);
+    void resetClassCounters();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,352 @@
+#include "ZoneGraph.h"
+#include <iostream>
+using namespace std;
+
+// Dijkstra frontier entry; equal distances keep the round-robin order so a
+// uniformly weighted graph falls back the same way as before
+struct FrontierEntry {
+    long long distance;
+    int offset; // Round-robin offset from the origin
+    int zone;
+};
+
+static bool closer(const FrontierEntry& a, const FrontierEntry& b) {
+    if (a.distance != b.distance) {
+        return a.distance < b.distance;
+    }
+    return a.offset < b.offset;
+}
+
+// ==================== ZoneGraph Implementation ====================
+ZoneGraph::ZoneGraph(ZoneRegistry* registry)
+    : registry(registry), adjacency(nullptr), degree(nullptr), edgeCapacity(nullptr),
+      nodeCapacity(0), edgeCount(0), nodeCount(0), component(nullptr), orders(nullptr) {}
+
+ZoneGraph::~ZoneGraph() {
+    clearOrders();
+    delete[] orders;
+    delete[] component;
+    for (int i = 0; i < nodeCapacity; i++) {
+        delete[] adjacency[i];
+    }
+    delete[] adjacency;
+    delete[] degree;
+    delete[] edgeCapacity;
+}
+
+void ZoneGraph::ensureNode(int zoneIndex) {
+    if (zoneIndex < nodeCapacity) {
+        return;
+    }
+    
+    int newCapacity = (nodeCapacity > 0) ? nodeCapacity : 8;
+    while (newCapacity <= zoneIndex) {
+        newCapacity *= 2;
+    }
+    
+    Edge** newAdjacency = new Edge*[newCapacity];
+    int* newDegree = new int[newCapacity];
+    int* newEdgeCapacity = new int[newCapacity];
+    for (int i = 0; i < newCapacity; i++) {
+        bool old = i < nodeCapacity;
+        newAdjacency[i] = old ? adjacency[i] : nullptr;
+        newDegree[i] = old ? degree[i] : 0;
+        newEdgeCapacity[i] = old ? edgeCapacity[i] : 0;
+    }
+    delete[] adjacency;
+    delete[] degree;
+    delete[] edgeCapacity;
+    adjacency = newAdjacency;
+    degree = newDegree;
+    edgeCapacity = newEdgeCapacity;
+    nodeCapacity = newCapacity;
+}
+
+bool ZoneGraph::addEdge(const string& zoneA, const string& zoneB, int distance) {
+    int a = registry->indexOf(zoneA);
+    int b = registry->indexOf(zoneB);
+    if (a == -1 || b == -1) {
+        cout << "Error: Both zones must exist to be adjacent." << endl;
+        return false;
+    }
+    if (a == b || distance <= 0) {
+        cout << "Error: Adjacency needs two different zones and a positive distance." << endl;
+        return false;
+    }
+    
+    ensureNode(a > b ? a : b);
+    
+    // An existing edge just takes the new distance
+    bool updated = false;
+    for (int i = 0; i < degree[a]; i++) {
+        if (adjacency[a][i].to == b) {
+            adjacency[a][i].distance = distance;
+            updated = true;
+        }
+    }
+    for (int i = 0; updated && i < degree[b]; i++) {
+        if (adjacency[b][i].to == a) {
+            adjacency[b][i].distance = distance;
+        }
+    }
+    
+    if (!updated) {
+        int ends[2] = {a, b};
+        for (int end = 0; end < 2; end++) {
+            int from = ends[end];
+            if (degree[from] == edgeCapacity[from]) {
+                int newCapacity = (edgeCapacity[from] > 0) ? edgeCapacity[from] * 2 : 4;
+                Edge* newEdges = new Edge[newCapacity];
+                for (int i = 0; i < degree[from]; i++) {
+                    newEdges[i] = adjacency[from][i];
+                }
+                delete[] adjacency[from];
+                adjacency[from] = newEdges;
+                edgeCapacity[from] = newCapacity;
+            }
+            adjacency[from][degree[from]].to = ends[1 - end];
+            adjacency[from][degree[from]].distance = distance;
+            degree[from]++;
+        }
+        edgeCount++;
+    }
+    
+    refresh();
+    return true;
+}
+
+void ZoneGraph::clearOrders() {
+    for (int i = 0; i < nodeCount; i++) {
+        FallbackOrder* order = orders[i].load(memory_order_relaxed);
+        if (order != nullptr) {
+            delete[] order->zones;
+            delete[] order->distances;
+            delete[] order->positions;
+            delete order;
+        }
+    }
+}
+
+void ZoneGraph::refresh() {
+    clearOrders();
+    delete[] orders;
+    delete[] component;
+    
+    nodeCount = registry->getZoneCount();
+    ensureNode(nodeCount > 0 ? nodeCount - 1 : 0);
+    orders = new atomic<FallbackOrder*>[nodeCount];
+    component = new int[nodeCount];
+    for (int i = 0; i < nodeCount; i++) {
+        orders[i].store(nullptr, memory_order_relaxed);
+        component[i] = -1;
+    }
+    
+    // Label connected components with an iterative DFS, O(V + E)
+    int* stack = new int[nodeCount + 1];
+    for (int start = 0; start < nodeCount; start++) {
+        if (component[start] != -1 || degree[start] == 0) {
+            continue;
+        }
+        int top = 0;
+        stack[top++] = start;
+        component[start] = start;
+        while (top > 0) {
+            int zone = stack[--top];
+            for (int i = 0; i < degree[zone]; i++) {
+                int next = adjacency[zone][i].to;
+                if (component[next] == -1) {
+                    component[next] = start;
+                    stack[top++] = next;
+                }
+            }
+        }
+    }
+    delete[] stack;
+}
+
+ZoneGraph::FallbackOrder* ZoneGraph::buildOrder(int origin) const {
+    // Dijkstra with a lazy-deletion binary heap over the origin's component
+    long long* best = new long long[nodeCount];
+    bool* settled = new bool[nodeCount];
+    for (int i = 0; i < nodeCount; i++) {
+        best[i] = -1;
+        settled[i] = false;
+    }
+    
+    FrontierEntry* heap = new FrontierEntry[2 * edgeCount + 1];
+    int heapSize = 0;
+    
+    FallbackOrder* order = new FallbackOrder;
+    int reachable = 0;
+    for (int i = 0; i < nodeCount; i++) {
+        if (i != origin && component[i] == component[origin]) {
+            reachable++;
+        }
+    }
+    order->zones = new int[reachable];
+    order->distances = new long long[reachable];
+    order->positions = new int[nodeCount];
+    for (int i = 0; i < nodeCount; i++) {
+        order->positions[i] = -1;
+    }
+    order->length = 0;
+    
+    best[origin] = 0;
+    heap[heapSize++] = {0, 0, origin};
+    
+    while (heapSize > 0) {
+        FrontierEntry top = heap[0];
+        heap[0] = heap[--heapSize];
+        for (int index = 0; ; ) {
+            int child = 2 * index + 1;
+            if (child >= heapSize) {
+                break;
+            }
+            if (child + 1 < heapSize && closer(heap[child + 1], heap[child])) {
+                child++;
+            }
+            if (!closer(heap[child], heap[index])) {
+                break;
+            }
+            FrontierEntry swapped = heap[index];
+            heap[index] = heap[child];
+            heap[child] = swapped;
+            index = child;
+        }
+        
+        if (settled[top.zone]) {
+            continue; // Stale entry
+        }
+        settled[top.zone] = true;
+        if (top.zone != origin) {
+            order->zones[order->length] = top.zone;
+            order->distances[order->length] = top.distance;
+            order->positions[top.zone] = order->length;
+            order->length++;
+        }
+        
+        for (int i = 0; i < degree[top.zone]; i++) {
+            const Edge& edge = adjacency[top.zone][i];
+            if (edge.to >= nodeCount || settled[edge.to]) {
+                continue;
+            }
+            long long distance = top.distance + edge.distance;
+            if (best[edge.to] != -1 && best[edge.to] <= distance) {
+                continue;
+            }
+            best[edge.to] = distance;
+            
+            int index = heapSize++;
+            FrontierEntry entry = {distance, (edge.to - origin + nodeCount) % nodeCount, edge.to};
+            while (index > 0) {
+                int parent = (index - 1) / 2;
+                if (!closer(entry, heap[parent])) {
+                    break;
+                }
+                heap[index] = heap[parent];
+                index = parent;
+            }
+            heap[index] = entry;
+        }
+    }
+    
+    delete[] heap;
+    delete[] settled;
+    delete[] best;
+    return order;
+}
+
+const ZoneGraph::FallbackOrder* ZoneGraph::getFallbackOrder(int zoneIndex) {
+    if (zoneIndex < 0 || zoneIndex >= nodeCount || component[zoneIndex] == -1) {
+        return nullptr;
+    }
+    
+    FallbackOrder* order = orders[zoneIndex].load(memory_order_acquire);
+    if (order != nullptr) {
+        return order;
+    }
+    
+    lock_guard<mutex> guard(cacheLock);
+    order = orders[zoneIndex].load(memory_order_relaxed);
+    if (order == nullptr) {
+        order = buildOrder(zoneIndex);
+        orders[zoneIndex].store(order, memory_order_release);
+    }
+    return order;
+}
+
+bool ZoneGraph::sameComponent(int zoneA, int zoneB) const {
+    if (zoneA < 0 || zoneA >= nodeCount || zoneB < 0 || zoneB >= nodeCount) {
+        return false;
+    }
+    return component[zoneA] != -1 && component[zoneA] == component[zoneB];
+}
+
+int ZoneGraph::getEdgeCount() const {
+    return edgeCount;
+}
+
+int ZoneGraph::getFallbackRank(int origin, int zone, int zoneCount) {
+    // The origin's component in order, then everything else round-robin
+    const FallbackOrder* order = getFallbackOrder(origin);
+    int offset = (zone - origin + zoneCount) % zoneCount - 1;
+    if (order == nullptr) {
+        return offset;
+    }
+    if (zone < nodeCount && order->positions[zone] != -1) {
+        return order->positions[zone];
+    }
+    return order->length + offset;
+}
+
+void ZoneGraph::displayFallbackOrder(int zoneIndex) {
+    const FallbackOrder* order = getFallbackOrder(zoneIndex);
+    if (order == nullptr || order->length == 0) {
+        cout << "none (round-robin)";
+        return;
+    }
+    
+    for (int i = 0; i < order->length; i++) {
+        cout << (i > 0 ? ", " : "") << registry->getZoneAt(order->zones[i])->getZoneId()
+             << " (" << order->distances[i] << ")";
+    }
+}
+
+// ==================== FallbackCursor Implementation ====================
+FallbackCursor::FallbackCursor(ZoneGraph* graph, int origin, int zoneCount,
+                               const ZoneRegistry* capacityIndex)
+    : graph(graph), capacityIndex(capacityIndex), origin(origin), zoneCount(zoneCount),
+      position(0), offset(1), distance(-1) {
+    order = graph->getFallbackOrder(origin);
+}
+
+int FallbackCursor::next() {
+    if (order != nullptr && position < order->length) {
+        distance = order->distances[position];
+        return order->zones[position++];
+    }
+    
+    // Zones outside the origin's component were not in the order
+    distance = -1;
+    while (offset < zoneCount) {
+        int zone = (origin + offset) % zoneCount;
+        if (capacityIndex != nullptr) {
+            zone = capacityIndex->findZoneWithCapacity(zone);
+            int skipped = (zone == -1) ? 0 : (zone - origin + zoneCount) % zoneCount;
+            if (skipped < offset) {
+                offset = zoneCount; // Wrapped back to the origin
+                return -1;
+            }
+            offset = skipped;
+        }
+        offset++;
+        if (!graph->sameComponent(origin, zone)) {
+            return zone;
+        }
+    }
+    return -1;
+}
+
+long long FallbackCursor::getDistance() const {
+    return distance;
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#ifndef ZONEGRAPH_H
+#define ZONEGRAPH_H
+
+#include "ZoneRegistry.h"
+#include <string>
+#include <mutex>
+#include <atomic>
+using namespace std;
+
+// Weighted undirected graph of zone adjacency, by registry index.
+// Each zone's fallback order (the other zones of its connected component,
+// nearest first by shortest-path distance) is computed with Dijkstra the
+// first time it is needed and cached until refresh(). Zones the graph does
+// not connect are still reachable as overflow, in round-robin order.
+class ZoneGraph {
+public:
+    struct FallbackOrder {
+        int* zones;           // Registry indices, nearest first
+        long long* distances; // Shortest-path distance of each entry
+        int* positions;       // Per registry index, its place in zones or -1
+        int length;
+    };
+    
+private:
+    struct Edge {
+        int to;
+        int distance;
+    };
+    
+    ZoneRegistry* registry; // Not owned
+    Edge** adjacency;       // Per zone index, grows by doubling
+    int* degree;
+    int* edgeCapacity;
+    int nodeCapacity;
+    int edgeCount;          // Undirected edges
+    
+    // Valid for the nodeCount zones registered at the last refresh()
+    int nodeCount;
+    int* component;                   // Connected component, -1 if isolated
+    atomic<FallbackOrder*>* orders;   // Built on first use
+    mutable mutex cacheLock;          // Serializes building an order
+    
+public:
+    ZoneGraph(ZoneRegistry* registry);
+    ~ZoneGraph();
+    
+    // Topology; the caller keeps readers out while these run
+    bool addEdge(const string& zoneA, const string& zoneB, int distance = 1);
+    void refresh(); // Drop cached orders after zones or edges change
+    
+    // Safe with concurrent readers between refreshes. Returns nullptr for
+    // zones without edges or added since the last refresh.
+    const FallbackOrder* getFallbackOrder(int zoneIndex);
+    bool sameComponent(int zoneA, int zoneB) const;
+    int getEdgeCount() const;
+    
+    // Where zone comes in the walk a FallbackCursor from origin makes
+    // (0 is the first zone offered), in O(1) once the order is cached
+    int getFallbackRank(int origin, int zone, int zoneCount);
+    
+    // Utility
+    void displayFallbackOrder(int zoneIndex);
+    
+private:
+    void ensureNode(int zoneIndex);
+    FallbackOrder* buildOrder(int origin) const;
+    void clearOrders();
+    
+    // Non-copyable: owns its adjacency lists and cached orders
+    ZoneGraph(const ZoneGraph&);
+    ZoneGraph& operator=(const ZoneGraph&);
+};
+
+// Walks every zone other than the origin once, in allocation fallback
+// order: the origin's component nearest first, then the rest round-robin
+// by registry index (the order used before zones had adjacency).
+// Given a registry, the round-robin part jumps straight to zones with free
+// capacity through its capacity tree instead of stepping over full ones.
+class FallbackCursor {
+private:
+    ZoneGraph* graph;
+    const ZoneRegistry* capacityIndex; // Null to visit full zones too
+    const ZoneGraph::FallbackOrder* order;
+    int origin;
+    int zoneCount;
+    int position; // Into order
+    int offset;   // Round-robin offset from origin
+    long long distance; // Of the zone next() returned last
+    
+public:
+    FallbackCursor(ZoneGraph* graph, int origin, int zoneCount,
+                   const ZoneRegistry* capacityIndex = nullptr);
+    int next(); // Registry index, or -1 when every zone has been offered
+    long long getDistance() const; // Shortest-path distance, -1 outside the origin's component
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "ZoneRegistry.h"
+#include <iostream>
+using namespace std;
+
+ZoneRegistry::ZoneRegistry(int initialCapacity)
+    : zoneCount(0), capacity(initialCapacity > 0 ? initialCapacity : 1),
+      zoneIndex(initialCapacity * 2) {
+    zones = new Zone*[capacity];
+    for (int i = 0; i < capacity; i++) {
+        zones[i] = nullptr;
+    }
+}
+
+ZoneRegistry::~ZoneRegistry() {
+    for (int i = 0; i < zoneCount; i++) {
+        delete zones[i];
+    }
+    delete[] zones;
+}
+
+bool ZoneRegistry::addZone(Zone* zone) {
+    if (zone == nullptr) {
+        return false;
+    }
+    
+    if (!zoneIndex.insert(zone->getZoneId(), zoneCount)) {
+        cout << "Error: Zone " << zone->getZoneId() << " already exists." << endl;
+        return false;
+    }
+    
+    if (zoneCount >= capacity) {
+        int newCapacity = capacity * 2;
+        Zone** newZones = new Zone*[newCapacity];
+        for (int i = 0; i < newCapacity; i++) {
+            newZones[i] = (i < zoneCount) ? zones[i] : nullptr;
+        }
+        delete[] zones;
+        zones = newZones;
+        capacity = newCapacity;
+    }
+    
+    zones[zoneCount] = zone;
+    zone->attachCounters(&counters, zoneCount);
+    zoneCount++;
+    return true;
+}
+
+Zone* ZoneRegistry::findZone(const string& zoneId) const {
+    const int* index = zoneIndex.find(zoneId);
+    return (index != nullptr) ? zones[*index] : nullptr;
+}
+
+int ZoneRegistry::indexOf(const string& zoneId) const {
+    const int* index = zoneIndex.find(zoneId);
+    return (index != nullptr) ? *index : -1;
+}
+
+Zone* ZoneRegistry::getZoneAt(int index) const {
+    if (index < 0 || index >= zoneCount) {
+        return nullptr;
+    }
+    return zones[index];
+}
+
+int ZoneRegistry::getZoneCount() const {
+    return zoneCount;
+}
+
+int ZoneRegistry::getTotalSlots() const {
+    return counters.totalSlots;
+}
+
+int ZoneRegistry::getAvailableSlots() const {
+    return counters.availableSlots;
+}
+
+int ZoneRegistry::getTotalSlots(SlotClass slotClass) const {
+    return counters.totalByClass[(int)slotClass];
+}
+
+int ZoneRegistry::getAvailableSlots(SlotClass slotClass) const {
+    return counters.availableByClass[(int)slotClass];
+}
+
+int ZoneRegistry::getAvailableSlotsInRange(int first, int last) const {
+    return counters.freeByZone.rangeSum(first, last);
+}
+
+int ZoneRegistry::findZoneWithCapacity(int fromIndex) const {
+    return counters.freeByZone.findFirstWithCapacity(fromIndex);
+}
\ No newline at end of file
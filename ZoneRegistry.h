@@ -0,0 +1,46 @@
+#ifndef ZONEREGISTRY_H
+#define ZONEREGISTRY_H
+
+#include "Zone.h"
+#include "HashIndex.h"
+#include <string>
+using namespace std;
+
+// Growable registry of zones with a hash index by zone ID.
+// Owned by ParkingSystem and shared with AllocationEngine, so both see the
+// same zones and zone lookup stays O(1) regardless of zone count.
+class ZoneRegistry {
+private:
+    Zone** zones;            // Registration order, grows by doubling
+    int zoneCount;
+    int capacity;
+    HashIndex<int> zoneIndex; // zoneId -> position in zones
+    CapacityCounters counters; // System-wide slot totals, fed by the zones
+    
+public:
+    ZoneRegistry(int initialCapacity = 10);
+    ~ZoneRegistry();
+    
+    // Zone management (the registry takes ownership of added zones)
+    bool addZone(Zone* zone);
+    Zone* findZone(const string& zoneId) const;
+    int indexOf(const string& zoneId) const; // -1 if not registered
+    Zone* getZoneAt(int index) const;
+    int getZoneCount() const;
+    
+    // System-wide capacity
+    int getTotalSlots() const;
+    int getAvailableSlots() const;
+    int getTotalSlots(SlotClass slotClass) const;
+    int getAvailableSlots(SlotClass slotClass) const;
+    
+    // Capacity by zone index, O(log n) through the Fenwick tree
+    int getAvailableSlotsInRange(int first, int last) const; // Zones [first, last)
+    int findZoneWithCapacity(int fromIndex) const; // At or after fromIndex, wrapping; -1 if all full
+    
+private:
+    ZoneRegistry(const ZoneRegistry&);
+    ZoneRegistry& operator=(const ZoneRegistry&);
+};
+
+#endif
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <iostream>
 #include "ParkingSystem.h"
 #include "TestSuite.h"
+#include "BenchmarkSuite.h"
 using namespace std;
 
 // Helper functions
@@ -43,9 +44,15 @@ void displayMainMenu() {
     cout << "11. Rollback Last Operation" << endl;
     cout << "12. Rollback Last K Operations" << endl;
     cout << "13. System Analytics" << endl;
-    cout << "14. Run Test Suite (10 Tests)" << endl;
+    cout << "14. Run Test Suite (45 Tests)" << endl;
     cout << "15. Run Auto Demo Scenario" << endl;
-    cout << "16. Exit" << endl;
+    cout << "16. Start/Stop Allocation Workers" << endl;
+    cout << "17. Run Benchmarks" << endl;
+    cout << "18. Toggle Priority Scheduling" << endl;
+    cout << "19. Select Allocation Policy" << endl;
+    cout << "20. Reservations" << endl;
+    cout << "21. Allocation Expiry" << endl;
+    cout << "22. Exit" << endl;
     cout << "=======================================" << endl;
 }
 
@@ -109,6 +116,7 @@ void runRollbackMenu(ParkingSystem& system) {
 int main() {
     ParkingSystem system;
     TestSuite testSuite;
+    BenchmarkSuite benchmarkSuite;
     int choice;
     
     cout << "Initializing Smart Parking System..." << endl;
@@ -118,7 +126,7 @@ int main() {
     
     do {
         displayMainMenu();
-        choice = getChoice(1, 16);
+        choice = getChoice(1, 22);
         
         switch(choice) {
             case 1:
@@ -147,7 +155,13 @@ int main() {
                 cout << "Requested Zone (Z1/Z2/Z3): ";
                 string zone;
                 getline(cin, zone);
-                string reqId = system.createParkingRequest(vehicleId, zone);
+                PriorityClass priority = PriorityClass::STANDARD;
+                if (system.getSchedulingPolicy() == SchedulingPolicy::PRIORITY) {
+                    cout << "Priority (1=Standard, 2=Permit, 3=Accessible): ";
+                    int level = getChoice(1, 3);
+                    priority = (PriorityClass)(level - 1);
+                }
+                string reqId = system.createParkingRequest(vehicleId, zone, priority);
                 if (!reqId.empty()) {
                     cout << "Request created with ID: " << reqId << endl;
                 }
@@ -417,16 +431,113 @@ int main() {
             }
                 
             case 16:
+                if (system.areAllocationWorkersRunning()) {
+                    system.stopAllocationWorkers();
+                } else {
+                    cout << "Number of allocation workers: ";
+                    int workers;
+                    cin >> workers;
+                    cin.ignore();
+                    system.startAllocationWorkers(workers);
+                }
+                break;
+                
+            case 17:
+                benchmarkSuite.runAllBenchmarks();
+                break;
+                
+            case 18:
+                if (system.getSchedulingPolicy() == SchedulingPolicy::PRIORITY) {
+                    system.setSchedulingPolicy(SchedulingPolicy::ZONE_FIFO);
+                } else {
+                    system.setSchedulingPolicy(SchedulingPolicy::PRIORITY);
+                }
+                break;
+                
+            case 19: {
+                cout << "Current policy: " << allocationPolicyName(system.getAllocationPolicy()) << endl;
+                cout << "1. First-fit" << endl;
+                cout << "2. Best-fit by area" << endl;
+                cout << "3. Least-loaded zone" << endl;
+                cout << "4. Round-robin within area" << endl;
+                int policy = getChoice(1, 4);
+                system.setAllocationPolicy((AllocationPolicy)(policy - 1));
+                break;
+            }
+                
+            case 20: {
+                clearScreen();
+                cout << "=== RESERVATIONS ===" << endl;
+                cout << "1. Reserve a Slot" << endl;
+                cout << "2. Check a Window" << endl;
+                cout << "3. View Upcoming Reservations" << endl;
+                cout << "4. Open Due Reservations" << endl;
+                int action = getChoice(1, 4);
+                if (action == 3) {
+                    system.displayReservations();
+                    break;
+                }
+                if (action == 4) {
+                    cout << system.activateDueReservations(time(0)) << " reservation(s) allocated." << endl;
+                    break;
+                }
+                
+                string vehicleId;
+                if (action == 1) {
+                    cout << "Vehicle ID: ";
+                    getline(cin, vehicleId);
+                }
+                cout << "Zone (Z1/Z2/Z3): ";
+                string zone;
+                getline(cin, zone);
+                cout << "Starts in how many minutes?";
+                int startMinutes = getChoice(0, 10080);
+                cout << "Duration in minutes?";
+                int durationMinutes = getChoice(1, 1440);
+                time_t start = time(0) + startMinutes * 60;
+                time_t end = start + durationMinutes * 60;
+                
+                if (action == 1) {
+                    string reqId = system.reserveSlot(vehicleId, zone, start, end);
+                    if (!reqId.empty()) {
+                        cout << "Reservation created with ID: " << reqId << endl;
+                    }
+                } else {
+                    cout << "Vehicle Class (1=Motorcycle, 2=Compact, 3=Standard, 4=Large): ";
+                    SlotClass fits = (SlotClass)(getChoice(1, 4) - 1);
+                    cout << (system.isWindowFree(zone, fits, start, end)
+                             ? "A slot is free for that window." : "No slot is free for that window.") << endl;
+                }
+                break;
+            }
+                
+            case 21: {
+                int hold = system.getAllocationHold();
+                cout << "Allocations awaiting arrival: " << system.getExpiryTimerCount() << endl;
+                cout << "Hold time: " << (hold > 0 ? to_string((hold + 59) / 60) + " min" : "off") << endl;
+                cout << "1. Set Hold Time" << endl;
+                cout << "2. Expire Unclaimed Allocations Now" << endl;
+                int action = getChoice(1, 2);
+                if (action == 1) {
+                    cout << "Minutes before an unclaimed allocation is cancelled (0 = never)?";
+                    system.setAllocationHold(getChoice(0, 1440) * 60);
+                } else {
+                    cout << system.expireUnclaimedAllocations(time(0)) << " allocation(s) expired." << endl;
+                }
+                break;
+            }
+                
+            case 22:
                 cout << "Exiting Smart Parking System. Goodbye!" << endl;
                 break;
         }
         
-        if (choice != 16 && choice != 13) {
+        if (choice != 22 && choice != 13) {
             cout << "\nPress Enter to continue...";
             cin.get();
         }
         
-    } while(choice != 16);
+    } while(choice != 22);
     
     return 0;
 }
\ No newline at end of file